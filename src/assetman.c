@@ -1,26 +1,33 @@
 #include <stdlib.h>
+#include <string.h>
 
 #include "include/assetman.h"
 
-#define DTS_USE_ARRAY
-#define DTS_USE_DYNARRAY
-#define DTS_USE_TREE
+#define ASSETMAN_TABLE_INITIAL_SLOT_COUNT 64
+#define ASSETMAN_TABLE_INITIAL_ENTRY_CAPACITY 32
 
-#include "include/dtstructs.h"
+#define assetman_handle_is_dynamic(HANDLE) (((HANDLE) & 1) != 0)
+#define assetman_handle_entry_index(HANDLE) (((HANDLE) >> 1) - 1)
+#define assetman_handle_from_entry_index(INDEX, IS_DYNAMIC) ((asset_handle_t)((((INDEX) + 1) << 1) | (IS_DYNAMIC)))
 
-#define ASSETMAN_TABLE_SIZE 200
-
-typedef struct assetman_table_NODE_STRUCT
+typedef struct
 {
     char* key;
+    size_t hash;
     asset_info_t value;
-    struct assetman_table_NODE_STRUCT* next;
     bool is_safe_key;
-} assetman_node_t;
+    bool has_value;
+} assetman_entry_t;
 
+/* Open addressing with linear probing, ids are never removed so the slots need no tombstones */
 typedef struct
 {
-    assetman_node_t* buckets [ASSETMAN_TABLE_SIZE];
+    /* Index of the entry plus one, zero for an empty slot */
+    uint32_t* slots;
+    size_t slot_count;
+    assetman_entry_t* entries;
+    size_t entry_count;
+    size_t entry_capacity;
 } assetman_table_t;
 
 typedef struct
@@ -34,9 +41,11 @@ typedef struct
 static assetman_t assetman = {0};
 
 static assetman_table_t assetman_table_init();
-static void assetman_table_set(assetman_table_t* table, bool is_safe_key, const char* key, asset_info_t value);
-static void* assetman_table_get(assetman_table_t* table, const char* key);
+static size_t assetman_table_intern(assetman_table_t* table, bool is_safe_key, const char* key);
+static bool assetman_table_find(const assetman_table_t* table, const char* key, size_t* out_entry_index);
+static void assetman_table_grow(assetman_table_t* table);
 static void assetman_table_clear(assetman_table_t* table, free_asset_function asset_cleanup_function);
+static void assetman_table_free(assetman_table_t* table);
 static size_t assetman_table_hash(const void* key);
 
 bool assetman_init(free_asset_function custom_free_asset_function)
@@ -52,22 +61,46 @@ bool assetman_init(free_asset_function custom_free_asset_function)
     return true;
 }
 
-void assetman_set_asset(bool is_id_safe, const char* id, asset_type_t asset_type, void* asset_data)
+asset_handle_t assetman_set_asset(bool is_id_safe, const char* id, asset_type_t asset_type, void* asset_data)
 {
-    assetman_table_t* target_table;
+    asset_handle_t handle = assetman_get_handle(is_id_safe, id);
+    assetman_table_t* target_table = assetman_handle_is_dynamic(handle) ? &assetman.dynamic_assets : &assetman.static_assets;
+    assetman_entry_t* entry = &target_table->entries[assetman_handle_entry_index(handle)];
 
-    target_table = *id == '$' ? &assetman.static_assets : &assetman.dynamic_assets;
+    entry->value = (asset_info_t){ asset_type, asset_data };
+    entry->has_value = true;
 
-    assetman_table_set(target_table, is_id_safe, id, (asset_info_t){ asset_type, asset_data });
+    return handle;
 }
 
 void* assetman_get_asset(const char* id)
 {
     assetman_table_t* target_table;
+    size_t entry_index;
 
     target_table = *id == '$' ? &assetman.static_assets : &assetman.dynamic_assets;
 
-    return assetman_table_get(target_table, id);
+    if(!assetman_table_find(target_table, id, &entry_index) || !target_table->entries[entry_index].has_value) return NULL;
+
+    return target_table->entries[entry_index].value.asset_data;
+}
+
+asset_handle_t assetman_get_handle(bool is_id_safe, const char* id)
+{
+    bool is_dynamic = *id != '$';
+    assetman_table_t* target_table = is_dynamic ? &assetman.dynamic_assets : &assetman.static_assets;
+
+    return assetman_handle_from_entry_index(assetman_table_intern(target_table, is_id_safe, id), is_dynamic);
+}
+
+void* assetman_get_asset_by_handle(asset_handle_t handle)
+{
+    if(handle == ASSETMAN_INVALID_HANDLE) return NULL;
+
+    assetman_table_t* target_table = assetman_handle_is_dynamic(handle) ? &assetman.dynamic_assets : &assetman.static_assets;
+    assetman_entry_t* entry = &target_table->entries[assetman_handle_entry_index(handle)];
+
+    return entry->has_value ? entry->value.asset_data : NULL;
 }
 
 bool assetman_free_static_assets()
@@ -98,6 +131,9 @@ bool assetman_finish(bool free_left_over_assets)
         assetman_free_dynamic_assets();
     }
 
+    assetman_table_free(&assetman.static_assets);
+    assetman_table_free(&assetman.dynamic_assets);
+
     assetman.was_initialized = false;
     
     return true;
@@ -105,81 +141,127 @@ bool assetman_finish(bool free_left_over_assets)
 
 static assetman_table_t assetman_table_init()
 {
-    return (assetman_table_t){0};
+    assetman_table_t table = {0};
+
+    table.slot_count = ASSETMAN_TABLE_INITIAL_SLOT_COUNT;
+    table.slots = calloc(table.slot_count, sizeof(uint32_t));
+    table.entry_capacity = ASSETMAN_TABLE_INITIAL_ENTRY_CAPACITY;
+    table.entries = malloc(table.entry_capacity * sizeof(assetman_entry_t));
+
+    return table;
 }
 
-static void assetman_table_set(assetman_table_t* table, bool is_safe_key, const char* key, asset_info_t value)
+static size_t assetman_table_intern(assetman_table_t* table, bool is_safe_key, const char* key)
 {
-    size_t hash = assetman_table_hash(key) % ASSETMAN_TABLE_SIZE;
+    size_t entry_index;
 
-    assetman_node_t** dest = &table->buckets[hash];
+    if(assetman_table_find(table, key, &entry_index)) return entry_index;
 
-    while(*dest != NULL)
-    {
-        if(strcmp(key, (*dest)->key) == 0)
-        {
-            (*dest)->value = value;
-            return;
-        }
+    /* Keeps the load factor under a half so probes stay short */
+    if((table->entry_count + 1) * 2 > table->slot_count)
+        assetman_table_grow(table);
 
-        dest = &(*dest)->next;
+    if(table->entry_count == table->entry_capacity)
+    {
+        table->entry_capacity *= 2;
+        table->entries = realloc(table->entries, table->entry_capacity * sizeof(assetman_entry_t));
     }
 
-    *dest = malloc(sizeof(assetman_node_t));
-    (*dest)->is_safe_key = is_safe_key;
-    (*dest)->value = value;
-    (*dest)->next = NULL;
+    entry_index = table->entry_count++;
+
+    assetman_entry_t* entry = &table->entries[entry_index];
+
+    entry->hash = assetman_table_hash(key);
+    entry->is_safe_key = is_safe_key;
+    entry->has_value = false;
+    entry->value = (asset_info_t){ UNHANDLED_ASSET, NULL };
 
     if(is_safe_key)
+        entry->key = (char*)key;
+    else
+    {
+        size_t key_length = strlen(key);
+
+        entry->key = malloc(key_length + 1);
+        memcpy(entry->key, key, key_length + 1);
+    }
+
+    size_t slot = entry->hash & (table->slot_count - 1);
+
+    while(table->slots[slot] != 0)
+        slot = (slot + 1) & (table->slot_count - 1);
+
+    table->slots[slot] = (uint32_t)(entry_index + 1);
+
+    return entry_index;
+}
+
+static bool assetman_table_find(const assetman_table_t* table, const char* key, size_t* out_entry_index)
+{
+    size_t hash = assetman_table_hash(key);
+    size_t slot = hash & (table->slot_count - 1);
+
+    while(table->slots[slot] != 0)
     {
-        (*dest)->key = (char*)key;
-        return;
+        const assetman_entry_t* entry = &table->entries[table->slots[slot] - 1];
+
+        if(entry->hash == hash && strcmp(key, entry->key) == 0)
+        {
+            *out_entry_index = table->slots[slot] - 1;
+            return true;
+        }
+
+        slot = (slot + 1) & (table->slot_count - 1);
     }
 
-    (*dest)->key = malloc(strlen(key) + 1);
-    memcpy((*dest)->key, key, strlen(key));
-    (*dest)->key[strlen(key)] = '\0';
+    return false;
 }
 
-static void* assetman_table_get(assetman_table_t* table, const char* key)
+/* Entries keep their index, so handles survive, only the slots are rebuilt from the stored hashes */
+static void assetman_table_grow(assetman_table_t* table)
 {
-    size_t hash = assetman_table_hash(key) % ASSETMAN_TABLE_SIZE;
+    free(table->slots);
 
-    assetman_node_t* curr_node = table->buckets[hash];
+    table->slot_count *= 2;
+    table->slots = calloc(table->slot_count, sizeof(uint32_t));
 
-    while(curr_node != NULL)
+    for (size_t i = 0; i < table->entry_count; i++)
     {
-        if(strcmp(key, curr_node->key) == 0)
-            return curr_node->value.asset_data;
+        size_t slot = table->entries[i].hash & (table->slot_count - 1);
 
-        curr_node = curr_node->next;
-    }
+        while(table->slots[slot] != 0)
+            slot = (slot + 1) & (table->slot_count - 1);
 
-    return NULL;
+        table->slots[slot] = (uint32_t)(i + 1);
+    }
 }
 
 static void assetman_table_clear(assetman_table_t* table, free_asset_function asset_cleanup_function)
 {
-    for (size_t i = 0; i < ASSETMAN_TABLE_SIZE; i++)
+    for (size_t i = 0; i < table->entry_count; i++)
     {
-        assetman_node_t* curr_node = table->buckets[i];
-        
-        while(curr_node != NULL)
-        {
-            assetman_node_t* next = curr_node->next;
+        assetman_entry_t* entry = &table->entries[i];
 
-            if(!curr_node->is_safe_key)
-                free(curr_node->key);
+        if(entry->has_value && entry->value.asset_type != UNHANDLED_ASSET)
+            asset_cleanup_function(&entry->value);
 
-            if(curr_node->value.asset_type != UNHANDLED_ASSET)
-                asset_cleanup_function(&curr_node->value);
+        entry->has_value = false;
+        entry->value = (asset_info_t){ UNHANDLED_ASSET, NULL };
+    }
+}
 
-            free(curr_node);
-            curr_node = next;
-        }
+static void assetman_table_free(assetman_table_t* table)
+{
+    for (size_t i = 0; i < table->entry_count; i++)
+    {
+        if(!table->entries[i].is_safe_key)
+            free(table->entries[i].key);
     }
 
-    *table = assetman_table_init();
+    free(table->slots);
+    free(table->entries);
+
+    *table = (assetman_table_t){0};
 }
 
 static size_t assetman_table_hash(const void* key)
@@ -192,4 +274,4 @@ static size_t assetman_table_hash(const void* key)
         hash = ((hash << 5) + hash) + c;
 
     return hash;
-}
\ No newline at end of file
+}
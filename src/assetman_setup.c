@@ -6,6 +6,10 @@
 #include "include/assetman_setup.h"
 #include "include/rendering.h"
 
+piece_atlas_t piece_atlas;
+
+static SDL_Texture* create_piece_atlas(SDL_Renderer* renderer, SDL_Surface** piece_surfaces, const cell_value_t* pieces, size_t piece_count);
+
 void setup_initial_assets(SDL_Renderer* renderer)
 {
     TTF_Font* font_150pt = TTF_OpenFont(PATH_FONTS "main_text.ttf", 150);
@@ -15,10 +19,14 @@ void setup_initial_assets(SDL_Renderer* renderer)
 
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "2");
 
-    SDL_Texture* white_peon_texture = sui_load_texture(PATH_IMAGES "white_peon.png", renderer, NULL);
-    SDL_Texture* white_queen_texture = sui_load_texture(PATH_IMAGES "white_queen.png", renderer, NULL);
-    SDL_Texture* black_peon_texture = sui_load_texture(PATH_IMAGES "black_peon.png", renderer, NULL);
-    SDL_Texture* black_queen_texture = sui_load_texture(PATH_IMAGES "black_queen.png", renderer, NULL);
+    const cell_value_t atlas_pieces [4] = { PIECE_WHITE_PEON, PIECE_WHITE_QUEEN, PIECE_BLACK_PEON, PIECE_BLACK_QUEEN };
+    SDL_Surface* piece_surfaces [4] = { NULL, NULL, NULL, NULL };
+
+    SDL_Texture* white_peon_texture = sui_load_texture(PATH_IMAGES "white_peon.png", renderer, &piece_surfaces[0]);
+    SDL_Texture* white_queen_texture = sui_load_texture(PATH_IMAGES "white_queen.png", renderer, &piece_surfaces[1]);
+    SDL_Texture* black_peon_texture = sui_load_texture(PATH_IMAGES "black_peon.png", renderer, &piece_surfaces[2]);
+    SDL_Texture* black_queen_texture = sui_load_texture(PATH_IMAGES "black_queen.png", renderer, &piece_surfaces[3]);
+    SDL_Texture* piece_atlas_texture = create_piece_atlas(renderer, piece_surfaces, atlas_pieces, 4);
     SDL_Texture* correct_move_texture = sui_load_texture(PATH_IMAGES "correct_move.png", renderer, NULL);
     SDL_Texture* incorrect_move_texture = sui_load_texture(PATH_IMAGES "incorrect_move.png", renderer, NULL);
     SDL_Texture* remove_piece_texture = sui_load_texture(PATH_IMAGES "remove_piece.png", renderer, NULL);
@@ -33,6 +41,7 @@ void setup_initial_assets(SDL_Renderer* renderer)
     assetman_set_asset(true, "$WhiteQueen", TEXTURE_ASSET_TYPE, white_queen_texture);
     assetman_set_asset(true, "$BlackPeon", TEXTURE_ASSET_TYPE, black_peon_texture);
     assetman_set_asset(true, "$BlackQueen", TEXTURE_ASSET_TYPE, black_queen_texture);
+    piece_atlas.texture_handle = assetman_set_asset(true, "$PieceAtlas", TEXTURE_ASSET_TYPE, piece_atlas_texture);
     assetman_set_asset(true, "$ChallengeCorrect", TEXTURE_ASSET_TYPE, correct_move_texture);
     assetman_set_asset(true, "$ChallengeWrong", TEXTURE_ASSET_TYPE, incorrect_move_texture);
     assetman_set_asset(true, "$EditorRemovePiece", TEXTURE_ASSET_TYPE, remove_piece_texture);
@@ -53,4 +62,56 @@ void checkers_free_asset_function(asset_info_t* asset)
             asset->asset_data = NULL;
             break;
     }
-}
\ No newline at end of file
+}
+
+/* Lays the pieces out in a row, transparent padding around each one keeps linear filtering from bleeding into its neighbours */
+static SDL_Texture* create_piece_atlas(SDL_Renderer* renderer, SDL_Surface** piece_surfaces, const cell_value_t* pieces, size_t piece_count)
+{
+    int atlas_width = PIECE_ATLAS_PADDING;
+    int atlas_height = 0;
+
+    for (size_t i = 0; i < piece_count; i++)
+    {
+        if(piece_surfaces[i] == NULL) continue;
+
+        atlas_width += piece_surfaces[i]->w + PIECE_ATLAS_PADDING;
+
+        if(piece_surfaces[i]->h > atlas_height) atlas_height = piece_surfaces[i]->h;
+    }
+
+    atlas_height += 2 * PIECE_ATLAS_PADDING;
+
+    SDL_Surface* atlas_surface = SDL_CreateRGBSurfaceWithFormat(0, atlas_width, atlas_height, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Rect dest_rect = { PIECE_ATLAS_PADDING, PIECE_ATLAS_PADDING, 0, 0 };
+
+    for (size_t i = 0; i < piece_count; i++)
+    {
+        if(piece_surfaces[i] == NULL) continue;
+
+        dest_rect.w = piece_surfaces[i]->w;
+        dest_rect.h = piece_surfaces[i]->h;
+
+        if(atlas_surface != NULL)
+        {
+            /* Copies the pixels as they are instead of blending them over the empty atlas */
+            SDL_SetSurfaceBlendMode(piece_surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(piece_surfaces[i], NULL, atlas_surface, &dest_rect);
+        }
+
+        piece_atlas_source_rect(pieces[i]) = (SDL_FRect){
+            (float)dest_rect.x / (float)atlas_width, (float)dest_rect.y / (float)atlas_height,
+            (float)dest_rect.w / (float)atlas_width, (float)dest_rect.h / (float)atlas_height
+        };
+
+        dest_rect.x += dest_rect.w + PIECE_ATLAS_PADDING;
+
+        SDL_FreeSurface(piece_surfaces[i]);
+    }
+
+    if(atlas_surface == NULL) return NULL;
+
+    SDL_Texture* atlas_texture = SDL_CreateTextureFromSurface(renderer, atlas_surface);
+    SDL_FreeSurface(atlas_surface);
+
+    return atlas_texture;
+}
@@ -0,0 +1,155 @@
+#include "include/bitboard.h"
+
+void bitboard_layout_init(bitboard_layout_t* layout, board_unit_t board_side_size, bool double_corner_on_right)
+{
+    cell_id_t playable_cell_count_per_line = board_side_size / 2;
+
+    layout->board_side_size = board_side_size;
+    layout->playable_cell_count = (cell_id_t)(board_side_size * playable_cell_count_per_line);
+    layout->playable_cell_count_per_line = playable_cell_count_per_line;
+    layout->board_mask = bitboard_empty();
+    layout->shifted_lines_mask = bitboard_empty();
+
+    bitboard_t left_column = bitboard_empty();
+    bitboard_t right_column = bitboard_empty();
+
+    for (cell_id_t cid = 0; cid < layout->playable_cell_count; cid++)
+    {
+        board_coordinate_t y = (board_coordinate_t)(cid / playable_cell_count_per_line);
+        bool is_shifted_line = (!double_corner_on_right && y % 2 != 0) || (double_corner_on_right && y % 2 == 0);
+        cell_id_t index_in_line = cid % playable_cell_count_per_line;
+
+        bitboard_set(&layout->board_mask, cid);
+
+        if(is_shifted_line)
+        {
+            bitboard_set(&layout->shifted_lines_mask, cid);
+            if(index_in_line == playable_cell_count_per_line - 1) bitboard_set(&right_column, cid);
+        }
+        else if(index_in_line == 0)
+        {
+            bitboard_set(&left_column, cid);
+        }
+    }
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        int16_t line_shift = (int16_t)(movement_directions[i].y * playable_cell_count_per_line);
+
+        if(movement_directions[i].x > 0)
+        {
+            layout->direction_source_masks[i] = bitboard_and_not(layout->board_mask, right_column);
+            layout->direction_shifts[i][0] = line_shift;
+            layout->direction_shifts[i][1] = (int16_t)(line_shift + 1);
+        }
+        else
+        {
+            layout->direction_source_masks[i] = bitboard_and_not(layout->board_mask, left_column);
+            layout->direction_shifts[i][0] = (int16_t)(line_shift - 1);
+            layout->direction_shifts[i][1] = line_shift;
+        }
+    }
+}
+
+bitboard_t bitboard_shift_towards(const bitboard_layout_t* layout, bitboard_t cells, uint8_t direction)
+{
+    cells = bitboard_and(cells, layout->direction_source_masks[direction]);
+
+    bitboard_t from_regular_lines = bitboard_shift(bitboard_and_not(cells, layout->shifted_lines_mask), layout->direction_shifts[direction][0]);
+    bitboard_t from_shifted_lines = bitboard_shift(bitboard_and(cells, layout->shifted_lines_mask), layout->direction_shifts[direction][1]);
+
+    return bitboard_and(bitboard_or(from_regular_lines, from_shifted_lines), layout->board_mask);
+}
+
+cell_id_t bitboard_layout_neighbor(const bitboard_layout_t* layout, cell_id_t cell, uint8_t direction)
+{
+    if(!bitboard_contains(layout->direction_source_masks[direction], cell)) return NO_CELL;
+
+    int32_t neighbor = cell + layout->direction_shifts[direction][bitboard_contains(layout->shifted_lines_mask, cell)];
+
+    if(neighbor < 0 || neighbor >= layout->playable_cell_count) return NO_CELL;
+
+    return (cell_id_t)neighbor;
+}
+
+bitboard_position_t bitboard_position_from_board(const board_t* board, cell_id_t playable_cell_count)
+{
+    bitboard_position_t position = {0};
+
+    for (cell_id_t cid = 0; cid < playable_cell_count; cid++)
+    {
+        cell_value_t piece_type = board->playable_cells[cid];
+
+        if(piece_type == NO_PIECE) continue;
+
+        if(piece_is_white(piece_type)) bitboard_set(&position.white, cid);
+        else bitboard_set(&position.black, cid);
+
+        if(piece_is_queen(piece_type)) bitboard_set(&position.queens, cid);
+    }
+
+    return position;
+}
+
+void bitboard_position_to_board(const bitboard_position_t* position, board_t* board, cell_id_t playable_cell_count)
+{
+    for (cell_id_t cid = 0; cid < playable_cell_count; cid++)
+    {
+        cell_value_t piece_type = NO_PIECE;
+
+        if(bitboard_contains(position->white, cid)) piece_type = PIECE_WHITE_PEON;
+        else if(bitboard_contains(position->black, cid)) piece_type = PIECE_BLACK_PEON;
+
+        if(piece_type != NO_PIECE && bitboard_contains(position->queens, cid)) piece_type = piece_promote_to_queen(piece_type);
+
+        board_set_cell(board, cid, piece_type);
+    }
+}
+
+void bitboard_position_apply_move(bitboard_position_t* position, move_info_t move)
+{
+    bitboard_t* team_pieces = bitboard_contains(position->white, move.source_cell) ? &position->white : &position->black;
+
+    bitboard_clear(team_pieces, move.source_cell);
+    bitboard_set(team_pieces, move.destination_cell);
+
+    if(bitboard_contains(position->queens, move.source_cell))
+    {
+        bitboard_clear(&position->queens, move.source_cell);
+        bitboard_set(&position->queens, move.destination_cell);
+    }
+
+    if(!move.is_capture_move) return;
+
+    bitboard_clear(&position->white, move.capture_cell);
+    bitboard_clear(&position->black, move.capture_cell);
+    bitboard_clear(&position->queens, move.capture_cell);
+}
+
+bitboard_t bitboard_position_team(const bitboard_position_t* position, team_t team)
+{
+    return team == WHITE_TEAM ? position->white : position->black;
+}
+
+bitboard_t bitboard_position_empty(const bitboard_layout_t* layout, const bitboard_position_t* position)
+{
+    return bitboard_and_not(layout->board_mask, bitboard_or(position->white, position->black));
+}
+
+bitboard_t bitboard_position_capturers(const bitboard_layout_t* layout, const bitboard_position_t* position, team_t team, uint8_t direction)
+{
+    uint8_t opposite_direction = direction_opposite(direction);
+    bitboard_t opponents = bitboard_position_team(position, team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM);
+    bitboard_t landing_cells = bitboard_position_empty(layout, position);
+
+    bitboard_t capturable_opponents = bitboard_and(bitboard_shift_towards(layout, landing_cells, opposite_direction), opponents);
+
+    return bitboard_and(bitboard_shift_towards(layout, capturable_opponents, opposite_direction), bitboard_position_team(position, team));
+}
+
+bitboard_t bitboard_position_quiet_movers(const bitboard_layout_t* layout, const bitboard_position_t* position, team_t team, uint8_t direction)
+{
+    bitboard_t empty_cells = bitboard_position_empty(layout, position);
+
+    return bitboard_and(bitboard_shift_towards(layout, empty_cells, direction_opposite(direction)), bitboard_position_team(position, team));
+}
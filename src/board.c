@@ -1,5 +1,12 @@
-#include "include/game.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "include/board.h"
 #include "include/validation.h"
+#include "include/bitboard.h"
+#include "include/geometry.h"
+#include "include/zobrist.h"
+#include "include/profiler.h"
 
 board_position_t movement_directions [4] = 
 {
@@ -9,14 +16,35 @@ board_position_t movement_directions [4] =
     { .x = -1, .y = -1 }
 };
 
-static inline bool are_coords_within_board_bounds(board_coordinate_t x, board_coordinate_t y)
+#define NO_DIRECTION ((uint8_t)4)
+#define MAX_CAPTURE_STEPS_PER_PIECE (4 * MAX_RAY_LENGTH)
+
+typedef struct
 {
-    return (x >= 0 && x < game.scenario_data.board_side_size) && (y >= 0 && y < game.scenario_data.board_side_size);
-}
+    move_info_t move;
+    uint8_t direction;
+} capture_step_t;
 
-static tree_t board_generate_capture_tree_for_move(board_t* current_board, move_info_t move);
-static void board_get_all_capture_moves_of_team(board_t* board, dynarray(move_info_t)* capture_moves_array, team_t playing_team);
-static void board_get_all_capture_moves_of_piece(board_t* board, dynarray(move_info_t)* capture_moves_array, cell_id_t piece_id);
+/* State shared by the recursion of board_generate_legal_moves */
+typedef struct
+{
+    const ruleset_t* rules;
+    const board_geometry_t* geometry;
+    legal_move_list_t* move_list;
+    legal_move_t current_move;
+    capture_chain_score_t best_score;
+
+    /* Unlike an overflow of the list, a sequence cut at MAX_CAPTURE_SEQUENCE_LENGTH survives a better sequence */
+    bool has_cut_sequence;
+} legal_move_generator_t;
+
+static void board_generate_capture_tree_for_piece(const ruleset_t* rules, const board_geometry_t* geometry, ftree_t* capture_tree, ftnode_id_t parent, capture_chain_score_t* parent_best_score, const bitboard_position_t* position, cell_id_t piece_cell, uint8_t forbidden_direction);
+static size_t board_get_all_capture_steps_of_piece(const ruleset_t* rules, const board_geometry_t* geometry, const bitboard_position_t* position, cell_id_t piece_cell, capture_step_t* capture_steps);
+static size_t board_get_all_capture_steps_of_flying_queen(const board_geometry_t* geometry, const bitboard_position_t* position, cell_id_t queen_id, bitboard_t opponents, capture_step_t* capture_steps);
+static void board_generate_legal_captures_of_piece(legal_move_generator_t* generator, const bitboard_position_t* position, cell_id_t piece_cell, uint8_t forbidden_direction, capture_chain_score_t score);
+static void board_add_legal_capture_sequence(legal_move_generator_t* generator, capture_chain_score_t score);
+static void board_generate_legal_quiet_moves(legal_move_generator_t* generator, const bitboard_position_t* position, team_t playing_team);
+static void board_add_legal_move(legal_move_list_t* move_list, const legal_move_t* move);
 
 team_t piece_team(cell_value_t piece_type)
 {
@@ -33,264 +61,452 @@ team_t piece_team(cell_value_t piece_type)
     }
 }
 
-board_position_t cell_id_to_cell_position(cell_id_t cell_id)
+uint16_t ruleset_key(const ruleset_t* rules)
 {
-    board_unit_t playable_cell_count_per_line = game.scenario_data.board_side_size/2;
-
-    board_position_t cell_position;
-    cell_position.x = (cell_id % playable_cell_count_per_line) * 2;
-    cell_position.y = cell_id / playable_cell_count_per_line;
-    
-    if((!game.scenario_data.double_corner_on_right && cell_position.y % 2 != 0) || 
-        (game.scenario_data.double_corner_on_right && cell_position.y % 2 == 0)) 
-        cell_position.x++;
+    return (uint16_t)(rules->board_side_size
+        | rules->double_corner_on_right << 8
+        | rules->applies_law_of_quantity << 9
+        | rules->applies_law_of_quality << 10
+        | rules->peons_capture_backwards << 11
+        | rules->flying_kings << 12
+        | rules->is_white_peon_forward_top_to_bottom << 13);
+}
 
-    return cell_position;
+board_position_t cell_id_to_cell_position(const ruleset_t* rules, cell_id_t cell_id)
+{
+    return board_geometry_of(rules)->cell_positions[cell_id];
 }
 
-cell_id_t cell_position_to_cell_id(board_position_t cell_position)
+cell_id_t cell_position_to_cell_id(const ruleset_t* rules, board_position_t cell_position)
 {
-    if((!game.scenario_data.double_corner_on_right && cell_position.y % 2 != 0) || 
-        (game.scenario_data.double_corner_on_right && cell_position.y % 2 == 0)) 
+    if((!rules->double_corner_on_right && cell_position.y % 2 != 0) || 
+        (rules->double_corner_on_right && cell_position.y % 2 == 0)) 
         cell_position.x--;
 
-    return cell_position.y * (game.scenario_data.board_side_size / 2) + cell_position.x / 2;
+    return cell_position.y * (rules->board_side_size / 2) + cell_position.x / 2;
 }
 
 void board_apply_move(board_t* board, move_info_t move)
 {
-    board->playable_cells[move.destination_cell] = board->playable_cells[move.source_cell];
+    cell_value_t piece_type = board->playable_cells[move.source_cell];
+
+    board->playable_cells[move.destination_cell] = piece_type;
     board->playable_cells[move.source_cell] = NO_PIECE;
+    board->hash ^= zobrist_piece_key(move.source_cell, piece_type) ^ zobrist_piece_key(move.destination_cell, piece_type);
 
     if(!move.is_capture_move) return;
 
+    board->hash ^= zobrist_piece_key(move.capture_cell, board->playable_cells[move.capture_cell]);
     board->playable_cells[move.capture_cell] = NO_PIECE;
 }
 
-tree_t board_generate_capture_tree(board_t* initial_board)
+void board_set_cell(board_t* board, cell_id_t cell, cell_value_t piece_type)
+{
+    board->hash ^= zobrist_piece_key(cell, board->playable_cells[cell]) ^ zobrist_piece_key(cell, piece_type);
+    board->playable_cells[cell] = piece_type;
+}
+
+void board_clear(board_t* board)
+{
+    memset(board->playable_cells, NO_PIECE, MAX_BOARD_PLAYABLE_CELL_COUNT);
+    board->hash = 0;
+}
+
+zobrist_key_t board_compute_hash(const board_t* board)
+{
+    zobrist_key_t hash = 0;
+
+    for (cell_id_t cid = 0; cid < MAX_BOARD_PLAYABLE_CELL_COUNT; cid++)
+        hash ^= zobrist_piece_key(cid, board->playable_cells[cid]);
+
+    return hash;
+}
+
+zobrist_key_t board_position_hash(const board_t* board, team_t playing_team)
+{
+    return playing_team == BLACK_TEAM ? board->hash ^ zobrist_black_to_move_key : board->hash;
+}
+
+bool board_is_crowning_cell_of_team(const ruleset_t* rules, team_t team, cell_id_t cell)
+{
+    const board_geometry_t* geometry = board_geometry_of(rules);
+    bool crowns_on_bottom_line = (team == WHITE_TEAM) == rules->is_white_peon_forward_top_to_bottom;
+
+    return bitboard_contains(crowns_on_bottom_line ? geometry->bottom_line : geometry->top_line, cell);
+}
+
+bool board_promote_to_queen_if_valid(const ruleset_t* rules, board_t* board, cell_id_t piece_cell)
+{
+    cell_value_t piece_type = board->playable_cells[piece_cell];
+
+    if(!piece_is_peon(piece_type) || !board_is_crowning_cell_of_team(rules, piece_team(piece_type), piece_cell)) return false;
+
+    board_set_cell(board, piece_cell, piece_promote_to_queen(piece_type));
+    return true;
+}
+
+void board_generate_capture_tree(const ruleset_t* rules, const board_t* initial_board, team_t playing_team, ftree_t* capture_tree)
 {
-    board_t internal_board;
-    tree_t capture_tree = rrr_tree_new(0, NULL);
-    dynarray(move_info_t) capture_moves = dynarray_new(move_info_t, 0);
-    
-    board_get_all_capture_moves_of_team(initial_board, &capture_moves, game.current_team);
+    PROFILER_BEGIN(PROFILER_SCOPE_CAPTURE_TREE);
+
+    const board_geometry_t* geometry = board_geometry_of(rules);
+    bitboard_position_t initial_position = bitboard_position_from_board(initial_board, geometry->playable_cell_count);
+    bitboard_t team_pieces = bitboard_position_team(&initial_position, playing_team);
+    capture_chain_score_t best_score = {0};
 
-    for (size_t i = 0; i < dynarray_size(&capture_moves); i++)
+    while (!bitboard_is_empty(team_pieces))
     {
-        tree_t subtree;
-        move_info_t current_move = dynarray_ele(&capture_moves, move_info_t, i);
-
-        internal_board = *initial_board;
-        board_apply_move(&internal_board, current_move);
-        
-        subtree = board_generate_capture_tree_for_move(&internal_board, current_move);
-        tree_insert_subtree(capture_tree, subtree);
+        cell_id_t piece_cell = bitboard_pop_first_cell(&team_pieces);
+        board_generate_capture_tree_for_piece(rules, geometry, capture_tree, FTREE_ROOT, &best_score, &initial_position, piece_cell, NO_DIRECTION);
     }
 
-    dynarray_free(&capture_moves);
+    PROFILER_END(PROFILER_SCOPE_CAPTURE_TREE);
+}
+
+/*
+ * Adds the capture sequences of the piece under parent. The laws are applied while the tree is built:
+ * every subtree comes back with the score of its best sequence, a subtree that is beaten by a sibling
+ * is discarded right away, and the siblings it beats are unlinked.
+ */
+static void board_generate_capture_tree_for_piece(const ruleset_t* rules, const board_geometry_t* geometry, ftree_t* capture_tree, ftnode_id_t parent, capture_chain_score_t* parent_best_score, const bitboard_position_t* position, cell_id_t piece_cell, uint8_t forbidden_direction)
+{
+    capture_step_t capture_steps [MAX_CAPTURE_STEPS_PER_PIECE];
+    size_t capture_step_count = board_get_all_capture_steps_of_piece(rules, geometry, position, piece_cell, capture_steps);
+
+    for (size_t i = 0; i < capture_step_count; i++)
+    {
+        capture_step_t current_step = capture_steps[i];
+
+        if(current_step.direction == forbidden_direction) continue;
+
+        bitboard_position_t internal_position = *position;
+        bitboard_position_apply_move(&internal_position, current_step.move);
+
+        ftnode_id_t node = ftree_add_node(capture_tree, move_info_t, &current_step.move);
+        capture_chain_score_t score = {0};
 
-    if(game.scenario_data.applies_law_of_quantity) validation_capture_tree_apply_law_of_quantity(capture_tree);
-    if(game.scenario_data.applies_law_of_quality) validation_capture_tree_apply_law_of_quality(capture_tree);
+        board_generate_capture_tree_for_piece(rules, geometry, capture_tree, node, &score, &internal_position, current_step.move.destination_cell, direction_opposite(current_step.direction));
 
-    return capture_tree;
+        score.capture_count++;
+        score.points += bitboard_contains(position->queens, current_step.move.capture_cell) ? LAW_OF_QUALITY_QUEEN_POINTS : LAW_OF_QUALITY_PEON_POINTS;
+
+        int comparison = ftree_child_count(capture_tree, parent) == 0 ? 1 : validation_compare_capture_chains(rules, score, *parent_best_score);
+
+        if(comparison < 0)
+        {
+            ftree_rollback(capture_tree, node);
+            continue;
+        }
+
+        if(comparison > 0)
+        {
+            ftree_detach_children(capture_tree, parent);
+            *parent_best_score = score;
+        }
+
+        ftree_attach(capture_tree, parent, node);
+    }
 }
 
-static tree_t board_generate_capture_tree_for_move(board_t* current_board, move_info_t move)
+static size_t board_get_all_capture_steps_of_piece(const ruleset_t* rules, const board_geometry_t* geometry, const bitboard_position_t* position, cell_id_t piece_cell, capture_step_t* capture_steps)
 {
-    board_t internal_board;
-    tree_t capture_tree = tree_new(move_info_t, &move);
-    dynarray(move_info_t) capture_moves = dynarray_new(move_info_t, 0);
-    
-    board_position_t initial_move_source_position = cell_id_to_cell_position(move.source_cell);
-    board_position_t initial_move_destination_position = cell_id_to_cell_position(move.destination_cell);
+    team_t playing_team = bitboard_contains(position->white, piece_cell) ? WHITE_TEAM : BLACK_TEAM;
+    bitboard_t opponents = bitboard_position_team(position, playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM);
+    bool is_queen = bitboard_contains(position->queens, piece_cell);
+
+    if(is_queen && rules->flying_kings) 
+        return board_get_all_capture_steps_of_flying_queen(geometry, position, piece_cell, opponents, capture_steps);
+
+    bitboard_t empty_cells = bitboard_position_empty(&geometry->bitboard_layout, position);
+    cell_value_t peon_type = playing_team == WHITE_TEAM ? PIECE_WHITE_PEON : PIECE_BLACK_PEON;
+    size_t capture_step_count = 0;
 
-    board_position_t initial_movement_vector;
-    initial_movement_vector.x = initial_move_destination_position.x - initial_move_source_position.x;
-    initial_movement_vector.y = initial_move_destination_position.y - initial_move_source_position.y;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        cell_id_t capture_cell = geometry->neighbors[piece_cell][i];
+        cell_id_t destination_cell = geometry->jump_landings[piece_cell][i];
+
+        if(destination_cell == NO_CELL) continue;
 
-    board_coordinate_t initial_movement_magnitude = initial_movement_vector.x < 0 ? -initial_movement_vector.x : initial_movement_vector.x;
+        if(!is_queen && !rules->peons_capture_backwards && !validation_is_peon_moving_forward(rules, peon_type, movement_directions[i])) continue;
 
-    board_position_t initial_movement_direction;
-    initial_movement_direction.x = initial_movement_vector.x / initial_movement_magnitude;
-    initial_movement_direction.y = initial_movement_vector.y / initial_movement_magnitude;
+        if(!bitboard_contains(opponents, capture_cell) || !bitboard_contains(empty_cells, destination_cell)) continue;
 
-    board_get_all_capture_moves_of_piece(current_board, &capture_moves, move.destination_cell);
+        capture_step_t* step = &capture_steps[capture_step_count++];
+        step->direction = i;
+        step->move.is_capture_move = true;
+        step->move.source_cell = piece_cell;
+        step->move.capture_cell = capture_cell;
+        step->move.destination_cell = destination_cell;
+    }
 
-    for (size_t i = 0; i < dynarray_size(&capture_moves); i++)
+    return capture_step_count;
+}
+
+static size_t board_get_all_capture_steps_of_flying_queen(const board_geometry_t* geometry, const bitboard_position_t* position, cell_id_t queen_id, bitboard_t opponents, capture_step_t* capture_steps)
+{
+    bitboard_t empty_cells = bitboard_position_empty(&geometry->bitboard_layout, position);
+    size_t capture_step_count = 0;
+
+    for (uint8_t i = 0; i < 4; i++)
     {
-        tree_t subtree;
-        move_info_t current_move = dynarray_ele(&capture_moves, move_info_t, i);
+        const cell_id_t* ray = geometry->rays[queen_id][i];
+        uint8_t ray_length = geometry->ray_lengths[queen_id][i];
+        uint8_t distance = 0;
 
-        board_position_t current_move_source_position = cell_id_to_cell_position(current_move.source_cell);
-        board_position_t current_move_destination_position = cell_id_to_cell_position(current_move.destination_cell);
+        while (distance < ray_length && bitboard_contains(empty_cells, ray[distance])) distance++;
 
-        board_position_t current_movement_vector;
-        current_movement_vector.x = current_move_destination_position.x - current_move_source_position.x;
-        current_movement_vector.y = current_move_destination_position.y - current_move_source_position.y;
+        if(distance >= ray_length || !bitboard_contains(opponents, ray[distance])) continue;
 
-        board_coordinate_t current_movement_magnitude = current_movement_vector.x < 0 ? -current_movement_vector.x : current_movement_vector.x;
+        capture_step_t step;
+        step.direction = i;
+        step.move.is_capture_move = true;
+        step.move.source_cell = queen_id;
+        step.move.capture_cell = ray[distance];
 
-        board_position_t current_movement_direction;
-        current_movement_direction.x = current_movement_vector.x / current_movement_magnitude;
-        current_movement_direction.y = current_movement_vector.y / current_movement_magnitude;
+        for (distance++; distance < ray_length && bitboard_contains(empty_cells, ray[distance]); distance++)
+        {
+            step.move.destination_cell = ray[distance];
+            capture_steps[capture_step_count++] = step;
+        }
+    }
 
-        if(initial_movement_direction.x == -current_movement_direction.x && initial_movement_direction.y == -current_movement_direction.y)
-            continue;
+    return capture_step_count;
+}
+
+void board_generate_legal_moves(const ruleset_t* rules, const board_t* board, team_t playing_team, legal_move_list_t* move_list)
+{
+    legal_move_generator_t generator;
+    generator.rules = rules;
+    generator.geometry = board_geometry_of(rules);
+    generator.move_list = move_list;
+    generator.best_score = (capture_chain_score_t){0};
+    generator.has_cut_sequence = false;
+
+    move_list->move_count = 0;
+    move_list->is_truncated = false;
 
-        internal_board = *current_board;
-        board_apply_move(&internal_board, current_move);
+    bitboard_position_t position = bitboard_position_from_board(board, generator.geometry->playable_cell_count);
+    bitboard_t team_pieces = bitboard_position_team(&position, playing_team);
 
-        subtree = board_generate_capture_tree_for_move(&internal_board, current_move);
-        tree_insert_subtree(capture_tree, subtree);
+    while (!bitboard_is_empty(team_pieces))
+    {
+        cell_id_t piece_cell = bitboard_pop_first_cell(&team_pieces);
+
+        generator.current_move.source_cell = piece_cell;
+        generator.current_move.capture_count = 0;
+
+        board_generate_legal_captures_of_piece(&generator, &position, piece_cell, NO_DIRECTION, (capture_chain_score_t){0});
     }
 
-    dynarray_free(&capture_moves);
+    if(move_list->move_count > 0 || move_list->is_truncated) return;
 
-    return capture_tree;
+    board_generate_legal_quiet_moves(&generator, &position, playing_team);
 }
 
-static void board_get_all_capture_moves_of_team(board_t* board, dynarray(move_info_t)* capture_moves_array, team_t playing_team)
+/*
+ * Walks the same steps as board_generate_capture_tree_for_piece, but only keeps complete sequences.
+ * Since scores only grow along a sequence, keeping the best complete sequences is the same as pruning the tree.
+ */
+static void board_generate_legal_captures_of_piece(legal_move_generator_t* generator, const bitboard_position_t* position, cell_id_t piece_cell, uint8_t forbidden_direction, capture_chain_score_t score)
 {
-    for (cell_id_t cid = 0; cid < PLAYABLE_CELL_COUNT; cid++)
+    legal_move_t* current_move = &generator->current_move;
+    capture_step_t capture_steps [MAX_CAPTURE_STEPS_PER_PIECE];
+    size_t capture_step_count = board_get_all_capture_steps_of_piece(generator->rules, generator->geometry, position, piece_cell, capture_steps);
+    bool can_continue = false;
+
+    if(current_move->capture_count == MAX_CAPTURE_SEQUENCE_LENGTH)
     {
-        if(piece_team(board->playable_cells[cid]) != playing_team) continue;
+        generator->has_cut_sequence = true;
+        generator->move_list->is_truncated = true;
+        capture_step_count = 0;
+    }
+
+    for (size_t i = 0; i < capture_step_count; i++)
+    {
+        capture_step_t current_step = capture_steps[i];
+
+        if(current_step.direction == forbidden_direction) continue;
+
+        bitboard_position_t internal_position = *position;
+        bitboard_position_apply_move(&internal_position, current_step.move);
+
+        capture_chain_score_t next_score = score;
+        next_score.capture_count++;
+        next_score.points += bitboard_contains(position->queens, current_step.move.capture_cell) ? LAW_OF_QUALITY_QUEEN_POINTS : LAW_OF_QUALITY_PEON_POINTS;
+
+        current_move->destination_cells[current_move->capture_count] = current_step.move.destination_cell;
+        current_move->capture_cells[current_move->capture_count] = current_step.move.capture_cell;
+        current_move->capture_count++;
+
+        board_generate_legal_captures_of_piece(generator, &internal_position, current_step.move.destination_cell, direction_opposite(current_step.direction), next_score);
 
-        board_get_all_capture_moves_of_piece(board, capture_moves_array, cid);
+        current_move->capture_count--;
+        can_continue = true;
     }
+
+    if(!can_continue && current_move->capture_count > 0) board_add_legal_capture_sequence(generator, score);
 }
 
-static void board_get_all_capture_moves_of_piece(board_t* board, dynarray(move_info_t)* capture_moves, cell_id_t piece_id)
+static void board_add_legal_capture_sequence(legal_move_generator_t* generator, capture_chain_score_t score)
 {
-    cell_value_t piece_type = board->playable_cells[piece_id];
-    board_position_t piece_position = cell_id_to_cell_position(piece_id);
+    legal_move_list_t* move_list = generator->move_list;
+    int comparison = move_list->move_count == 0 ? 1 : validation_compare_capture_chains(generator->rules, score, generator->best_score);
+
+    if(comparison < 0) return;
 
-    if(piece_is_peon(piece_type) || !game.scenario_data.flying_kings)
+    if(comparison > 0)
     {
-        for (size_t i = 0; i < 4; i++)
-        {
-            if(!game.scenario_data.peons_capture_backwards && !piece_is_queen(piece_type) && !validation_is_peon_moving_forward(piece_type, movement_directions[i])) continue;
+        move_list->move_count = 0;
+        move_list->is_truncated = generator->has_cut_sequence;
+        generator->best_score = score;
+    }
 
-            board_position_t destination_position;
-            destination_position.x = piece_position.x + movement_directions[i].x*2;
-            destination_position.y = piece_position.y + movement_directions[i].y*2;
+    board_add_legal_move(move_list, &generator->current_move);
+}
 
-            cell_id_t destination_id = cell_position_to_cell_id(destination_position);
+static void board_generate_legal_quiet_moves(legal_move_generator_t* generator, const bitboard_position_t* position, team_t playing_team)
+{
+    const board_geometry_t* geometry = generator->geometry;
+    bitboard_t empty_cells = bitboard_position_empty(&geometry->bitboard_layout, position);
+    bitboard_t team_pieces = bitboard_position_team(position, playing_team);
+    cell_value_t peon_type = playing_team == WHITE_TEAM ? PIECE_WHITE_PEON : PIECE_BLACK_PEON;
 
-            if(!are_coords_within_board_bounds(destination_position.x, destination_position.y) || board->playable_cells[destination_id] != NO_PIECE)
-                continue;
+    legal_move_t move;
+    move.capture_count = 0;
 
-            board_position_t position_of_piece_to_capture;
-            position_of_piece_to_capture.x = piece_position.x + movement_directions[i].x;
-            position_of_piece_to_capture.y = piece_position.y + movement_directions[i].y;
+    while (!bitboard_is_empty(team_pieces))
+    {
+        cell_id_t piece_cell = bitboard_pop_first_cell(&team_pieces);
+        bool is_queen = bitboard_contains(position->queens, piece_cell);
 
-            cell_id_t id_of_piece_to_capture = cell_position_to_cell_id(position_of_piece_to_capture);
+        move.source_cell = piece_cell;
 
-            if(board->playable_cells[id_of_piece_to_capture] != NO_PIECE && !piece_same_team(piece_type, board->playable_cells[id_of_piece_to_capture]))
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            if(!is_queen && !validation_is_peon_moving_forward(generator->rules, peon_type, movement_directions[i])) continue;
+
+            uint8_t max_distance = is_queen && generator->rules->flying_kings ? geometry->ray_lengths[piece_cell][i] : 1;
+
+            for (uint8_t distance = 0; distance < max_distance && distance < geometry->ray_lengths[piece_cell][i]; distance++)
             {
-                move_info_t current_capture_move;
-                current_capture_move.is_capture_move = true;
-                current_capture_move.source_cell = piece_id;
-                current_capture_move.capture_cell = id_of_piece_to_capture;
-                current_capture_move.destination_cell = destination_id;
+                cell_id_t destination_cell = geometry->rays[piece_cell][i][distance];
 
-                dynarray_add(capture_moves, move_info_t, &current_capture_move); 
+                if(!bitboard_contains(empty_cells, destination_cell)) break;
+
+                move.destination_cells[0] = destination_cell;
+                board_add_legal_move(generator->move_list, &move);
             }
         }
     }
-    else if(piece_is_queen(piece_type))
-    {
-        for (size_t i = 0; i < 4; i++)
-        {
-            board_coordinate_t distance = 1;
-            bool found_possible_capture_cell = false;
-            cell_id_t possible_capture_cell;
+}
 
-            while (are_coords_within_board_bounds(piece_position.x + movement_directions[i].x*distance, piece_position.y + movement_directions[i].y*distance))
-            {
-                board_position_t target_piece_position;
-                target_piece_position.x = piece_position.x + movement_directions[i].x * distance;
-                target_piece_position.y = piece_position.y + movement_directions[i].y * distance;
+static void board_add_legal_move(legal_move_list_t* move_list, const legal_move_t* move)
+{
+    if(move_list->move_count == LEGAL_MOVE_LIST_CAPACITY)
+    {
+        move_list->is_truncated = true;
+        return;
+    }
 
-                cell_id_t current_cell = cell_position_to_cell_id(target_piece_position);
+    move_list->moves[move_list->move_count++] = *move;
+}
 
-                cell_value_t piece_to_be_eaten = board->playable_cells[current_cell];
+size_t legal_move_step_count(const legal_move_t* move)
+{
+    return move->capture_count > 0 ? move->capture_count : 1;
+}
 
-                if(piece_to_be_eaten != NO_PIECE)
-                {
-                    possible_capture_cell = current_cell;
-                    found_possible_capture_cell = !piece_same_team(piece_to_be_eaten, piece_type);
-                    break;
-                }
+move_info_t legal_move_get_step(const legal_move_t* move, size_t step_index)
+{
+    move_info_t step;
+    step.is_capture_move = move->capture_count > 0;
+    step.source_cell = step_index == 0 ? move->source_cell : move->destination_cells[step_index - 1];
+    step.destination_cell = move->destination_cells[step_index];
+    step.capture_cell = step.is_capture_move ? move->capture_cells[step_index] : NO_CELL;
 
-                distance++;
-            }
+    return step;
+}
 
-            if(!found_possible_capture_cell) continue;
+cell_id_t legal_move_final_cell(const legal_move_t* move)
+{
+    return move->destination_cells[legal_move_step_count(move) - 1];
+}
 
-            distance++;
+void legal_move_to_notation(const legal_move_t* move, char* out_notation, size_t notation_size)
+{
+    char separator = move->capture_count > 0 ? 'x' : '-';
+    size_t length = (size_t)snprintf(out_notation, notation_size, "%d", move->source_cell + 1);
 
-            move_info_t move;
-            move.is_capture_move = true;
-            move.source_cell = piece_id;
-            move.capture_cell = possible_capture_cell;
+    for (size_t i = 0; i < legal_move_step_count(move) && length < notation_size; i++)
+        length += (size_t)snprintf(&out_notation[length], notation_size - length, "%c%d", separator, move->destination_cells[i] + 1);
+}
 
-            while (are_coords_within_board_bounds(piece_position.x + movement_directions[i].x*distance, piece_position.y + movement_directions[i].y*distance))
-            {
-                board_position_t target_piece_position;
-                target_piece_position.x = piece_position.x + movement_directions[i].x * distance;
-                target_piece_position.y = piece_position.y + movement_directions[i].y * distance;
+const legal_move_t* legal_move_list_find_notation(const legal_move_list_t* move_list, const char* notation)
+{
+    char move_notation [LEGAL_MOVE_NOTATION_SIZE];
 
-                cell_id_t current_cell = cell_position_to_cell_id(target_piece_position);
+    for (size_t i = 0; i < move_list->move_count; i++)
+    {
+        legal_move_to_notation(&move_list->moves[i], move_notation, LEGAL_MOVE_NOTATION_SIZE);
 
-                cell_value_t limiter_piece = board->playable_cells[current_cell];
+        if(strcmp(move_notation, notation) == 0) return &move_list->moves[i];
+    }
 
-                if(limiter_piece != NO_PIECE) break;
+    return NULL;
+}
 
-                move.destination_cell = current_cell;
+const legal_move_t* legal_move_list_find_steps(const legal_move_list_t* move_list, const move_info_t* steps, size_t step_count)
+{
+    for (size_t i = 0; i < move_list->move_count; i++)
+    {
+        const legal_move_t* move = &move_list->moves[i];
+        bool does_match = legal_move_step_count(move) == step_count;
 
-                dynarray_add(capture_moves, move_info_t, &move); 
+        for (size_t s = 0; does_match && s < step_count; s++)
+        {
+            move_info_t step = legal_move_get_step(move, s);
 
-                distance++;
-            }
+            does_match = step.source_cell == steps[s].source_cell && step.destination_cell == steps[s].destination_cell && step.is_capture_move == steps[s].is_capture_move
+                && (!step.is_capture_move || step.capture_cell == steps[s].capture_cell);
         }
+
+        if(does_match) return move;
     }
+
+    return NULL;
 }
 
-bool board_contains_any_valid_moves_for_team(board_t* board, team_t playing_team)
+void board_play_legal_move(const ruleset_t* rules, board_t* board, const legal_move_t* move)
 {
-    for (cell_id_t cid = 0; cid < PLAYABLE_CELL_COUNT; cid++)
-    {
-        if(piece_team(board->playable_cells[cid]) != playing_team) continue;
+    size_t step_count = legal_move_step_count(move);
 
-        cell_value_t piece_type = board->playable_cells[cid];
-        board_position_t piece_position = cell_id_to_cell_position(cid);
+    for (size_t i = 0; i < step_count; i++)
+        board_apply_move(board, legal_move_get_step(move, i));
 
-        for (size_t i = 0; i < 4; i++)
-        {
-            board_position_t possible_pos1;
-            possible_pos1.x = piece_position.x + movement_directions[i].x; 
-            possible_pos1.y = piece_position.y + movement_directions[i].y;
-            
-            board_position_t possible_pos2;
-            possible_pos2.x = piece_position.x + movement_directions[i].x*2; 
-            possible_pos2.y = piece_position.y + movement_directions[i].y*2;
+    board_promote_to_queen_if_valid(rules, board, legal_move_final_cell(move));
+}
 
-            if(!are_coords_within_board_bounds(possible_pos1.x, possible_pos1.y)) continue;
+bool board_contains_any_valid_moves_for_team(const ruleset_t* rules, const board_t* board, team_t playing_team)
+{
+    const board_geometry_t* geometry = board_geometry_of(rules);
+    bitboard_position_t position = bitboard_position_from_board(board, geometry->playable_cell_count);
 
-            bool is_valid_non_eat_movement = piece_is_queen(piece_type) || (piece_is_peon(piece_type) && validation_is_peon_moving_forward(piece_type, movement_directions[i]));
+    cell_value_t peon_type = playing_team == WHITE_TEAM ? PIECE_WHITE_PEON : PIECE_BLACK_PEON;
+    bitboard_t team_pieces = bitboard_position_team(&position, playing_team);
+    bitboard_t team_queens = bitboard_and(team_pieces, position.queens);
 
-            cell_id_t cell_id_pos1 = cell_position_to_cell_id(possible_pos1);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        bool is_forward = validation_is_peon_moving_forward(rules, peon_type, movement_directions[i]);
 
-            if(is_valid_non_eat_movement && board->playable_cells[cell_id_pos1] == NO_PIECE) return true;
+        bitboard_t quiet_able_pieces = is_forward ? team_pieces : team_queens;
+        bitboard_t capture_able_pieces = is_forward || rules->peons_capture_backwards ? team_pieces : team_queens;
 
-            if(!are_coords_within_board_bounds(possible_pos2.x, possible_pos2.y)) continue;
-            
-            cell_id_t cell_id_pos2 = cell_position_to_cell_id(possible_pos2);
+        if(!bitboard_is_empty(bitboard_and(quiet_able_pieces, bitboard_position_quiet_movers(&geometry->bitboard_layout, &position, playing_team, i)))) return true;
 
-            if((is_valid_non_eat_movement || game.scenario_data.peons_capture_backwards) && piece_team(board->playable_cells[cell_id_pos1]) != playing_team && board->playable_cells[cell_id_pos2] == NO_PIECE) 
-                return true;
-        }
+        if(!bitboard_is_empty(bitboard_and(capture_able_pieces, bitboard_position_capturers(&geometry->bitboard_layout, &position, playing_team, i)))) return true;
     }
 
     return false;
-}
\ No newline at end of file
+}
@@ -0,0 +1,86 @@
+#include <string.h>
+
+#include "include/capture_tree_cache.h"
+
+static capture_tree_cache_entry_t* capture_tree_cache_find(capture_tree_cache_t* cache, zobrist_key_t position_hash, uint16_t rules_key, const board_t* board, team_t playing_team);
+static capture_tree_cache_entry_t* capture_tree_cache_least_recently_used(capture_tree_cache_t* cache);
+
+void capture_tree_cache_init(capture_tree_cache_t* cache)
+{
+    memset(cache, 0, sizeof(capture_tree_cache_t));
+}
+
+void capture_tree_cache_free(capture_tree_cache_t* cache)
+{
+    for (size_t i = 0; i < CAPTURE_TREE_CACHE_CAPACITY; i++)
+    {
+        if(cache->entries[i].capture_tree.nodes != NULL) ftree_free(&cache->entries[i].capture_tree);
+    }
+
+    memset(cache, 0, sizeof(capture_tree_cache_t));
+}
+
+const ftree_t* capture_tree_cache_get(capture_tree_cache_t* cache, const ruleset_t* rules, const board_t* board, team_t playing_team)
+{
+    zobrist_key_t position_hash = board_position_hash(board, playing_team);
+    uint16_t rules_key = ruleset_key(rules);
+    capture_tree_cache_entry_t* entry = capture_tree_cache_find(cache, position_hash, rules_key, board, playing_team);
+
+    cache->use_counter++;
+
+    if(entry != NULL)
+    {
+        cache->hit_count++;
+        entry->last_use = cache->use_counter;
+        return &entry->capture_tree;
+    }
+
+    cache->miss_count++;
+    entry = capture_tree_cache_least_recently_used(cache);
+
+    if(entry->capture_tree.nodes == NULL)
+        entry->capture_tree = ftree_new(move_info_t, CAPTURE_TREE_INITIAL_NODE_COUNT);
+    else
+        ftree_clear(&entry->capture_tree);
+
+    board_generate_capture_tree(rules, board, playing_team, &entry->capture_tree);
+
+    entry->is_used = true;
+    entry->last_use = cache->use_counter;
+    entry->position_hash = position_hash;
+    entry->rules_key = rules_key;
+    entry->playing_team = playing_team;
+    entry->board = *board;
+
+    return &entry->capture_tree;
+}
+
+static capture_tree_cache_entry_t* capture_tree_cache_find(capture_tree_cache_t* cache, zobrist_key_t position_hash, uint16_t rules_key, const board_t* board, team_t playing_team)
+{
+    for (size_t i = 0; i < CAPTURE_TREE_CACHE_CAPACITY; i++)
+    {
+        capture_tree_cache_entry_t* entry = &cache->entries[i];
+
+        if(!entry->is_used || entry->position_hash != position_hash || entry->rules_key != rules_key || entry->playing_team != playing_team) continue;
+
+        if(memcmp(entry->board.playable_cells, board->playable_cells, MAX_BOARD_PLAYABLE_CELL_COUNT) == 0) return entry;
+    }
+
+    return NULL;
+}
+
+static capture_tree_cache_entry_t* capture_tree_cache_least_recently_used(capture_tree_cache_t* cache)
+{
+    capture_tree_cache_entry_t* oldest_entry = &cache->entries[0];
+
+    for (size_t i = 0; i < CAPTURE_TREE_CACHE_CAPACITY; i++)
+    {
+        capture_tree_cache_entry_t* entry = &cache->entries[i];
+
+        if(!entry->is_used) return entry;
+
+        if(entry->last_use < oldest_entry->last_use) oldest_entry = entry;
+    }
+
+    return oldest_entry;
+}
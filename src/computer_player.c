@@ -0,0 +1,77 @@
+#include <stdlib.h>
+
+#include "include/computer_player.h"
+#include "include/logger.h"
+
+static int computer_player_search(void* data);
+
+void computer_player_init(computer_player_t* player, const ruleset_t* rules)
+{
+    searcher_init(&player->searcher, rules);
+
+    player->thread = NULL;
+    player->is_searching = false;
+    SDL_AtomicSet(&player->is_search_done, 0);
+    atomic_init(&player->stop_requested, false);
+}
+
+void computer_player_free(computer_player_t* player)
+{
+    if(player->thread != NULL)
+    {
+        atomic_store(&player->stop_requested, true);
+        SDL_WaitThread(player->thread, NULL);
+        player->thread = NULL;
+    }
+
+    player->is_searching = false;
+    searcher_free(&player->searcher);
+}
+
+void computer_player_start_search(computer_player_t* player, const board_t* board, team_t team)
+{
+    if(player->is_searching) return;
+
+    player->board = *board;
+    player->team = team;
+    player->is_searching = true;
+    SDL_AtomicSet(&player->is_search_done, 0);
+    atomic_store(&player->stop_requested, false);
+
+    player->thread = SDL_CreateThread(computer_player_search, "ComputerPlayer", player);
+
+    if(player->thread == NULL)
+    {
+        LOGGER_ERRORF("SDL could not create the computer player thread!, %s", SDL_GetError());
+        exit(EXIT_FAILURE);
+    }
+}
+
+bool computer_player_poll_move(computer_player_t* player, legal_move_t* out_move)
+{
+    if(!player->is_searching || !SDL_AtomicGet(&player->is_search_done)) return false;
+
+    SDL_WaitThread(player->thread, NULL);
+    player->thread = NULL;
+    player->is_searching = false;
+
+    if(!player->result.has_move) return false;
+
+    *out_move = player->result.best_move;
+    return true;
+}
+
+static int computer_player_search(void* data)
+{
+    computer_player_t* player = data;
+
+    search_limits_t limits;
+    limits.max_depth = 0;
+    limits.time_budget_seconds = COMPUTER_PLAYER_TIME_BUDGET_SECONDS;
+    limits.stop_requested = &player->stop_requested;
+
+    player->result = searcher_find_best_move(&player->searcher, &player->board, player->team, limits);
+
+    SDL_AtomicSet(&player->is_search_done, 1);
+    return 0;
+}
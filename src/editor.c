@@ -4,9 +4,11 @@
 #include "include/game.h"
 #include "include/assetman_setup.h"
 #include "include/scenario_loader.h"
+#include "include/scenario_writer.h"
 #include "include/rendering.h"
 #include "include/strplus.h"
 #include "include/ui_labels.h"
+#include "include/sui_text_cache.h"
 
 /* 20 digits + ".sch" + '\0' */
 #define SCH_FILE_NAME_CHAR_COUNT 25
@@ -21,13 +23,14 @@ typedef char sch_editor_icon_path_t [SCH_ICON_PATH_CHAR_COUNT];
 static void save_scenario_as_sch_file(void* event_data);
 
 static void editor_section_navbar(uint8_t selected_section);
+static void editor_build_main_section();
+static void editor_build_rules_section();
+static void editor_build_pieces_section();
+static void editor_show_section(uint8_t section);
 static void editor_set_main_section(void* event_data);
 static void editor_set_rules_section(void* event_data);
 static void editor_set_pieces_section(void* event_data);
 
-static void save_single_cell_assignment(FILE* f, cell_id_t cid, cell_value_t piece_type);
-static void save_multi_cell_assignment(FILE* f, cell_id_t start_cid, cell_id_t end_cid, cell_value_t piece_type);
-
 static void clear_placeable_piece();
 static void set_placeable_white_peon();
 static void set_placeable_black_peon();
@@ -40,17 +43,15 @@ static void switch_law_of_quality(void*);
 static void switch_peons_capture_backwards(void*);
 static void switch_double_corner_side(void*);
 static void switch_board_size(void*);
+static void switch_computer_team(void*);
 
-static string_t scenario_mode_to_str(uint8_t mode);
-static string_t boolean_to_str(bool boolean);
-static string_t team_to_str(team_t team);
-static string_t peon_movement_to_str(bool is_white_peon_forward_top_to_bottom);
+static SDL_Texture* computer_team_value_texture(team_t team);
 static void toggle_text_input_field(void* event_data);
 static void update_sch_name_texture();
 static void save_scenario_icon(char* save_path);
 static void generate_save_paths(sch_editor_file_path_t* sch_file_path, sch_editor_icon_path_t* icon_file_path);
 
-/* Points to a sui_texture_t only when the main section is active, otherwise points to NULL */
+/* Points to the name field of the main section, which keeps its elements while another section is shown */
 static sui_texture_t* sch_name_texture_element = NULL;
 
 void game_set_mode_editor(void* event_data)
@@ -59,7 +60,6 @@ void game_set_mode_editor(void* event_data)
 
     sch_name_texture_element = NULL;
     game_free_dependencies();
-    sui_clear_elements();
 
     game.piece_type_to_place = NO_PIECE;
 
@@ -72,6 +72,8 @@ void game_set_mode_editor(void* event_data)
     game.screen_scenario_board_rect = (SDL_Rect){ 0, 0, BOARD_SECTION_WIDTH, BOARD_SECTION_HEIGHT };
     game.screen_scenario_ui_rect = (SDL_Rect){ BOARD_SECTION_WIDTH, 0, SCREEN_WIDTH - BOARD_SECTION_WIDTH, BOARD_SECTION_HEIGHT };
 
+    render_board_background_build();
+
     SDL_Texture* main_section_label = sui_texture_from_text(game.renderer, assetman_get_asset("$Font45pt"), UI_EDITOR_LABEL_MAIN, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
     SDL_Texture* rules_section_label = sui_texture_from_text(game.renderer, assetman_get_asset("$Font45pt"), UI_EDITOR_LABEL_RULES, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
     SDL_Texture* pieces_section_label = sui_texture_from_utf8_text(game.renderer, assetman_get_asset("$Font45pt"), UI_EDITOR_LABEL_PIECES, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
@@ -82,6 +84,8 @@ void game_set_mode_editor(void* event_data)
 
     SDL_Texture* true_value_label = sui_texture_from_text(game.renderer, assetman_get_asset("$Font45pt"), UI_EDITOR_LABEL_YES, (SDL_Color){ MIDDLE_COLOR_VALS, 255 });
     SDL_Texture* false_value_label = sui_texture_from_utf8_text(game.renderer, assetman_get_asset("$Font45pt"), UI_EDITOR_LABEL_NO, (SDL_Color){ MIDDLE_COLOR_VALS, 255 });
+    SDL_Texture* white_value_label = sui_texture_from_text(game.renderer, assetman_get_asset("$Font45pt"), UI_EDITOR_LABEL_WHITE, (SDL_Color){ MIDDLE_COLOR_VALS, 255 });
+    SDL_Texture* black_value_label = sui_texture_from_text(game.renderer, assetman_get_asset("$Font45pt"), UI_EDITOR_LABEL_BLACK, (SDL_Color){ MIDDLE_COLOR_VALS, 255 });
 
     SDL_Texture* board_size_label_8x8 = sui_texture_from_text(game.renderer, assetman_get_asset("$Font45pt"), UI_EDITOR_LABEL_8X8, (SDL_Color){0,0,0,255});
     SDL_Texture* board_size_label_10x10 = sui_texture_from_text(game.renderer, assetman_get_asset("$Font45pt"), UI_EDITOR_LABEL_10X10, (SDL_Color){0,0,0,255});
@@ -102,6 +106,8 @@ void game_set_mode_editor(void* event_data)
 
     assetman_set_asset(true, "EditorTrueValue", TEXTURE_ASSET_TYPE, true_value_label);
     assetman_set_asset(true, "EditorFalseValue", TEXTURE_ASSET_TYPE, false_value_label);
+    assetman_set_asset(true, "EditorWhiteValue", TEXTURE_ASSET_TYPE, white_value_label);
+    assetman_set_asset(true, "EditorBlackValue", TEXTURE_ASSET_TYPE, black_value_label);
 
     assetman_set_asset(true, "EditorBoard8x8", TEXTURE_ASSET_TYPE, board_size_label_8x8);
     assetman_set_asset(true, "EditorBoard10x10", TEXTURE_ASSET_TYPE, board_size_label_10x10);
@@ -124,14 +130,21 @@ void game_set_mode_editor(void* event_data)
     SDL_Texture* law_of_quality_field_label = sui_texture_from_text(game.renderer, assetman_get_asset("$Font35pt"), UI_EDITOR_LABEL_LAW_QUALITY, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
     SDL_Texture* peons_capture_backwards_field_label = sui_texture_from_utf8_text(game.renderer, assetman_get_asset("$Font26pt"), UI_EDITOR_LABEL_PEON_BACK_CAPTURE, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
     SDL_Texture* flying_kings_field_label = sui_texture_from_text(game.renderer, assetman_get_asset("$Font35pt"), UI_EDITOR_LABEL_FLYING_KINGS, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
+    SDL_Texture* computer_player_field_label = sui_texture_from_text(game.renderer, assetman_get_asset("$Font35pt"), UI_EDITOR_LABEL_COMPUTER_PLAYER, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
 
     assetman_set_asset(true, "EditorFieldInitPlayer", TEXTURE_ASSET_TYPE, initial_player_field_label);
     assetman_set_asset(true, "EditorFieldFlyingKings", TEXTURE_ASSET_TYPE, flying_kings_field_label);
     assetman_set_asset(true, "EditorFieldPeonsCaptureBack", TEXTURE_ASSET_TYPE, peons_capture_backwards_field_label);
     assetman_set_asset(true, "EditorFieldQuantityLaw", TEXTURE_ASSET_TYPE, law_of_quantity_field_label);
     assetman_set_asset(true, "EditorFieldQualityLaw", TEXTURE_ASSET_TYPE, law_of_quality_field_label);
+    assetman_set_asset(true, "EditorFieldComputerPlayer", TEXTURE_ASSET_TYPE, computer_player_field_label);
 
-    editor_set_main_section(NULL);
+    /* Sections are built once per visit, switching sections only activates their elements */
+    editor_build_main_section();
+    editor_build_rules_section();
+    editor_build_pieces_section();
+
+    editor_show_section(0);
     
     LOGGER_LOGS("Finished loading Editor!");
 }
@@ -150,35 +163,7 @@ static void save_scenario_as_sch_file(void* event_data)
 
     if(f == NULL) exit(EXIT_FAILURE);
 
-    fprintf(f, "SCENARIO_TYPE : %s\n", scenario_mode_to_str(scenario->scenario_mode));
-    
-    if(strcmp(game.text_input_field, "") != 0)
-        fprintf(f, "NAME:\"%s\"\n", game.text_input_field);
-
-    fprintf(f, "ICON:\"%s\"\n", icon_path);
-    
-    fprintf(f, "TEAM : %s\n", team_to_str(scenario->team));
-    fprintf(f, "BOARD : %"PRId16"\n", scenario->board_side_size);
-    fprintf(f, "FLYING_KINGS : %s\n", boolean_to_str(scenario->flying_kings));
-    fprintf(f, "PEONS_CAPTURE_BACKWARDS : %s\n", boolean_to_str(scenario->peons_capture_backwards));
-    fprintf(f, "PEONS_MOVEMENT : %s\n", peon_movement_to_str(scenario->is_white_peon_forward_top_to_bottom));
-    fprintf(f, "APPLY_LAW_OF_QUANTITY : %s\n", boolean_to_str(scenario->applies_law_of_quantity));
-    fprintf(f, "APPLY_LAW_OF_QUALITY : %s\n", boolean_to_str(scenario->applies_law_of_quality));
-    fprintf(f, "DOUBLE_CORNER_SIDE : %s\n", boolean_to_str(scenario->double_corner_on_right));
-
-    for (cell_id_t cid = 0; cid < PLAYABLE_CELL_COUNT; cid++)
-    {
-        cell_value_t piece_type = scenario->board.playable_cells[cid];
-
-        cell_id_t start_cid = cid;
-
-        while (cid+1 < PLAYABLE_CELL_COUNT && scenario->board.playable_cells[cid+1] == piece_type) cid++;
-
-        if(start_cid == cid)
-            save_single_cell_assignment(f, cid, piece_type);
-        else
-            save_multi_cell_assignment(f, start_cid, cid, piece_type);
-    }
+    scenario_write_sch(f, scenario, game.text_input_field, icon_path);
     
     fclose(f);
 }
@@ -219,20 +204,18 @@ static void editor_section_navbar(uint8_t selected_section)
     sui_texture_element_add_v1(&selected_section_label_rect, selected_section_label);
 }
 
-static void editor_set_main_section(void* event_data)
-{ 
-    game_text_input_field_stop();
-    sch_name_texture_element = NULL;
-
+static void editor_build_main_section()
+{
+    sui_element_set_activate(&game.editor_section_elements[0]);
     sui_clear_elements();
 
     sui_solid_rect_element_add(&game.screen_scenario_ui_rect, (SDL_Color){ MIDDLE_COLOR_VALS, 255 });
     editor_section_navbar(0);
 
-    SDL_Texture* double_corner_side_value_texture = game.scenario_data.double_corner_on_right ? assetman_get_asset("EditorDCornerRight") : assetman_get_asset("EditorDCornerLeft");
+    SDL_Texture* double_corner_side_value_texture = game.scenario_data.rules.double_corner_on_right ? assetman_get_asset("EditorDCornerRight") : assetman_get_asset("EditorDCornerLeft");
     SDL_Texture* board_size_value_texture = NULL;
 
-    switch (game.scenario_data.board_side_size)
+    switch (game.scenario_data.rules.board_side_size)
     {
         case 8: board_size_value_texture = assetman_get_asset("EditorBoard8x8"); break;
         case 10: board_size_value_texture = assetman_get_asset("EditorBoard10x10"); break;
@@ -270,31 +253,30 @@ static void editor_set_main_section(void* event_data)
 
     sui_button_element_add(&sch_name_field_rect, toggle_text_input_field, NULL);
     sui_solid_rect_element_add(&sch_name_field_rect, (SDL_Color){ 255, 255, 255, 255 });
-    sch_name_texture_element = sui_texture_element_add_v2(sch_name_field_rect.x, sch_name_field_rect.y, assetman_get_asset("CurrSchName"));
+    SDL_Texture* sch_name_texture = sui_text_cache_get(game.renderer, assetman_get_asset("$Font35pt"), game.text_input_field, true, (SDL_Color){0,0,0,255});
+    sch_name_texture_element = sui_texture_element_add_v2(sch_name_field_rect.x, sch_name_field_rect.y, sch_name_texture);
 }
 
-static void editor_set_rules_section(void* event_data)
+static void editor_build_rules_section()
 {
-    game_text_input_field_stop();
-    sch_name_texture_element = NULL;
-
+    sui_element_set_activate(&game.editor_section_elements[1]);
     sui_clear_elements();
 
     sui_solid_rect_element_add(&game.screen_scenario_ui_rect, (SDL_Color){ MIDDLE_COLOR_VALS, 255 });
     editor_section_navbar(1);
 
     SDL_Color starting_team_color = game.scenario_data.team == WHITE_TEAM ? (SDL_Color){ WHITE_PIECE_COLOR_VALS, 255 } : (SDL_Color){ BLACK_PIECE_COLOR_VALS, 255 };
-    SDL_Texture* flying_kings_value_texture = game.scenario_data.flying_kings ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
-    SDL_Texture* law_quantity_value_texture = game.scenario_data.applies_law_of_quantity ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
-    SDL_Texture* law_quality_value_texture = game.scenario_data.applies_law_of_quality ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
-    SDL_Texture* peons_capture_backwards_value_texture = game.scenario_data.peons_capture_backwards ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
+    SDL_Texture* flying_kings_value_texture = game.scenario_data.rules.flying_kings ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
+    SDL_Texture* law_quantity_value_texture = game.scenario_data.rules.applies_law_of_quantity ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
+    SDL_Texture* law_quality_value_texture = game.scenario_data.rules.applies_law_of_quality ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
+    SDL_Texture* peons_capture_backwards_value_texture = game.scenario_data.rules.peons_capture_backwards ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
 
-    SDL_Rect rule_buttons_rects [5];
+    SDL_Rect rule_buttons_rects [6];
     SDL_Rect starting_team_color_rect;
 
-    sui_rect_column(&game.screen_scenario_ui_rect, rule_buttons_rects, 5, 260, 100, 15);
+    sui_rect_column(&game.screen_scenario_ui_rect, rule_buttons_rects, 6, 260, 100, 15);
 
-    for (size_t i = 0; i < 5; i++) rule_buttons_rects[i].x += 200;
+    for (size_t i = 0; i < 6; i++) rule_buttons_rects[i].x += 200;
 
     starting_team_color_rect = sui_rect_centered(&rule_buttons_rects[0], 200, 65);
 
@@ -306,32 +288,34 @@ static void editor_set_rules_section(void* event_data)
     sui_simple_button_t* law_quantity_button = sui_simple_button_with_texture_add(&rule_buttons_rects[2], law_quantity_value_texture, switch_law_of_quantity, NULL, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
     sui_simple_button_t* law_quality_button = sui_simple_button_with_texture_add(&rule_buttons_rects[3], law_quality_value_texture, switch_law_of_quality, NULL, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
     sui_simple_button_t* peons_capture_backwards_button = sui_simple_button_with_texture_add(&rule_buttons_rects[4], peons_capture_backwards_value_texture, switch_peons_capture_backwards, NULL, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
+    sui_simple_button_t* computer_team_button = sui_simple_button_with_texture_add(&rule_buttons_rects[5], computer_team_value_texture(game.scenario_data.computer_team), switch_computer_team, NULL, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
 
     flying_kings_button->button_trigger.as_button_element.event_data = &flying_kings_button->text.as_texture_element;
     law_quantity_button->button_trigger.as_button_element.event_data = &law_quantity_button->text.as_texture_element;
     law_quality_button->button_trigger.as_button_element.event_data = &law_quality_button->text.as_texture_element;
     peons_capture_backwards_button->button_trigger.as_button_element.event_data = &peons_capture_backwards_button->text.as_texture_element;
+    computer_team_button->button_trigger.as_button_element.event_data = &computer_team_button->text.as_texture_element;
 
-    int heightA, heightB, heightC, heightD, heightE;
+    int heightA, heightB, heightC, heightD, heightE, heightF;
 
     SDL_QueryTexture(assetman_get_asset("EditorFieldInitPlayer"), NULL, NULL, NULL, &heightA);
     SDL_QueryTexture(assetman_get_asset("EditorFieldFlyingKings"), NULL, NULL, NULL, &heightB);
     SDL_QueryTexture(assetman_get_asset("EditorFieldQuantityLaw"), NULL, NULL, NULL, &heightC);
     SDL_QueryTexture(assetman_get_asset("EditorFieldQualityLaw"), NULL, NULL, NULL, &heightD);
     SDL_QueryTexture(assetman_get_asset("EditorFieldPeonsCaptureBack"), NULL, NULL, NULL, &heightE);
+    SDL_QueryTexture(assetman_get_asset("EditorFieldComputerPlayer"), NULL, NULL, NULL, &heightF);
 
     sui_texture_element_add_v2(rule_buttons_rects[0].x - 400, sui_rect_center_y(&rule_buttons_rects[0], heightA), assetman_get_asset("EditorFieldInitPlayer"));
     sui_texture_element_add_v2(rule_buttons_rects[1].x - 400, sui_rect_center_y(&rule_buttons_rects[1], heightB), assetman_get_asset("EditorFieldFlyingKings"));
     sui_texture_element_add_v2(rule_buttons_rects[2].x - 400, sui_rect_center_y(&rule_buttons_rects[2], heightC), assetman_get_asset("EditorFieldQuantityLaw"));
     sui_texture_element_add_v2(rule_buttons_rects[3].x - 400, sui_rect_center_y(&rule_buttons_rects[3], heightD), assetman_get_asset("EditorFieldQualityLaw"));
     sui_texture_element_add_v2(rule_buttons_rects[4].x - 400, sui_rect_center_y(&rule_buttons_rects[4], heightE), assetman_get_asset("EditorFieldPeonsCaptureBack"));
+    sui_texture_element_add_v2(rule_buttons_rects[5].x - 400, sui_rect_center_y(&rule_buttons_rects[5], heightF), assetman_get_asset("EditorFieldComputerPlayer"));
 }
 
-static void editor_set_pieces_section(void* event_data)
+static void editor_build_pieces_section()
 {
-    game_text_input_field_stop();
-    sch_name_texture_element = NULL;
-
+    sui_element_set_activate(&game.editor_section_elements[2]);
     sui_clear_elements();
 
     sui_solid_rect_element_add(&game.screen_scenario_ui_rect, (SDL_Color){ MIDDLE_COLOR_VALS, 255 });
@@ -348,46 +332,25 @@ static void editor_set_pieces_section(void* event_data)
     sui_simple_button_with_texture_add(&placeables_rects[4], assetman_get_asset("$BlackQueen"), set_placeable_black_queen, NULL, (SDL_Color){ ATTRACTIVE_COLOR_VALS, 255 });
 }
 
-static void save_single_cell_assignment(FILE* f, cell_id_t cid, cell_value_t piece_type)
+static void editor_show_section(uint8_t section)
 {
-    switch(piece_type)
-    {
-        case PIECE_WHITE_PEON:
-            fprintf(f, "%" PRIu16 " : %s\n", cid+1, "WHITE_PEON");
-            break;
-        case PIECE_BLACK_PEON:
-            fprintf(f, "%" PRIu16 " : %s\n", cid+1, "BLACK_PEON");
-            break;
-        case PIECE_WHITE_QUEEN:
-            fprintf(f, "%" PRIu16 " : %s\n", cid+1, "WHITE_QUEEN");
-            break;
-        case PIECE_BLACK_QUEEN:
-            fprintf(f, "%" PRIu16 " : %s\n", cid+1, "BLACK_QUEEN");
-            break;
-        default:
-            break;
-    }
+    game_text_input_field_stop();
+    sui_element_set_activate(&game.editor_section_elements[section]);
 }
 
-static void save_multi_cell_assignment(FILE* f, cell_id_t start_cid, cell_id_t end_cid, cell_value_t piece_type)
+static void editor_set_main_section(void* event_data)
 {
-    switch(piece_type)
-    {
-        case PIECE_WHITE_PEON:
-            fprintf(f, "[%"PRIu16 ";%" PRIu16 "] : %s\n", start_cid+1, end_cid+1, "WHITE_PEON");
-            break;
-        case PIECE_BLACK_PEON:
-            fprintf(f, "[%"PRIu16 ";%" PRIu16 "] : %s\n", start_cid+1, end_cid+1, "BLACK_PEON");
-            break;
-        case PIECE_WHITE_QUEEN:
-            fprintf(f, "[%"PRIu16 ";%" PRIu16 "] : %s\n", start_cid+1, end_cid+1, "WHITE_QUEEN");
-            break;
-        case PIECE_BLACK_QUEEN:
-            fprintf(f, "[%"PRIu16 ";%" PRIu16 "] : %s\n", start_cid+1, end_cid+1, "BLACK_QUEEN");
-            break;
-        default:
-            break;
-    }
+    editor_show_section(0);
+}
+
+static void editor_set_rules_section(void* event_data)
+{
+    editor_show_section(1);
+}
+
+static void editor_set_pieces_section(void* event_data)
+{
+    editor_show_section(2);
 }
 
 static void clear_placeable_piece()
@@ -434,32 +397,44 @@ static void switch_starting_team(void* sui_element_to_update)
 static void switch_flying_kings(void* sui_element_to_update)
 {
     sui_texture_t* sui_texture_to_update = sui_element_to_update;
-    game.scenario_data.flying_kings = !game.scenario_data.flying_kings;
-    sui_texture_to_update->texture = game.scenario_data.flying_kings ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
+    game.scenario_data.rules.flying_kings = !game.scenario_data.rules.flying_kings;
+    sui_texture_to_update->texture = game.scenario_data.rules.flying_kings ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
     sui_texture_to_update->element.rect = sui_texture_rect_centered(&sui_texture_to_update->element.rect, sui_texture_to_update->texture);
 }
 
 static void switch_law_of_quantity(void* sui_element_to_update)
 {
     sui_texture_t* sui_texture_to_update = sui_element_to_update;
-    game.scenario_data.applies_law_of_quantity = !game.scenario_data.applies_law_of_quantity;
-    sui_texture_to_update->texture = game.scenario_data.applies_law_of_quantity ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
+    game.scenario_data.rules.applies_law_of_quantity = !game.scenario_data.rules.applies_law_of_quantity;
+    sui_texture_to_update->texture = game.scenario_data.rules.applies_law_of_quantity ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
     sui_texture_to_update->element.rect = sui_texture_rect_centered(&sui_texture_to_update->element.rect, sui_texture_to_update->texture);
 }
 
 static void switch_law_of_quality(void* sui_element_to_update)
 {
     sui_texture_t* sui_texture_to_update = sui_element_to_update;
-    game.scenario_data.applies_law_of_quality = !game.scenario_data.applies_law_of_quality;
-    sui_texture_to_update->texture = game.scenario_data.applies_law_of_quality ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
+    game.scenario_data.rules.applies_law_of_quality = !game.scenario_data.rules.applies_law_of_quality;
+    sui_texture_to_update->texture = game.scenario_data.rules.applies_law_of_quality ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
     sui_texture_to_update->element.rect = sui_texture_rect_centered(&sui_texture_to_update->element.rect, sui_texture_to_update->texture);
 }
 
 static void switch_peons_capture_backwards(void* sui_element_to_update)
 {
     sui_texture_t* sui_texture_to_update = sui_element_to_update;
-    game.scenario_data.peons_capture_backwards = !game.scenario_data.peons_capture_backwards;
-    sui_texture_to_update->texture = game.scenario_data.peons_capture_backwards ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
+    game.scenario_data.rules.peons_capture_backwards = !game.scenario_data.rules.peons_capture_backwards;
+    sui_texture_to_update->texture = game.scenario_data.rules.peons_capture_backwards ? assetman_get_asset("EditorTrueValue") : assetman_get_asset("EditorFalseValue");
+    sui_texture_to_update->element.rect = sui_texture_rect_centered(&sui_texture_to_update->element.rect, sui_texture_to_update->texture);
+}
+
+static void switch_computer_team(void* sui_element_to_update)
+{
+    sui_texture_t* sui_texture_to_update = sui_element_to_update;
+
+    if(game.scenario_data.computer_team == NO_TEAM) game.scenario_data.computer_team = WHITE_TEAM;
+    else if(game.scenario_data.computer_team == WHITE_TEAM) game.scenario_data.computer_team = BLACK_TEAM;
+    else game.scenario_data.computer_team = NO_TEAM;
+
+    sui_texture_to_update->texture = computer_team_value_texture(game.scenario_data.computer_team);
     sui_texture_to_update->element.rect = sui_texture_rect_centered(&sui_texture_to_update->element.rect, sui_texture_to_update->texture);
 }
 
@@ -467,32 +442,34 @@ static void switch_double_corner_side(void* sui_element_to_update)
 {
     sui_texture_t* sui_texture_to_update = sui_element_to_update;
 
-    game.scenario_data.double_corner_on_right = !game.scenario_data.double_corner_on_right;
+    game.scenario_data.rules.double_corner_on_right = !game.scenario_data.rules.double_corner_on_right;
     
-    if(game.scenario_data.double_corner_on_right)
+    if(game.scenario_data.rules.double_corner_on_right)
         sui_texture_to_update->texture = assetman_get_asset("EditorDCornerRight");
     else
         sui_texture_to_update->texture = assetman_get_asset("EditorDCornerLeft");
 
     sui_texture_to_update->element.rect = sui_texture_rect_centered(&sui_texture_to_update->element.rect, sui_texture_to_update->texture);
+
+    render_board_background_build();
 }
 
 static void switch_board_size(void* sui_element_to_update)
 {
     sui_texture_t* sui_texture_to_update = sui_element_to_update;
 
-    switch(game.scenario_data.board_side_size)
+    switch(game.scenario_data.rules.board_side_size)
     {
         case 8:
-            game.scenario_data.board_side_size = 10;
+            game.scenario_data.rules.board_side_size = 10;
             sui_texture_to_update->texture = assetman_get_asset("EditorBoard10x10");
             break;
         case 10:
-            game.scenario_data.board_side_size = 12;
+            game.scenario_data.rules.board_side_size = 12;
             sui_texture_to_update->texture = assetman_get_asset("EditorBoard12x12");
             break;
         case 12:
-            game.scenario_data.board_side_size = 8;
+            game.scenario_data.rules.board_side_size = 8;
             sui_texture_to_update->texture = assetman_get_asset("EditorBoard8x8");
             break;
         default:
@@ -500,26 +477,16 @@ static void switch_board_size(void* sui_element_to_update)
     }
 
     sui_texture_to_update->element.rect = sui_texture_rect_centered(&sui_texture_to_update->element.rect, sui_texture_to_update->texture);
-}
 
-static string_t scenario_mode_to_str(uint8_t mode)
-{
-    return mode == SCENARIO_MODE_1V1 ? "SCENARIO_1V1" : "SCENARIO_CHALLENGE"; 
-}
-
-static string_t boolean_to_str(bool boolean)
-{
-    return boolean ? "TRUE" : "FALSE";
+    render_board_background_build();
 }
 
-static string_t team_to_str(team_t team)
+static SDL_Texture* computer_team_value_texture(team_t team)
 {
-    return team == WHITE_TEAM ? "WHITE" : "BLACK";
-}
+    if(team == WHITE_TEAM) return assetman_get_asset("EditorWhiteValue");
+    if(team == BLACK_TEAM) return assetman_get_asset("EditorBlackValue");
 
-static string_t peon_movement_to_str(bool is_white_peon_forward_top_to_bottom)
-{
-    return is_white_peon_forward_top_to_bottom ? "WHITE_TOP_TO_BOTTOM" : "WHITE_BOTTOM_TO_TOP";
+    return assetman_get_asset("EditorFalseValue");
 }
 
 static void toggle_text_input_field(void* event_data)
@@ -537,17 +504,13 @@ static void update_sch_name_texture()
 {
     if(sch_name_texture_element == NULL) return;
 
-    SDL_Texture* sch_name_texture = sui_texture_from_utf8_text(game.renderer, assetman_get_asset("$Font35pt"), game.text_input_field, (SDL_Color){0,0,0,255});
+    SDL_Texture* sch_name_texture = sui_text_cache_get(game.renderer, assetman_get_asset("$Font35pt"), game.text_input_field, true, (SDL_Color){0,0,0,255});
     SDL_Rect new_rect = sch_name_texture_element->element.rect;
 
     SDL_QueryTexture(sch_name_texture, NULL, NULL, &new_rect.w, &new_rect.h);
     sch_name_texture_element->element.rect = new_rect;
     sch_name_texture_element->texture = sch_name_texture;
-    
-    if(assetman_get_asset("CurrSchName") != NULL)
-        SDL_DestroyTexture(assetman_get_asset("CurrSchName"));
-    
-    assetman_set_asset(true, "CurrSchName", TEXTURE_ASSET_TYPE, sch_name_texture);
+    sui_invalidate();
 }
 
 static void save_scenario_icon(char* save_path)
@@ -0,0 +1,91 @@
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "include/file_mapping.h"
+
+#ifdef _WIN32
+
+bool file_mapping_open(file_mapping_t* mapping, const char* path)
+{
+    HANDLE file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if(file_handle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER file_size;
+
+    if(!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file_handle);
+        return false;
+    }
+
+    HANDLE mapping_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* data = mapping_handle != NULL ? MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+    if(data == NULL)
+    {
+        if(mapping_handle != NULL) CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+        return false;
+    }
+
+    mapping->file_handle = file_handle;
+    mapping->mapping_handle = mapping_handle;
+    mapping->data = data;
+    mapping->size = (size_t)file_size.QuadPart;
+
+    return true;
+}
+
+void file_mapping_close(file_mapping_t* mapping)
+{
+    UnmapViewOfFile(mapping->data);
+    CloseHandle(mapping->mapping_handle);
+    CloseHandle(mapping->file_handle);
+
+    mapping->data = NULL;
+    mapping->size = 0;
+}
+
+#else
+
+bool file_mapping_open(file_mapping_t* mapping, const char* path)
+{
+    int file_descriptor = open(path, O_RDONLY);
+
+    if(file_descriptor < 0) return false;
+
+    struct stat file_status;
+
+    if(fstat(file_descriptor, &file_status) != 0 || file_status.st_size == 0)
+    {
+        close(file_descriptor);
+        return false;
+    }
+
+    void* data = mmap(NULL, (size_t)file_status.st_size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor);
+
+    if(data == MAP_FAILED) return false;
+
+    mapping->data = data;
+    mapping->size = (size_t)file_status.st_size;
+
+    return true;
+}
+
+void file_mapping_close(file_mapping_t* mapping)
+{
+    munmap((void*)mapping->data, mapping->size);
+
+    mapping->data = NULL;
+    mapping->size = 0;
+}
+
+#endif
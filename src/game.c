@@ -19,6 +19,8 @@ void game_update_menu()
 
 void game_update_selector()
 {
+    selector_update_thumbnails();
+
     if(game.input.type == GAME_INPUT_MOUSE_BUTTON_DOWN && game.input.mouse_button_pressed == SDL_BUTTON_LEFT)
         sui_check_buttons(game.input.mouseX, game.input.mouseY);
 }
@@ -39,6 +41,12 @@ void game_update_scenario()
         return;
     }
 
+    if(game.scenario_data.scenario_mode == SCENARIO_MODE_1V1 && game.scenario_data.computer_team == game.current_team && !game.scenario_game_over_reached)
+    {
+        computer_play_turn();
+        return;
+    }
+
     if(game.input.type == GAME_INPUT_MOUSE_BUTTON_DOWN && game.input.mouse_button_pressed == SDL_BUTTON_LEFT)
     {
         sui_check_buttons(game.input.mouseX, game.input.mouseY);
@@ -113,7 +121,17 @@ void game_set_mode_menu(void* event_data)
     game.mode = MODE_MENU;
     game.update = game_update_menu;
     
-    sui_clear_elements();
+    /* The menu never changes, its elements and textures are built once and kept for the next visits */
+    sui_element_set_activate(&game.menu_elements);
+
+    if(game.is_menu_cached)
+    {
+        LOGGER_LOGS("Finished loading Menu!");
+        return;
+    }
+
+    sui_element_set_init(&game.menu_elements);
+    game.is_menu_cached = true;
 
     TTF_Font* main_font = assetman_get_asset("$Font45pt");
     TTF_Font* title_font = assetman_get_asset("$Font150pt");
@@ -145,10 +163,10 @@ void game_set_mode_menu(void* event_data)
     sui_simple_button_t* editor_button = sui_simple_button_with_text_add(game.renderer, &button_rects[1], main_font, UI_EDITOR_BUTTON_TEXT, game_set_mode_editor, NULL, text_color, button_background_color);
     sui_simple_button_t* quit_button = sui_simple_button_with_text_add(game.renderer, &button_rects[2], main_font, UI_QUIT_BUTTON_TEXT, game_quit, NULL, text_color, button_background_color);
     
-    assetman_set_asset(true, "MenuTitle", TEXTURE_ASSET_TYPE, title_text_texture);
-    assetman_set_asset(true, "MenuStart", TEXTURE_ASSET_TYPE, start_button->text.as_texture_element.texture);
-    assetman_set_asset(true, "MenuEditor", TEXTURE_ASSET_TYPE, editor_button->text.as_texture_element.texture);
-    assetman_set_asset(true, "MenuQuit", TEXTURE_ASSET_TYPE, quit_button->text.as_texture_element.texture);
+    assetman_set_asset(true, "$MenuTitle", TEXTURE_ASSET_TYPE, title_text_texture);
+    assetman_set_asset(true, "$MenuStart", TEXTURE_ASSET_TYPE, start_button->text.as_texture_element.texture);
+    assetman_set_asset(true, "$MenuEditor", TEXTURE_ASSET_TYPE, editor_button->text.as_texture_element.texture);
+    assetman_set_asset(true, "$MenuQuit", TEXTURE_ASSET_TYPE, quit_button->text.as_texture_element.texture);
 
     LOGGER_LOGS("Finished loading Menu!");
 }
@@ -179,6 +197,8 @@ void game_set_mode_scenario(void* scenario_file_name)
     game.screen_scenario_ui_rect.w = UI_SECTION_WIDTH;
     game.screen_scenario_ui_rect.h = BOARD_SECTION_HEIGHT;
 
+    render_board_background_build();
+
     free(safely_stored_scenario_file_name);
 
     SDL_Rect team_displayer_rect = sui_rect_centered(&game.screen_scenario_ui_rect, 2 * UI_SECTION_WIDTH / 3, 2 * UI_SECTION_WIDTH / 3);
@@ -190,7 +210,11 @@ void game_set_mode_scenario(void* scenario_file_name)
 
     if(game.scenario_data.scenario_mode == SCENARIO_MODE_1V1)
     {
+        capture_tree_cache_init(&game.capture_tree_cache);
         game_1v1_scenario_set_capture_data();
+
+        if(game.scenario_data.computer_team != NO_TEAM)
+            computer_player_init(&game.computer_player, &game.scenario_data.rules);
     }
     else if(game.scenario_data.scenario_mode == SCENARIO_MODE_CHALLENGE)
     {
@@ -208,9 +232,9 @@ void game_set_mode_scenario(void* scenario_file_name)
 
 void game_1v1_scenario_set_capture_data()
 {
-    game.capture_tree = board_generate_capture_tree(&game.scenario_data.board);
-    game.current_capture_subtree = game.capture_tree;
-    game.force_capture_move = tree_child_count(game.capture_tree) > 0;
+    game.capture_tree = capture_tree_cache_get(&game.capture_tree_cache, &game.scenario_data.rules, &game.scenario_data.board, game.current_team);
+    game.current_capture_subtree = FTREE_ROOT;
+    game.force_capture_move = ftree_child_count(game.capture_tree, FTREE_ROOT) > 0;
 }
 
 void game_quit(void* event_data)
@@ -227,7 +251,7 @@ void game_check_for_and_activate_victory()
         return;
     }
 
-    if(!board_contains_any_valid_moves_for_team(&game.scenario_data.board, game.current_team))
+    if(!board_contains_any_valid_moves_for_team(&game.scenario_data.rules, &game.scenario_data.board, game.current_team))
     {
         if(game.current_team == WHITE_TEAM)
         {
@@ -278,6 +302,27 @@ void game_activate_game_over_panel(char* text_message)
     game.scenario_game_over_reached = true;
 }
 
+void game_invalidate()
+{
+    game.needs_redraw = true;
+}
+
+bool game_is_animating()
+{
+    switch (game.mode)
+    {
+        case MODE_SELECTOR:
+            return thumbnail_loader_has_pending(&game.selector.thumbnails);
+        case MODE_SCENARIO:
+            if(game.scenario_data.scenario_mode == SCENARIO_MODE_CHALLENGE)
+                return game.scenario_data.team != game.current_team;
+
+            return game.scenario_data.computer_team == game.current_team && !game.scenario_game_over_reached;
+        default:
+            return false;
+    }
+}
+
 void game_free_dependencies()
 {
     game_text_input_field_stop();
@@ -286,10 +331,15 @@ void game_free_dependencies()
     switch (game.mode)
     {
         case MODE_MENU:
+            sui_element_set_activate(NULL);
             break;
         case MODE_EDITOR:
+            sui_element_set_activate(NULL);
+            render_board_background_free();
             break;
         case MODE_SELECTOR:
+            sui_element_set_activate(NULL);
+
             for (size_t i = 0; i < array_size(&game.selector.file_paths); i++)
             {
                 string_t current_path = array_ele(&game.selector.file_paths, string_t, i);
@@ -297,10 +347,19 @@ void game_free_dependencies()
             }
 
             array_free(&game.selector.file_paths);
+            thumbnail_loader_free(&game.selector.thumbnails);
+            free(game.selector.headers);
             break;
         case MODE_SCENARIO:
+            render_board_background_free();
+
             if(game.scenario_data.scenario_mode == SCENARIO_MODE_1V1)
-                tree_free(game.capture_tree);
+            {
+                capture_tree_cache_free(&game.capture_tree_cache);
+
+                if(game.scenario_data.computer_team != NO_TEAM)
+                    computer_player_free(&game.computer_player);
+            }
             else if(game.scenario_data.scenario_mode == SCENARIO_MODE_CHALLENGE)
                 array_free(&game.scenario_data.challenge_moves);
             break;
@@ -311,20 +370,6 @@ void game_free_dependencies()
     assetman_free_dynamic_assets();
 }
 
-void scenario_set_default(scenario_t* scenario)
-{
-    scenario->scenario_mode = SCENARIO_MODE_1V1;
-    scenario->team = WHITE_TEAM;
-    scenario->board_side_size = 8;
-    scenario->flying_kings = true;
-    scenario->peons_capture_backwards = false;
-    scenario->is_white_peon_forward_top_to_bottom = false;
-    scenario->applies_law_of_quantity = true;
-    scenario->applies_law_of_quality = false;
-    scenario->double_corner_on_right = true;
-    memset(scenario->board.playable_cells, NO_PIECE, MAX_BOARD_PLAYABLE_CELL_COUNT);
-}
-
 void game_text_input_field_start()
 {
     game.is_text_input_field_active = true;
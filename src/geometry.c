@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "include/geometry.h"
+#include "include/logger.h"
+
+#define GEOMETRY_TABLE_COUNT (MAX_BOARD_SIDE_DIMENSION / 2)
+
+enum
+{
+    GEOMETRY_TABLES_NOT_BUILT,
+    GEOMETRY_TABLES_BUILDING,
+    GEOMETRY_TABLES_BUILT
+};
+
+static board_geometry_t geometry_tables [GEOMETRY_TABLE_COUNT][2];
+static atomic_int geometry_tables_state = GEOMETRY_TABLES_NOT_BUILT;
+
+static void board_geometry_build_all();
+static void board_geometry_build(board_geometry_t* geometry, board_unit_t board_side_size, bool double_corner_on_right);
+
+const board_geometry_t* board_geometry_get(board_unit_t board_side_size, bool double_corner_on_right)
+{
+    if(board_side_size < 2 || board_side_size > MAX_BOARD_SIDE_DIMENSION || board_side_size % 2 != 0) return NULL;
+
+    if(atomic_load_explicit(&geometry_tables_state, memory_order_acquire) != GEOMETRY_TABLES_BUILT) board_geometry_build_all();
+
+    return &geometry_tables[board_side_size / 2 - 1][double_corner_on_right];
+}
+
+const board_geometry_t* board_geometry_of(const ruleset_t* rules)
+{
+    const board_geometry_t* geometry = board_geometry_get(rules->board_side_size, rules->double_corner_on_right);
+
+    if(geometry == NULL)
+    {
+        LOGGER_ERRORF("Boards of size %d are not supported!", (int)rules->board_side_size);
+        exit(EXIT_FAILURE);
+    }
+
+    return geometry;
+}
+
+/* The first thread to get here builds every table, the others wait for it */
+static void board_geometry_build_all()
+{
+    int expected_state = GEOMETRY_TABLES_NOT_BUILT;
+
+    if(!atomic_compare_exchange_strong(&geometry_tables_state, &expected_state, GEOMETRY_TABLES_BUILDING))
+    {
+        while(atomic_load_explicit(&geometry_tables_state, memory_order_acquire) != GEOMETRY_TABLES_BUILT);
+        return;
+    }
+
+    for (size_t i = 0; i < GEOMETRY_TABLE_COUNT; i++)
+    {
+        board_geometry_build(&geometry_tables[i][false], (board_unit_t)(2 * (i + 1)), false);
+        board_geometry_build(&geometry_tables[i][true], (board_unit_t)(2 * (i + 1)), true);
+    }
+
+    atomic_store_explicit(&geometry_tables_state, GEOMETRY_TABLES_BUILT, memory_order_release);
+}
+
+static void board_geometry_build(board_geometry_t* geometry, board_unit_t board_side_size, bool double_corner_on_right)
+{
+    bitboard_layout_t* layout = &geometry->bitboard_layout;
+
+    bitboard_layout_init(layout, board_side_size, double_corner_on_right);
+
+    geometry->board_side_size = board_side_size;
+    geometry->double_corner_on_right = double_corner_on_right;
+    geometry->playable_cell_count = layout->playable_cell_count;
+    geometry->playable_cell_count_per_line = layout->playable_cell_count_per_line;
+    geometry->top_line = bitboard_empty();
+    geometry->bottom_line = bitboard_empty();
+
+    for (cell_id_t cid = 0; cid < geometry->playable_cell_count; cid++)
+    {
+        board_position_t cell_position;
+        cell_position.y = (board_coordinate_t)(cid / geometry->playable_cell_count_per_line);
+        cell_position.x = (board_coordinate_t)((cid % geometry->playable_cell_count_per_line) * 2);
+
+        if((!double_corner_on_right && cell_position.y % 2 != 0) || (double_corner_on_right && cell_position.y % 2 == 0))
+            cell_position.x++;
+
+        geometry->cell_positions[cid] = cell_position;
+
+        if(cell_position.y == 0) bitboard_set(&geometry->top_line, cid);
+        if(cell_position.y == board_side_size - 1) bitboard_set(&geometry->bottom_line, cid);
+
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            cell_id_t current_cell = bitboard_layout_neighbor(layout, cid, i);
+            uint8_t ray_length = 0;
+
+            geometry->neighbors[cid][i] = current_cell;
+            geometry->jump_landings[cid][i] = current_cell != NO_CELL ? bitboard_layout_neighbor(layout, current_cell, i) : NO_CELL;
+
+            while (current_cell != NO_CELL)
+            {
+                geometry->rays[cid][i][ray_length] = current_cell;
+                ray_length++;
+                current_cell = bitboard_layout_neighbor(layout, current_cell, i);
+            }
+
+            geometry->ray_lengths[cid][i] = ray_length;
+        }
+    }
+}
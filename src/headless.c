@@ -0,0 +1,466 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "include/headless.h"
+#include "include/scenario_loader.h"
+#include "include/scenario_binary.h"
+#include "include/geometry.h"
+#include "include/perft.h"
+#include "include/match.h"
+
+static int headless_validate(int argc, char** argv);
+static size_t headless_validate_file(string_t path, size_t* out_scenario_count);
+static bool headless_validate_scenario(const char* path, scenario_t* scenario);
+static int headless_perft(int argc, char** argv);
+static int headless_selfplay(int argc, char** argv);
+static int headless_replay(int argc, char** argv);
+static bool headless_collect_scenario_paths(int argc, char** argv, array(string_t)* out_paths);
+static void headless_free_scenario(scenario_t* scenario);
+static void headless_print_usage();
+static void headless_print_board(const ruleset_t* rules, const board_t* board);
+static void headless_print_legal_moves(const legal_move_list_t* move_list);
+static const char* headless_team_name(team_t team);
+
+int headless_run(int argc, char** argv)
+{
+    if(argc < 1)
+    {
+        headless_print_usage();
+        return EXIT_FAILURE;
+    }
+
+    if(strcmp(argv[0], "validate") == 0) return headless_validate(argc - 1, &argv[1]);
+    if(strcmp(argv[0], "perft") == 0) return headless_perft(argc - 1, &argv[1]);
+    if(strcmp(argv[0], "selfplay") == 0) return headless_selfplay(argc - 1, &argv[1]);
+    if(strcmp(argv[0], "replay") == 0) return headless_replay(argc - 1, &argv[1]);
+
+    fprintf(stderr, "Unknown command '%s'\n", argv[0]);
+    headless_print_usage();
+
+    return EXIT_FAILURE;
+}
+
+static int headless_validate(int argc, char** argv)
+{
+    if(argc < 1)
+    {
+        headless_print_usage();
+        return EXIT_FAILURE;
+    }
+
+    array(string_t) paths;
+    size_t scenario_count = 0;
+    size_t failure_count = 0;
+
+    if(!headless_collect_scenario_paths(argc, argv, &paths)) return EXIT_FAILURE;
+
+    for (size_t i = 0; i < array_size(&paths); i++)
+    {
+        string_t path = array_ele(&paths, string_t, i);
+
+        failure_count += headless_validate_file(path, &scenario_count);
+
+        free(path);
+    }
+
+    printf("%zu scenarios validated, %zu failed\n", scenario_count, failure_count);
+
+    array_free(&paths);
+
+    return failure_count > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* Every scenario of a library is validated, a library that cannot be read counts as one failure */
+static size_t headless_validate_file(string_t path, size_t* out_scenario_count)
+{
+    scenario_t scenario;
+
+    if(!string_ends_with(path, SCENARIO_BINARY_FILE_EXTENSION))
+    {
+        (*out_scenario_count)++;
+
+        if(!try_load_scenario_from_file(&scenario, path))
+        {
+            printf("FAIL %s: the scenario could not be loaded, the reason was written to stderr\n", path);
+            return 1;
+        }
+
+        return headless_validate_scenario(path, &scenario) ? 0 : 1;
+    }
+
+    scenario_binary_library_t library;
+    size_t failure_count = 0;
+
+    if(!scenario_binary_open(&library, path))
+    {
+        printf("FAIL %s: not a valid scenario library\n", path);
+        (*out_scenario_count)++;
+
+        return 1;
+    }
+
+    for (size_t i = 0; i < scenario_binary_count(&library); i++)
+    {
+        char name [HEADLESS_SCENARIO_NAME_SIZE];
+        snprintf(name, HEADLESS_SCENARIO_NAME_SIZE, "%s#%zu", path, i);
+
+        if(!scenario_binary_record_to_scenario(scenario_binary_record(&library, i), &scenario))
+        {
+            printf("FAIL %s: the scenario could not be loaded, the reason was written to stderr\n", name);
+            failure_count++;
+        }
+        else if(!headless_validate_scenario(name, &scenario)) failure_count++;
+    }
+
+    *out_scenario_count += scenario_binary_count(&library);
+    scenario_binary_close(&library);
+
+    return failure_count;
+}
+
+static bool headless_validate_scenario(const char* path, scenario_t* scenario)
+{
+    const board_geometry_t* geometry = board_geometry_of(&scenario->rules);
+    legal_move_list_t move_list;
+
+    for (cell_id_t cid = 0; cid < geometry->playable_cell_count; cid++)
+    {
+        cell_value_t piece_type = scenario->board.playable_cells[cid];
+
+        if(piece_is_peon(piece_type) && board_is_crowning_cell_of_team(&scenario->rules, piece_team(piece_type), cid))
+        {
+            printf("FAIL %s: the %s peon on cell %d stands on its crowning line\n", path, headless_team_name(piece_team(piece_type)), cid + 1);
+            headless_free_scenario(scenario);
+            return false;
+        }
+    }
+
+    board_generate_legal_moves(&scenario->rules, &scenario->board, scenario->team, &move_list);
+
+    if(move_list.move_count == 0)
+    {
+        printf("FAIL %s: %s has no legal move, the game is already over\n", path, headless_team_name(scenario->team));
+        headless_free_scenario(scenario);
+        return false;
+    }
+
+    if(scenario->scenario_mode == SCENARIO_MODE_CHALLENGE)
+    {
+        board_t board = scenario->board;
+        team_t playing_team = scenario->team;
+        size_t turn = 1;
+
+        for (size_t i = 0; i < array_size(&scenario->challenge_moves); turn++)
+        {
+            const move_info_t* steps = rrr_array_ele(&scenario->challenge_moves, sizeof(move_info_t), i);
+            size_t step_count = scenario_challenge_turn_length(scenario, i);
+
+            board_generate_legal_moves(&scenario->rules, &board, playing_team, &move_list);
+
+            const legal_move_t* move = legal_move_list_find_steps(&move_list, steps, step_count);
+
+            if(move == NULL)
+            {
+                printf("FAIL %s: turn %zu of the challenge is not a legal move for %s\n", path, turn, headless_team_name(playing_team));
+                headless_free_scenario(scenario);
+                return false;
+            }
+
+            board_play_legal_move(&scenario->rules, &board, move);
+
+            playing_team = playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM;
+            i += step_count;
+        }
+    }
+
+    printf("OK   %s\n", path);
+    headless_free_scenario(scenario);
+
+    return true;
+}
+
+static int headless_perft(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        headless_print_usage();
+        return EXIT_FAILURE;
+    }
+
+    int depth = atoi(argv[1]);
+
+    if(depth < 1)
+    {
+        fprintf(stderr, "Depth must be at least 1\n");
+        return EXIT_FAILURE;
+    }
+
+    scenario_t scenario;
+    bool has_truncated_move_list = false;
+
+    load_scenario_from_file(&scenario, argv[0]);
+
+    for (int current_depth = 1; current_depth <= depth; current_depth++)
+    {
+        clock_t start = clock();
+        uint64_t node_count = perft_count(&scenario.rules, &scenario.board, scenario.team, (unsigned)current_depth, &has_truncated_move_list);
+        double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        printf("depth %2d: %12"PRIu64" nodes %10.3f s\n", current_depth, node_count, seconds);
+    }
+
+    if(has_truncated_move_list)
+        fprintf(stderr, "Warning: some positions have more than %d legal moves, the counts are incomplete\n", LEGAL_MOVE_LIST_CAPACITY);
+
+    headless_free_scenario(&scenario);
+
+    return EXIT_SUCCESS;
+}
+
+/* The moves are written one turn per line so the output can be given back to replay */
+static int headless_selfplay(int argc, char** argv)
+{
+    if(argc < 1)
+    {
+        headless_print_usage();
+        return EXIT_FAILURE;
+    }
+
+    int depth = argc > 1 ? atoi(argv[1]) : HEADLESS_SELFPLAY_DEFAULT_DEPTH;
+    int max_turns = argc > 2 ? atoi(argv[2]) : MATCH_DEFAULT_MAX_TURNS;
+
+    if(depth < 1 || max_turns < 1)
+    {
+        fprintf(stderr, "The depth and the number of turns must be at least 1\n");
+        return EXIT_FAILURE;
+    }
+
+    scenario_t scenario;
+    match_player_t white_player;
+    match_player_t black_player;
+    match_t match;
+    search_limits_t limits = { (unsigned)depth, 0, NULL };
+    match_settings_t settings = { (size_t)max_turns, 0, 0 };
+    char notation [LEGAL_MOVE_NOTATION_SIZE];
+
+    load_scenario_from_file(&scenario, argv[0]);
+
+    match_player_init(&white_player, &scenario.rules, limits, false);
+    match_player_init(&black_player, &scenario.rules, limits, false);
+
+    match_play(&match, &scenario, &white_player, &black_player, &settings);
+
+    printf("# %s, depth %d\n", argv[0], depth);
+
+    for (size_t i = 0; i < dynarray_size(&match.moves); i++)
+    {
+        legal_move_to_notation(&dynarray_ele(&match.moves, legal_move_t, i), notation, LEGAL_MOVE_NOTATION_SIZE);
+        puts(notation);
+    }
+
+    printf("# %s after %zu turns\n", match_result_name(match.result), dynarray_size(&match.moves));
+
+    match_free(&match);
+    match_player_free(&white_player);
+    match_player_free(&black_player);
+    headless_free_scenario(&scenario);
+
+    return EXIT_SUCCESS;
+}
+
+static int headless_replay(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        headless_print_usage();
+        return EXIT_FAILURE;
+    }
+
+    FILE* f = fopen(argv[1], "r");
+
+    if(f == NULL)
+    {
+        fprintf(stderr, "Could not open %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    scenario_t scenario;
+    load_scenario_from_file(&scenario, argv[0]);
+
+    board_t board = scenario.board;
+    team_t playing_team = scenario.team;
+    legal_move_list_t move_list;
+    char line [HEADLESS_REPLAY_LINE_SIZE];
+    size_t line_number = 0;
+    size_t turn_count = 0;
+    int status = EXIT_SUCCESS;
+
+    while(fgets(line, HEADLESS_REPLAY_LINE_SIZE, f) != NULL)
+    {
+        line_number++;
+
+        size_t length = strlen(line);
+
+        while(length > 0 && isspace((unsigned char)line[length - 1]))
+            line[--length] = '\0';
+
+        if(length == 0 || line[0] == '#') continue;
+
+        board_generate_legal_moves(&scenario.rules, &board, playing_team, &move_list);
+
+        const legal_move_t* move = legal_move_list_find_notation(&move_list, line);
+
+        if(move == NULL)
+        {
+            printf("Line %zu: %s is not a legal move for %s, legal moves:", line_number, line, headless_team_name(playing_team));
+            headless_print_legal_moves(&move_list);
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        board_play_legal_move(&scenario.rules, &board, move);
+
+        playing_team = playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM;
+        turn_count++;
+    }
+
+    fclose(f);
+
+    headless_print_board(&scenario.rules, &board);
+
+    if(!board_contains_any_valid_moves_for_team(&scenario.rules, &board, playing_team))
+        printf("After %zu turns: %s wins\n", turn_count, headless_team_name(playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM));
+    else
+        printf("After %zu turns: %s to play\n", turn_count, headless_team_name(playing_team));
+
+    headless_free_scenario(&scenario);
+
+    return status;
+}
+
+/* Arguments ending with a scenario extension are files, the others are directories */
+/* \returns false if an argument is neither a scenario file, a library nor a directory, nothing is left to free then */
+static bool headless_collect_scenario_paths(int argc, char** argv, array(string_t)* out_paths)
+{
+    dynarray(string_t) paths = dynarray_new(string_t, 0);
+
+    for (int i = 0; i < argc; i++)
+    {
+        size_t path_length = strlen(argv[i]);
+
+        if(string_ends_with(argv[i], SCENARIO_FILE_EXTENSION) || string_ends_with(argv[i], SCENARIO_BINARY_FILE_EXTENSION))
+        {
+            string_t path = string_heap_concat(argv[i], "");
+            dynarray_add(&paths, string_t, &path);
+            continue;
+        }
+
+        struct stat directory_status;
+
+        if(stat(argv[i], &directory_status) != 0 || !S_ISDIR(directory_status.st_mode))
+        {
+            fprintf(stderr, "'%s' is not a scenario file, library or directory\n", argv[i]);
+
+            *out_paths = dynarray_to_array(&paths, string_t);
+
+            for (size_t p = 0; p < array_size(out_paths); p++)
+                free(array_ele(out_paths, string_t, p));
+
+            array_free(out_paths);
+
+            return false;
+        }
+
+        string_t directory = string_heap_concat(argv[i], path_length > 0 && argv[i][path_length - 1] == '/' ? "" : "/");
+        array(string_t) directory_paths = get_scenario_paths_from_dir(directory);
+
+        for (size_t p = 0; p < array_size(&directory_paths); p++)
+            dynarray_add(&paths, string_t, rrr_array_ele(&directory_paths, sizeof(string_t), p));
+
+        array_free(&directory_paths);
+        free(directory);
+    }
+
+    *out_paths = dynarray_to_array(&paths, string_t);
+
+    return true;
+}
+
+static void headless_free_scenario(scenario_t* scenario)
+{
+    if(scenario->scenario_mode == SCENARIO_MODE_CHALLENGE)
+        array_free(&scenario->challenge_moves);
+}
+
+static void headless_print_usage()
+{
+    fputs("Commands:\n"
+        "    validate <scenario file, library or directory>...\n"
+        "    perft <scenario file> <depth>\n"
+        "    selfplay <scenario file> [depth] [max turns]\n"
+        "    replay <scenario file> <match file>\n", stderr);
+}
+
+static void headless_print_board(const ruleset_t* rules, const board_t* board)
+{
+    const board_geometry_t* geometry = board_geometry_of(rules);
+    char cells [MAX_BOARD_SIDE_DIMENSION][MAX_BOARD_SIDE_DIMENSION + 1];
+
+    for (board_unit_t y = 0; y < rules->board_side_size; y++)
+    {
+        memset(cells[y], ' ', rules->board_side_size);
+        cells[y][rules->board_side_size] = '\0';
+    }
+
+    for (cell_id_t cid = 0; cid < geometry->playable_cell_count; cid++)
+    {
+        board_position_t position = geometry->cell_positions[cid];
+        char symbol = '.';
+
+        switch (board->playable_cells[cid])
+        {
+            case PIECE_WHITE_PEON:
+                symbol = 'w';
+                break;
+            case PIECE_BLACK_PEON:
+                symbol = 'b';
+                break;
+            case PIECE_WHITE_QUEEN:
+                symbol = 'W';
+                break;
+            case PIECE_BLACK_QUEEN:
+                symbol = 'B';
+                break;
+            default:
+                break;
+        }
+
+        cells[position.y][position.x] = symbol;
+    }
+
+    for (board_unit_t y = 0; y < rules->board_side_size; y++)
+        printf("    %s\n", cells[y]);
+}
+
+static void headless_print_legal_moves(const legal_move_list_t* move_list)
+{
+    char notation [LEGAL_MOVE_NOTATION_SIZE];
+
+    for (size_t i = 0; i < move_list->move_count; i++)
+    {
+        legal_move_to_notation(&move_list->moves[i], notation, LEGAL_MOVE_NOTATION_SIZE);
+        printf(" %s", notation);
+    }
+
+    printf("\n");
+}
+
+static const char* headless_team_name(team_t team)
+{
+    return team == WHITE_TEAM ? "white" : "black";
+}
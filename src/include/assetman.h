@@ -18,14 +18,34 @@ typedef struct
     void* asset_data;
 } asset_info_t;
 
+/* Interned id, the lowest bit tells the dynamic table from the static one */
+typedef uint32_t asset_handle_t;
+
+#define ASSETMAN_INVALID_HANDLE ((asset_handle_t)0)
+
 typedef void (*free_asset_function)(asset_info_t*);
 
 bool assetman_init(free_asset_function custom_free_asset_function);
 
-void assetman_set_asset(bool is_id_safe, const char* id, asset_type_t asset_type, void* asset_data);
+/**
+* Sets the asset of an id, ids which are not safe are copied.
+*
+* \returns the handle of the id.
+*/
+asset_handle_t assetman_set_asset(bool is_id_safe, const char* id, asset_type_t asset_type, void* asset_data);
 
 void* assetman_get_asset(const char* id);
 
+/**
+* Resolves an id once so later lookups are an array index. Ids are never removed from their table, so a handle
+* stays valid until assetman_finish, its asset is NULL while nothing is set for the id.
+*
+* \returns the handle of the id, interning the id if it was never set.
+*/
+asset_handle_t assetman_get_handle(bool is_id_safe, const char* id);
+
+void* assetman_get_asset_by_handle(asset_handle_t handle);
+
 bool assetman_free_static_assets();
 
 bool assetman_free_dynamic_assets();
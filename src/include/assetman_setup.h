@@ -12,6 +12,20 @@ enum
     TEXTURE_ASSET_TYPE
 };
 
+#define PIECE_ATLAS_PADDING 2
+
+typedef struct
+{
+    asset_handle_t texture_handle;
+    /* Normalized texture coordinates, indexed by piece value + 2 since cell values go from -2 to 2 */
+    SDL_FRect source_rects [5];
+} piece_atlas_t;
+
+#define piece_atlas_source_rect(PIECE) (piece_atlas.source_rects[(PIECE) + 2])
+
+/* All four piece images packed in one texture so the pieces of a board are drawn in one call */
+extern piece_atlas_t piece_atlas;
+
 void setup_initial_assets(SDL_Renderer* renderer);
 
 void checkers_free_asset_function(asset_info_t* asset);
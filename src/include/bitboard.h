@@ -0,0 +1,163 @@
+#ifndef BITBOARD_HEADER
+#define BITBOARD_HEADER
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "board.h"
+
+/*
+ * Bit N of a bitboard represents the playable cell with id N, so the cell ids used by board_t
+ * can be used directly as bit indices. The biggest board (12x12) has 72 playable cells, which
+ * requires two 64-bit words, smaller boards only ever touch the first word.
+ */
+#define BITBOARD_WORD_COUNT 2
+#define BITBOARD_WORD_BITS 64
+
+typedef struct
+{
+    uint64_t words [BITBOARD_WORD_COUNT];
+} bitboard_t;
+
+typedef struct
+{
+    bitboard_t white;
+    bitboard_t black;
+    bitboard_t queens;
+} bitboard_position_t;
+
+/*
+ * Masks and shift amounts that allow a whole bitboard to be moved one cell along a diagonal.
+ * Since the cell ids of consecutive lines are not aligned, the amount of the shift depends on
+ * whether the line starts with a playable cell (x = 0) or not (x = 1).
+ */
+typedef struct
+{
+    board_unit_t board_side_size;
+    cell_id_t playable_cell_count;
+    cell_id_t playable_cell_count_per_line;
+
+    bitboard_t board_mask;
+    bitboard_t shifted_lines_mask;
+    bitboard_t direction_source_masks [4];
+
+    int16_t direction_shifts [4][2];
+} bitboard_layout_t;
+
+static inline bitboard_t bitboard_empty()
+{
+    return (bitboard_t){0};
+}
+
+static inline bitboard_t bitboard_from_cell(cell_id_t cell)
+{
+    bitboard_t bitboard = {0};
+    bitboard.words[cell / BITBOARD_WORD_BITS] = (uint64_t)1 << (cell % BITBOARD_WORD_BITS);
+    return bitboard;
+}
+
+static inline bool bitboard_is_empty(bitboard_t bitboard)
+{
+    return (bitboard.words[0] | bitboard.words[1]) == 0;
+}
+
+static inline bool bitboard_contains(bitboard_t bitboard, cell_id_t cell)
+{
+    return (bitboard.words[cell / BITBOARD_WORD_BITS] >> (cell % BITBOARD_WORD_BITS)) & 1;
+}
+
+static inline void bitboard_set(bitboard_t* bitboard, cell_id_t cell)
+{
+    bitboard->words[cell / BITBOARD_WORD_BITS] |= (uint64_t)1 << (cell % BITBOARD_WORD_BITS);
+}
+
+static inline void bitboard_clear(bitboard_t* bitboard, cell_id_t cell)
+{
+    bitboard->words[cell / BITBOARD_WORD_BITS] &= ~((uint64_t)1 << (cell % BITBOARD_WORD_BITS));
+}
+
+static inline bitboard_t bitboard_and(bitboard_t a, bitboard_t b)
+{
+    return (bitboard_t){{ a.words[0] & b.words[0], a.words[1] & b.words[1] }};
+}
+
+static inline bitboard_t bitboard_or(bitboard_t a, bitboard_t b)
+{
+    return (bitboard_t){{ a.words[0] | b.words[0], a.words[1] | b.words[1] }};
+}
+
+static inline bitboard_t bitboard_and_not(bitboard_t a, bitboard_t b)
+{
+    return (bitboard_t){{ a.words[0] & ~b.words[0], a.words[1] & ~b.words[1] }};
+}
+
+/* Shifts towards higher cell ids when amount is positive and towards lower cell ids when it is negative. */
+static inline bitboard_t bitboard_shift(bitboard_t bitboard, int16_t amount)
+{
+    if(amount > 0)
+    {
+        return (bitboard_t){{ bitboard.words[0] << amount, (bitboard.words[1] << amount) | (bitboard.words[0] >> (BITBOARD_WORD_BITS - amount)) }};
+    }
+
+    if(amount < 0)
+    {
+        amount = -amount;
+        return (bitboard_t){{ (bitboard.words[0] >> amount) | (bitboard.words[1] << (BITBOARD_WORD_BITS - amount)), bitboard.words[1] >> amount }};
+    }
+
+    return bitboard;
+}
+
+static inline cell_id_t bitboard_count(bitboard_t bitboard)
+{
+    return (cell_id_t)(__builtin_popcountll(bitboard.words[0]) + __builtin_popcountll(bitboard.words[1]));
+}
+
+/* Removes the lowest cell of a non empty bitboard and returns its id. */
+static inline cell_id_t bitboard_pop_first_cell(bitboard_t* bitboard)
+{
+    if(bitboard->words[0] != 0)
+    {
+        cell_id_t cell = (cell_id_t)__builtin_ctzll(bitboard->words[0]);
+        bitboard->words[0] &= bitboard->words[0] - 1;
+        return cell;
+    }
+
+    cell_id_t cell = (cell_id_t)(BITBOARD_WORD_BITS + __builtin_ctzll(bitboard->words[1]));
+    bitboard->words[1] &= bitboard->words[1] - 1;
+    return cell;
+}
+
+void bitboard_layout_init(bitboard_layout_t* layout, board_unit_t board_side_size, bool double_corner_on_right);
+
+/**
+* Moves every cell of the bitboard one cell in the given direction (index of movement_directions), cells that would leave the board are dropped.
+*/
+bitboard_t bitboard_shift_towards(const bitboard_layout_t* layout, bitboard_t cells, uint8_t direction);
+
+/**
+* \returns the id of the cell next to the given cell in the given direction, or NO_CELL if it would be outside of the board.
+*/
+cell_id_t bitboard_layout_neighbor(const bitboard_layout_t* layout, cell_id_t cell, uint8_t direction);
+
+bitboard_position_t bitboard_position_from_board(const board_t* board, cell_id_t playable_cell_count);
+
+void bitboard_position_to_board(const bitboard_position_t* position, board_t* board, cell_id_t playable_cell_count);
+
+void bitboard_position_apply_move(bitboard_position_t* position, move_info_t move);
+
+bitboard_t bitboard_position_team(const bitboard_position_t* position, team_t team);
+
+bitboard_t bitboard_position_empty(const bitboard_layout_t* layout, const bitboard_position_t* position);
+
+/**
+* \returns the pieces of the given team that can jump over an opponent piece in the given direction and land on an empty cell.
+*/
+bitboard_t bitboard_position_capturers(const bitboard_layout_t* layout, const bitboard_position_t* position, team_t team, uint8_t direction);
+
+/**
+* \returns the pieces of the given team that have an empty cell next to them in the given direction.
+*/
+bitboard_t bitboard_position_quiet_movers(const bitboard_layout_t* layout, const bitboard_position_t* position, team_t team, uint8_t direction);
+
+#endif
@@ -6,13 +6,21 @@
 
 #define DTS_USE_ARRAY
 #define DTS_USE_DYNARRAY
-#define DTS_USE_TREE
+#define DTS_USE_FLAT_TREE
 
 #include "dtstructs.h"
 
 #define MAX_BOARD_SIDE_DIMENSION 12
 #define MAX_BOARD_PLAYABLE_CELL_COUNT ((MAX_BOARD_SIDE_DIMENSION*MAX_BOARD_SIDE_DIMENSION)/2) 
 
+#define NO_CELL ((cell_id_t)0xFFFF)
+
+#define MAX_CAPTURE_SEQUENCE_LENGTH (MAX_BOARD_PLAYABLE_CELL_COUNT / 2)
+#define LEGAL_MOVE_LIST_CAPACITY 256
+
+/* Longest notation of a move: the number of every visited cell and a separator before each */
+#define LEGAL_MOVE_NOTATION_SIZE (4 * (MAX_CAPTURE_SEQUENCE_LENGTH + 1))
+
 #define NO_TEAM 0
 #define WHITE_TEAM 1
 #define BLACK_TEAM 2
@@ -24,11 +32,16 @@
 #define piece_is_black(PIECE_TYPE) (PIECE_TYPE == PIECE_BLACK_PEON || PIECE_TYPE == PIECE_BLACK_QUEEN)
 #define piece_same_team(PIECE_TYPE_1, PIECE_TYPE_2) (PIECE_TYPE_1 == PIECE_TYPE_2 || PIECE_TYPE_1 == (-PIECE_TYPE_2))
 
+/* Directions are indices of movement_directions, which is ordered so that opposite directions add up to 3 */
+#define direction_opposite(DIRECTION) ((uint8_t)(3 - (DIRECTION)))
+#define direction_from_vector(VECTOR) ((uint8_t)(((VECTOR).x < 0) + 2 * ((VECTOR).y < 0)))
+
 typedef uint8_t  board_unit_t;
 typedef int16_t  board_coordinate_t; 
 typedef uint16_t cell_id_t;
 typedef int8_t   cell_value_t;
 typedef int8_t   team_t;
+typedef uint64_t zobrist_key_t;
 
 enum
 {
@@ -62,18 +75,133 @@ typedef struct
 typedef struct 
 {
     cell_value_t playable_cells [MAX_BOARD_PLAYABLE_CELL_COUNT];
+
+    /* Zobrist hash of the pieces, kept up to date by the functions that change cells */
+    zobrist_key_t hash;
 } board_t;
 
+/* Everything the rules engine needs to know about the variant being played */
+typedef struct
+{
+    board_unit_t board_side_size;
+    bool double_corner_on_right;
+
+    bool applies_law_of_quantity;
+    bool applies_law_of_quality;
+
+    bool peons_capture_backwards;
+    bool flying_kings;
+    bool is_white_peon_forward_top_to_bottom;
+} ruleset_t;
+
+/* A whole turn: either a single quiet move or every step of a capture sequence */
+typedef struct
+{
+    cell_id_t source_cell;
+    uint8_t capture_count;
+
+    /* Landing cell of each step, a quiet move only has one step */
+    cell_id_t destination_cells [MAX_CAPTURE_SEQUENCE_LENGTH];
+    cell_id_t capture_cells [MAX_CAPTURE_SEQUENCE_LENGTH];
+} legal_move_t;
+
+typedef struct
+{
+    size_t move_count;
+
+    /* Set when moves past LEGAL_MOVE_LIST_CAPACITY were dropped, or a capture sequence was cut at MAX_CAPTURE_SEQUENCE_LENGTH */
+    bool is_truncated;
+
+    legal_move_t moves [LEGAL_MOVE_LIST_CAPACITY];
+} legal_move_list_t;
+
+extern board_position_t movement_directions [4];
+
 team_t piece_team(cell_value_t piece_type);
 
-board_position_t cell_id_to_cell_position(cell_id_t cell_id);
+/**
+* \returns every field of the ruleset packed in a single value, two rulesets have the same key only if they are equal.
+*/
+uint16_t ruleset_key(const ruleset_t* rules);
 
-cell_id_t cell_position_to_cell_id(board_position_t cell_position);
+board_position_t cell_id_to_cell_position(const ruleset_t* rules, cell_id_t cell_id);
 
-void board_apply_move(board_t* board, move_info_t move);
+cell_id_t cell_position_to_cell_id(const ruleset_t* rules, board_position_t cell_position);
 
-tree_t board_generate_capture_tree(board_t* initial_board);
+void board_apply_move(board_t* board, move_info_t move);
 
-bool board_contains_any_valid_moves_for_team(board_t* board, team_t playing_team);
+/**
+* Places a piece (or NO_PIECE) on a cell, writes to the cells must go through here so the hash stays valid.
+*/
+void board_set_cell(board_t* board, cell_id_t cell, cell_value_t piece_type);
+
+/**
+* Removes every piece of the board.
+*/
+void board_clear(board_t* board);
+
+/**
+* Hashes the board from scratch, board->hash must always be equal to it.
+*/
+zobrist_key_t board_compute_hash(const board_t* board);
+
+/**
+* \returns the hash of the position formed by the board and the team to play.
+*/
+zobrist_key_t board_position_hash(const board_t* board, team_t playing_team);
+
+/**
+* \returns true if a peon of the given team that reaches the cell becomes a queen.
+*/
+bool board_is_crowning_cell_of_team(const ruleset_t* rules, team_t team, cell_id_t cell);
+
+/**
+* Promotes the piece on the cell to a queen if it is a peon standing on a crowning cell of its team.
+*
+* \returns true if the piece was promoted.
+*/
+bool board_promote_to_queen_if_valid(const ruleset_t* rules, board_t* board, cell_id_t piece_cell);
+
+/**
+* Generates every capture sequence available to the playing team, the laws of quantity and quality are already applied when the ruleset requires them.
+*
+* The sequences are added under the root of capture_tree, which must be empty (just created or cleared with ftree_clear).
+* Every path from the root to a node without children is an allowed capture sequence.
+*/
+void board_generate_capture_tree(const ruleset_t* rules, const board_t* initial_board, team_t playing_team, ftree_t* capture_tree);
+
+/**
+* Fills move_list with every move the playing team is allowed to make: the capture sequences left by the laws when a capture
+* is available, the quiet moves otherwise. Nothing is allocated, so move_list can live on the stack.
+*/
+void board_generate_legal_moves(const ruleset_t* rules, const board_t* board, team_t playing_team, legal_move_list_t* move_list);
+
+size_t legal_move_step_count(const legal_move_t* move);
+
+move_info_t legal_move_get_step(const legal_move_t* move, size_t step_index);
+
+cell_id_t legal_move_final_cell(const legal_move_t* move);
+
+/**
+* Writes the move in draughts notation: the visited cells numbered from 1, joined by '-' for a quiet move and by 'x' for a capture.
+*/
+void legal_move_to_notation(const legal_move_t* move, char* out_notation, size_t notation_size);
+
+/**
+* \returns the move of the list written as the notation, NULL if there is none.
+*/
+const legal_move_t* legal_move_list_find_notation(const legal_move_list_t* move_list, const char* notation);
+
+/**
+* \returns the move of the list made of exactly the given steps, NULL if there is none.
+*/
+const legal_move_t* legal_move_list_find_steps(const legal_move_list_t* move_list, const move_info_t* steps, size_t step_count);
+
+/**
+* Applies every step of the move and promotes the moved piece if it ended its turn on a crowning cell.
+*/
+void board_play_legal_move(const ruleset_t* rules, board_t* board, const legal_move_t* move);
+
+bool board_contains_any_valid_moves_for_team(const ruleset_t* rules, const board_t* board, team_t playing_team);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef CAPTURE_TREE_CACHE_HEADER
+#define CAPTURE_TREE_CACHE_HEADER
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "board.h"
+
+#define CAPTURE_TREE_CACHE_CAPACITY 32
+#define CAPTURE_TREE_INITIAL_NODE_COUNT 256
+
+typedef struct
+{
+    bool is_used;
+    uint64_t last_use;
+
+    zobrist_key_t position_hash;
+    uint16_t rules_key;
+    team_t playing_team;
+
+    /* Kept to tell apart the positions whose hashes collide */
+    board_t board;
+
+    ftree(move_info_t) capture_tree;
+} capture_tree_cache_entry_t;
+
+/*
+ * Least recently used cache of the capture trees generated by board_generate_capture_tree, so going
+ * back to a position (undo, replay, analysis) does not regenerate its tree. Trees of evicted entries
+ * are cleared and reused, the cache only allocates while it fills up.
+ */
+typedef struct
+{
+    uint64_t use_counter;
+    size_t hit_count;
+    size_t miss_count;
+
+    capture_tree_cache_entry_t entries [CAPTURE_TREE_CACHE_CAPACITY];
+} capture_tree_cache_t;
+
+void capture_tree_cache_init(capture_tree_cache_t* cache);
+
+void capture_tree_cache_free(capture_tree_cache_t* cache);
+
+/**
+* Gets the capture tree of the position, generating it if the position is not cached.
+*
+* \returns the tree, which stays valid until the next call on the same cache.
+*/
+const ftree_t* capture_tree_cache_get(capture_tree_cache_t* cache, const ruleset_t* rules, const board_t* board, team_t playing_team);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef COMPUTER_PLAYER_HEADER
+#define COMPUTER_PLAYER_HEADER
+
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "board.h"
+#include "search.h"
+#include "SDL2/SDL.h"
+
+#define COMPUTER_PLAYER_TIME_BUDGET_SECONDS 1.0
+
+/*
+ * Runs the searcher on a worker thread so the frame loop never waits for it, the game starts a
+ * search on the computer's turn and polls it every frame until the move is ready.
+ */
+typedef struct
+{
+    searcher_t searcher;
+
+    SDL_Thread* thread;
+    SDL_atomic_t is_search_done;
+    atomic_bool stop_requested;
+
+    /* Copies of the searched position, the game keeps changing its own */
+    board_t board;
+    team_t team;
+
+    search_result_t result;
+    bool is_searching;
+} computer_player_t;
+
+void computer_player_init(computer_player_t* player, const ruleset_t* rules);
+
+/**
+* Stops the running search, if any, and releases the searcher.
+*/
+void computer_player_free(computer_player_t* player);
+
+void computer_player_start_search(computer_player_t* player, const board_t* board, team_t team);
+
+/**
+* \returns true once the search started by computer_player_start_search is over and found a move, which is copied to out_move.
+*/
+bool computer_player_poll_move(computer_player_t* player, legal_move_t* out_move);
+
+#endif
@@ -424,6 +424,194 @@ DTSDEF tree_t rrr_tree_insert(tree_t tree, size_t data_size, void* data)
 
 #endif
 
+#if !defined(DTS_LIB_FLAT_TREE_DEFS) && defined(DTS_USE_FLAT_TREE)
+#define DTS_LIB_FLAT_TREE_DEFS
+
+/*
+ * Tree whose nodes live in a single block of memory and refer to each other by index.
+ * Nodes are bump allocated, so building a tree does not allocate once the block is big enough,
+ * and clearing it only resets the node count, the memory is kept for the next tree.
+ */
+
+typedef size_t ftnode_id_t;
+
+typedef struct FLAT_TREE_NODE_STRUCT
+{
+    ftnode_id_t first_child;
+    ftnode_id_t last_child;
+    ftnode_id_t next_sibling;
+    size_t child_count;
+} ftnode_t;
+
+typedef struct FLAT_TREE_STRUCT
+{
+    size_t data_size;
+    size_t node_count;
+    size_t allocated_node_count;
+    ftnode_t* nodes;
+    char* data;
+} ftree_t;
+
+#define FTREE_NO_NODE ((ftnode_id_t)-1)
+#define FTREE_ROOT ((ftnode_id_t)0)
+#define FTREE_DEFAULT_NODE_COUNT 64
+
+#define ftree(TYPE) ftree_t
+
+// FLAT TREE: Main Functions
+
+#define ftree_new(TYPE, NODE_COUNT) rrr_ftree_new(sizeof(TYPE), NODE_COUNT)
+
+#define ftree_add_node(TREE, TYPE, DATA) rrr_ftree_add_node(TREE, DATA)
+
+#define ftree_insert(TREE, TYPE, PARENT, DATA) rrr_ftree_insert(TREE, PARENT, DATA)
+
+#define ftree_value(TREE, TYPE, NODE) (*(TYPE*)rrr_ftree_value(TREE, NODE))
+
+DTSDEF void ftree_free(ftree_t* tree)
+{
+    free(tree->nodes);
+    free(tree->data);
+    tree->nodes = NULL;
+    tree->data = NULL;
+    tree->node_count = 0;
+    tree->allocated_node_count = 0;
+}
+
+/* Removes every node but the root, without releasing memory. */
+DTSDEF void ftree_clear(ftree_t* tree)
+{
+    tree->node_count = 1;
+    tree->nodes[FTREE_ROOT].first_child = FTREE_NO_NODE;
+    tree->nodes[FTREE_ROOT].last_child = FTREE_NO_NODE;
+    tree->nodes[FTREE_ROOT].next_sibling = FTREE_NO_NODE;
+    tree->nodes[FTREE_ROOT].child_count = 0;
+}
+
+DTSDEF size_t ftree_size(ftree_t* tree)
+{
+    return tree->node_count;
+}
+
+DTSDEF size_t ftree_child_count(const ftree_t* tree, ftnode_id_t node)
+{
+    return tree->nodes[node].child_count;
+}
+
+DTSDEF ftnode_id_t ftree_first_child(const ftree_t* tree, ftnode_id_t node)
+{
+    return tree->nodes[node].first_child;
+}
+
+DTSDEF ftnode_id_t ftree_next_sibling(const ftree_t* tree, ftnode_id_t node)
+{
+    return tree->nodes[node].next_sibling;
+}
+
+/* Makes a node that was added with ftree_add_node the last child of parent. */
+DTSDEF void ftree_attach(ftree_t* tree, ftnode_id_t parent, ftnode_id_t child)
+{
+    ftnode_t* parent_node = &tree->nodes[parent];
+
+    tree->nodes[child].next_sibling = FTREE_NO_NODE;
+
+    if(parent_node->child_count == 0)
+        parent_node->first_child = child;
+    else
+        tree->nodes[parent_node->last_child].next_sibling = child;
+
+    parent_node->last_child = child;
+    parent_node->child_count++;
+}
+
+/* Unlinks every child of the node, their memory is only reclaimed when the tree is cleared or rolled back. */
+DTSDEF void ftree_detach_children(ftree_t* tree, ftnode_id_t node)
+{
+    tree->nodes[node].first_child = FTREE_NO_NODE;
+    tree->nodes[node].last_child = FTREE_NO_NODE;
+    tree->nodes[node].child_count = 0;
+}
+
+/*
+ * Frees the given node and every node added after it. Since nodes are bump allocated, a subtree
+ * that was just built sits at the end of the tree, so it can be discarded this way as long as it
+ * is not attached to a node that is kept.
+ */
+DTSDEF void ftree_rollback(ftree_t* tree, ftnode_id_t first_discarded_node)
+{
+    #ifdef DTS_DEBUG_CHECKS
+    if(first_discarded_node == FTREE_ROOT || first_discarded_node > tree->node_count)
+    {
+        fputs("Attempting to roll back a flat tree to an invalid node!\n", stdout);
+        printf("More Info:\n\t(node count: %"PRIu64", node: %"PRIu64")\n", tree->node_count, first_discarded_node);
+        exit(1);
+    }
+    #endif
+
+    tree->node_count = first_discarded_node;
+}
+
+// FLAT TREE: Backing Functions
+
+DTSDEF ftree_t rrr_ftree_new(size_t data_size, size_t node_count)
+{
+    ftree_t tree;
+
+    tree.data_size = data_size;
+    tree.allocated_node_count = node_count != 0 ? node_count : FTREE_DEFAULT_NODE_COUNT;
+    tree.nodes = malloc(sizeof(ftnode_t) * tree.allocated_node_count);
+    tree.data = malloc(data_size * tree.allocated_node_count);
+
+    ftree_clear(&tree);
+
+    return tree;
+}
+
+DTSDEF void* rrr_ftree_value(const ftree_t* tree, ftnode_id_t node)
+{
+    #ifdef DTS_DEBUG_CHECKS
+    if(tree->node_count <= node)
+    {
+        fputs("Attempting to access an out of bounds node from a flat tree!\n", stdout);
+        printf("More Info:\n\t(node count: %"PRIu64", node: %"PRIu64")\n", tree->node_count, node);
+        exit(1);
+    }
+    #endif
+
+    return &tree->data[node * tree->data_size];
+}
+
+DTSDEF ftnode_id_t rrr_ftree_add_node(ftree_t* tree, void* data)
+{
+    if(tree->allocated_node_count <= tree->node_count)
+    {
+        tree->allocated_node_count *= 2;
+        tree->nodes = realloc(tree->nodes, sizeof(ftnode_t) * tree->allocated_node_count);
+        tree->data = realloc(tree->data, tree->data_size * tree->allocated_node_count);
+    }
+
+    ftnode_id_t node = tree->node_count;
+    tree->node_count++;
+
+    tree->nodes[node].first_child = FTREE_NO_NODE;
+    tree->nodes[node].last_child = FTREE_NO_NODE;
+    tree->nodes[node].next_sibling = FTREE_NO_NODE;
+    tree->nodes[node].child_count = 0;
+
+    if(data != NULL) memcpy(&tree->data[node * tree->data_size], data, tree->data_size);
+
+    return node;
+}
+
+DTSDEF ftnode_id_t rrr_ftree_insert(ftree_t* tree, ftnode_id_t parent, void* data)
+{
+    ftnode_id_t node = rrr_ftree_add_node(tree, data);
+    ftree_attach(tree, parent, node);
+    return node;
+}
+
+#endif
+
 #if !defined(DTS_LIB_CAST_ARRAY_DYNARRAY_DEFS) && defined(DTS_USE_DYNARRAY) && defined(DTS_USE_ARRAY)
 #define DTS_LIB_CAST_ARRAY_DYNARRAY_DEFS
 
@@ -0,0 +1,27 @@
+#ifndef FILE_MAPPING_HEADER
+#define FILE_MAPPING_HEADER
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Read only view of a whole file, pages are only read from the disk when they are touched */
+typedef struct
+{
+    const void* data;
+    size_t size;
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#endif
+} file_mapping_t;
+
+/**
+* Maps the file in memory, empty files cannot be mapped.
+*
+* \returns true on success, the mapping must then be released with file_mapping_close.
+*/
+bool file_mapping_open(file_mapping_t* mapping, const char* path);
+
+void file_mapping_close(file_mapping_t* mapping);
+
+#endif
@@ -6,7 +6,11 @@
 
 #include "sui.h"
 #include "board.h"
+#include "scenario.h"
+#include "capture_tree_cache.h"
+#include "computer_player.h"
 #include "pager.h"
+#include "thumbnail_loader.h"
 #include "strplus.h"
 #include "logger.h"
 #include "SDL2/SDL.h"
@@ -17,6 +21,7 @@
 #define DTS_USE_ARRAY
 #define DTS_USE_DYNARRAY
 #define DTS_USE_TREE
+#define DTS_USE_FLAT_TREE
 
 #include "dtstructs.h"
 
@@ -53,16 +58,16 @@
 #define BOARD_SECTION_HEIGHT SCREEN_HEIGHT
 #define UI_SECTION_WIDTH ((SCREEN_WIDTH - SCREEN_HEIGHT)/3)
 
-#define CELL_WIDTH            (BOARD_SECTION_WIDTH / game.scenario_data.board_side_size)
-#define CELL_HEIGHT           (BOARD_SECTION_HEIGHT / game.scenario_data.board_side_size)
-#define PIECE_WIDTH           (2 * BOARD_SECTION_WIDTH / game.scenario_data.board_side_size / 3)
-#define PIECE_HEIGHT          (2 * BOARD_SECTION_HEIGHT / game.scenario_data.board_side_size / 3)
+#define CELL_WIDTH            (BOARD_SECTION_WIDTH / game.scenario_data.rules.board_side_size)
+#define CELL_HEIGHT           (BOARD_SECTION_HEIGHT / game.scenario_data.rules.board_side_size)
+#define PIECE_WIDTH           (2 * BOARD_SECTION_WIDTH / game.scenario_data.rules.board_side_size / 3)
+#define PIECE_HEIGHT          (2 * BOARD_SECTION_HEIGHT / game.scenario_data.rules.board_side_size / 3)
 
 #define PIECE_PIXEL_OFFSET_X  ((CELL_WIDTH - PIECE_WIDTH)/2)
 #define PIECE_PIXEL_OFFSET_Y  ((CELL_HEIGHT - PIECE_HEIGHT)/2)
-#define CELL_COUNT                    (game.scenario_data.board_side_size * game.scenario_data.board_side_size)
+#define CELL_COUNT                    (game.scenario_data.rules.board_side_size * game.scenario_data.rules.board_side_size)
 #define PLAYABLE_CELL_COUNT           (CELL_COUNT / 2)
-#define PLAYABLE_CELL_COUNT_PER_LINE  (game.scenario_data.board_side_size / 2)
+#define PLAYABLE_CELL_COUNT_PER_LINE  (game.scenario_data.rules.board_side_size / 2)
 
 #define LOG_FILE_PATH "log/log.txt"
 
@@ -71,6 +76,9 @@
 #define TEXT_INPUT_FIELD_MAX_LENGTH 14
 #define TEXT_INPUT_FIELD_SIZE (TEXT_INPUT_FIELD_MAX_LENGTH+1)
 
+#define SELECTOR_ITEMS_PER_PAGE 8
+#define EDITOR_SECTION_COUNT 3
+
 enum
 {
     MODE_MENU,
@@ -79,12 +87,6 @@ enum
     MODE_SCENARIO
 };
 
-enum
-{
-    SCENARIO_MODE_1V1,
-    SCENARIO_MODE_CHALLENGE
-};
-
 typedef enum
 {
     GAME_INPUT_NONE,
@@ -105,31 +107,16 @@ typedef struct
     };
 } game_input_t;
 
-typedef struct
-{
-    board_unit_t board_side_size;
-
-    board_t board;
-    team_t team;
-    uint8_t scenario_mode;
-
-    array(move_info_t) challenge_moves;
-
-    bool double_corner_on_right;
-
-    bool applies_law_of_quantity;
-    bool applies_law_of_quality;
-
-    bool peons_capture_backwards;
-    bool flying_kings;
-    bool is_white_peon_forward_top_to_bottom;
-} scenario_t;
-
 typedef struct
 {
     array(string_t) file_paths;
+    scenario_header_t* headers;
+    thumbnail_loader_t thumbnails;
     pager_t pager;
     bool is_standard_section;
+
+    /* Icon element of each item of the current page, updated in place when its thumbnail arrives */
+    sui_texture_t* icon_elements [SELECTOR_ITEMS_PER_PAGE];
 } game_selector_t;
 
 typedef struct
@@ -141,6 +128,17 @@ typedef struct
     SDL_Window* window;
     SDL_Renderer* renderer;
 
+    /* Checker pattern of the board, only depends on its size and on the side of the double corner */
+    SDL_Texture* board_background;
+
+    /* Elements of the menu, built on the first visit and activated again on the next ones */
+    sui_element_set_t menu_elements;
+    bool is_menu_cached;
+
+    /* Elements of each editor section and of the selector page, rebuilt on each visit into the chunks of the last one */
+    sui_element_set_t editor_section_elements [EDITOR_SECTION_COUNT];
+    sui_element_set_t selector_elements;
+
     char text_input_field [TEXT_INPUT_FIELD_SIZE];
     game_input_t input;
 
@@ -161,8 +159,11 @@ typedef struct
 
             cell_value_t piece_type_to_place;
 
-            tree_t capture_tree;
-            tree(move_info_t) current_capture_subtree;
+            capture_tree_cache_t capture_tree_cache;
+            const ftree_t* capture_tree;
+            ftnode_id_t current_capture_subtree;
+
+            computer_player_t computer_player;
 
             size_t current_challenge_move_index;
 
@@ -190,6 +191,8 @@ typedef struct
     float delta_time;
 
     bool is_playing;
+    bool needs_redraw;
+    bool is_profiler_overlay_visible;
     bool is_text_input_field_active;
     uint8_t mode;
 } game_t;
@@ -205,18 +208,28 @@ void game_update_editor();
 
 void game_set_mode_menu(void* event_data);
 void game_set_mode_selector(void* event_data);
+void selector_update_thumbnails();
 void game_set_mode_scenario(void* event_data);
 void game_set_mode_editor(void* event_data);
 void game_1v1_scenario_set_capture_data();
 
+/* Board, selection and hover changes call this so the next frame gets drawn */
+void game_invalidate();
+
+/**
+* Tells whether the current mode has work to do without any input, like an automated move or a loading
+* thumbnail, in which case the main loop keeps polling instead of waiting for events.
+*
+* \returns true if the game must keep updating.
+*/
+bool game_is_animating();
+
 void game_free_dependencies();
 void game_quit(void* event_data);
 
 void game_check_for_and_activate_victory();
 void game_activate_game_over_panel(char* text_message);
 
-void scenario_set_default(scenario_t* scenario);
-
 void game_text_input_field_start();
 void game_text_input_field_stop();
 void game_text_input_field_receive(string_t);
@@ -0,0 +1,54 @@
+#ifndef GEOMETRY_HEADER
+#define GEOMETRY_HEADER
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "board.h"
+#include "bitboard.h"
+
+#define MAX_RAY_LENGTH (MAX_BOARD_SIDE_DIMENSION - 1)
+
+/*
+ * Everything move generation needs to know about the shape of a board, precomputed once per
+ * board size and double corner side so the hot paths only do table lookups.
+ */
+typedef struct
+{
+    board_unit_t board_side_size;
+    bool double_corner_on_right;
+
+    cell_id_t playable_cell_count;
+    cell_id_t playable_cell_count_per_line;
+
+    board_position_t cell_positions [MAX_BOARD_PLAYABLE_CELL_COUNT];
+
+    /* Indexed by cell and direction (index of movement_directions), NO_CELL when outside of the board */
+    cell_id_t neighbors [MAX_BOARD_PLAYABLE_CELL_COUNT][4];
+    cell_id_t jump_landings [MAX_BOARD_PLAYABLE_CELL_COUNT][4];
+
+    /* Every cell of the diagonal starting next to the cell, ordered by distance */
+    cell_id_t rays [MAX_BOARD_PLAYABLE_CELL_COUNT][4][MAX_RAY_LENGTH];
+    uint8_t ray_lengths [MAX_BOARD_PLAYABLE_CELL_COUNT][4];
+
+    bitboard_t top_line;
+    bitboard_t bottom_line;
+
+    bitboard_layout_t bitboard_layout;
+} board_geometry_t;
+
+/**
+* Gets the geometry table of the given board. The tables of every supported size are built together by the first
+* call, whichever thread makes it, and are read-only afterwards.
+*
+* \returns a pointer to the table, or NULL if the board size is not supported.
+*/
+const board_geometry_t* board_geometry_get(board_unit_t board_side_size, bool double_corner_on_right);
+
+/**
+* Gets the geometry table of the board of the rules, for rules whose board size was checked when they were loaded.
+* Stops the program if the board size is not supported.
+*/
+const board_geometry_t* board_geometry_of(const ruleset_t* rules);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef HEADLESS_HEADER
+#define HEADLESS_HEADER
+
+#define HEADLESS_SELFPLAY_DEFAULT_DEPTH 6
+#define HEADLESS_REPLAY_LINE_SIZE 1024
+#define HEADLESS_SCENARIO_NAME_SIZE 512
+
+/**
+* Runs a command of the batch mode, nothing here touches SDL so it works without a display.
+* argv[0] is the name of the command: validate, perft, selfplay or replay.
+*
+* \returns the exit status of the command.
+*/
+int headless_run(int argc, char** argv);
+
+#endif
@@ -5,8 +5,6 @@
 
 #include "game.h"
 
-#define IS_DIAGONAL(MOVEMENT_VECTOR) ((MOVEMENT_VECTOR).x == (MOVEMENT_VECTOR).y || (MOVEMENT_VECTOR).x == -(MOVEMENT_VECTOR).y)
-
 void select_hovered_piece();
 
 void move_selected_piece_to_hovered_cell();
@@ -17,6 +15,8 @@ void update_team_displayer();
 
 void challenge_auto_play();
 
+void computer_play_turn();
+
 void place_piece_on_hovered_cell();
 
 #endif
\ No newline at end of file
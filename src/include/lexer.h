@@ -19,6 +19,8 @@ void lexer_init(lexer_t* lexer, char* src);
 
 void lexer_restart(lexer_t* lexer);
 
+void lexer_skip_spaces(lexer_t* lexer);
+
 array(token_t) lexer_collect_tokens(lexer_t* lexer);
 
 token_t lexer_collect_next_token(lexer_t* lexer);
@@ -0,0 +1,62 @@
+#ifndef MATCH_HEADER
+#define MATCH_HEADER
+
+#include <stdint.h>
+
+#include "scenario.h"
+#include "search.h"
+
+#define DTS_USE_DYNARRAY
+
+#include "dtstructs.h"
+
+#define MATCH_DEFAULT_MAX_TURNS 200
+#define MATCH_REPETITION_LIMIT 3
+
+enum
+{
+    MATCH_RESULT_DRAW,
+    MATCH_RESULT_WHITE_WIN,
+    MATCH_RESULT_BLACK_WIN
+};
+
+/* An automated player, each one has its own searcher so the two sides never share what they learned */
+typedef struct
+{
+    searcher_t searcher;
+    search_limits_t limits;
+
+    /* Picks a legal move at random instead of searching */
+    bool plays_randomly;
+} match_player_t;
+
+typedef struct
+{
+    size_t max_turns;
+
+    /* Turns played at random at the start so games from the same position differ, drawn from the seed */
+    size_t random_opening_turns;
+    uint64_t random_seed;
+} match_settings_t;
+
+typedef struct
+{
+    uint8_t result;
+    dynarray(legal_move_t) moves;
+} match_t;
+
+void match_player_init(match_player_t* player, const ruleset_t* rules, search_limits_t limits, bool plays_randomly);
+
+void match_player_free(match_player_t* player);
+
+/**
+* Plays a game from the position of the scenario. The game is a draw when settings->max_turns turns were played
+* without a winner or when a position comes back MATCH_REPETITION_LIMIT times. The same settings always give the same game.
+*/
+void match_play(match_t* match, const scenario_t* scenario, match_player_t* white_player, match_player_t* black_player, const match_settings_t* settings);
+
+void match_free(match_t* match);
+
+const char* match_result_name(uint8_t result);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef PERFT_HEADER
+#define PERFT_HEADER
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "board.h"
+
+/**
+* Counts every sequence of turns of the given depth from the position, the moves of the last turn are counted without being played.
+*
+* \returns the number of sequences, *out_has_truncated_move_list is set if any position had more moves than a legal_move_list_t holds.
+*/
+uint64_t perft_count(const ruleset_t* rules, const board_t* board, team_t playing_team, unsigned depth, bool* out_has_truncated_move_list);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef PLATFORM_HEADER
+#define PLATFORM_HEADER
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* \returns the count of online processors, or fallback_count when the system cannot tell */
+size_t platform_processor_count(size_t fallback_count);
+
+/* Monotonic clock time in nanoseconds, only meaningful as a difference of two calls */
+uint64_t platform_now_nanoseconds();
+
+/* Monotonic clock time in seconds, only meaningful as a difference of two calls */
+double platform_now_seconds();
+
+#endif
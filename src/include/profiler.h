@@ -0,0 +1,83 @@
+/**
+ * PROFILER
+ *
+ * Define PURGE_PROFILER to compile every scope out.
+ *
+ * PROFILER_BEGIN and PROFILER_END time one of the scopes listed below, from any thread. Nothing is recorded before
+ * profiler_init, so the engine code shared with the batch tools only pays for a check of a flag. Every scope keeps
+ * its last PROFILER_SCOPE_HISTORY_SIZE durations for its percentiles, and the last PROFILER_TRACE_CAPACITY samples
+ * of all the scopes can be written as a Chrome trace (chrome://tracing, Perfetto).
+*/
+
+#ifndef PROFILER_HEADER
+#define PROFILER_HEADER
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define PROFILER_SCOPE_HISTORY_SIZE 256
+
+/* Must be a power of two */
+#define PROFILER_TRACE_CAPACITY 65536
+
+#ifndef PURGE_PROFILER
+#define PROFILER_BEGIN(SCOPE)   uint64_t SCOPE##_profiler_start = profiler_begin()
+#define PROFILER_END(SCOPE)     profiler_end(SCOPE, SCOPE##_profiler_start)
+#else
+#define PROFILER_BEGIN(SCOPE)
+#define PROFILER_END(SCOPE)
+#endif
+
+typedef enum
+{
+    PROFILER_SCOPE_FRAME,
+    PROFILER_SCOPE_UPDATE,
+    PROFILER_SCOPE_RENDER_FRAME,
+    PROFILER_SCOPE_SUI_DRAW,
+    PROFILER_SCOPE_CAPTURE_TREE,
+    PROFILER_SCOPE_SCENARIO_LOAD,
+    PROFILER_SCOPE_SCENARIO_INDEX,
+    PROFILER_SCOPE_THUMBNAIL_DECODE,
+    PROFILER_SCOPE_THUMBNAIL_UPLOAD,
+    PROFILER_SCOPE_COUNT
+} profiler_scope_t;
+
+typedef struct
+{
+    size_t sample_count;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} profiler_stats_t;
+
+/* Starts recording, the calling thread is named as the main thread in the trace */
+void profiler_init();
+
+/* Used by PROFILER_BEGIN, \returns 0 when the profiler is not recording */
+uint64_t profiler_begin();
+
+/* Used by PROFILER_END */
+void profiler_end(profiler_scope_t scope, uint64_t start_ns);
+
+const char* profiler_scope_name(profiler_scope_t scope);
+
+/* Percentiles over the last PROFILER_SCOPE_HISTORY_SIZE durations of the scope */
+void profiler_scope_stats(profiler_scope_t scope, profiler_stats_t* out_stats);
+
+/**
+* Counts the last PROFILER_SCOPE_HISTORY_SIZE durations of the scope in buckets of bucket_width_us microseconds,
+* the last bucket also counts every longer duration.
+*
+* \returns the count of the fullest bucket.
+*/
+uint32_t profiler_scope_histogram(profiler_scope_t scope, uint32_t* out_buckets, size_t bucket_count, uint32_t bucket_width_us);
+
+/**
+* Writes the recorded samples as complete events of the Chrome trace event format.
+*
+* \returns false if the file could not be written.
+*/
+bool profiler_export_trace(const char* file_path);
+
+#endif
@@ -4,8 +4,23 @@
 #include "game.h"
 #include "SDL2/SDL.h"
 
+#define PROFILER_OVERLAY_REFRESH_MS 500
+#define PROFILER_OVERLAY_BUCKET_COUNT 34
+#define PROFILER_OVERLAY_BUCKET_WIDTH_US 1000
+#define PROFILER_OVERLAY_FRAME_BUDGET_US 16667
+
 void render_frame();
 
 void render_only_board();
 
+/* Redraws the cached board background, must be called whenever the size of the board or its double corner side changes */
+void render_board_background_build();
+
+void render_board_background_free();
+
+/* Draws the frame time histogram and the percentiles of every profiled scope over the frame, its text is refreshed every PROFILER_OVERLAY_REFRESH_MS */
+void render_profiler_overlay();
+
+void render_profiler_overlay_free();
+
 #endif
\ No newline at end of file
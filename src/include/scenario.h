@@ -0,0 +1,41 @@
+#ifndef SCENARIO_HEADER
+#define SCENARIO_HEADER
+
+#include <stdint.h>
+
+#include "board.h"
+
+#define DTS_USE_ARRAY
+
+#include "dtstructs.h"
+
+enum
+{
+    SCENARIO_MODE_1V1,
+    SCENARIO_MODE_CHALLENGE
+};
+
+typedef struct
+{
+    ruleset_t rules;
+
+    board_t board;
+    team_t team;
+    uint8_t scenario_mode;
+
+    /* Team played by the computer in 1v1 scenarios, NO_TEAM when both teams are human */
+    team_t computer_team;
+
+    array(move_info_t) challenge_moves;
+} scenario_t;
+
+void scenario_set_default(scenario_t* scenario);
+
+/**
+* A turn of a challenge goes on while the next move starts where the previous one ended, like the game plays it.
+*
+* \returns the number of challenge moves of the turn starting at the given move.
+*/
+size_t scenario_challenge_turn_length(scenario_t* scenario, size_t first_move_index);
+
+#endif
\ No newline at end of file
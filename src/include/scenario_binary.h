@@ -0,0 +1,129 @@
+#ifndef SCENARIO_BINARY_HEADER
+#define SCENARIO_BINARY_HEADER
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "scenario.h"
+#include "file_mapping.h"
+
+#define SCENARIO_BINARY_FILE_EXTENSION ".schb"
+#define SCENARIO_BINARY_FILE_MAGIC "UCSSCB1"
+#define SCENARIO_BINARY_VERSION 1
+
+#define SCENARIO_BINARY_NAME_SIZE 64
+#define SCENARIO_BINARY_ICON_PATH_SIZE 128
+
+/*
+ * A .schb file is a library of compiled scenarios made to be mapped and read in place:
+ *
+ *     scenario_binary_file_header_t
+ *     uint64_t record_offsets [scenario_count]      from the start of the file
+ *     scenario_binary_record_t, followed by its challenge_move_count scenario_binary_move_t, for each scenario
+ *
+ * Records start on 8 byte boundaries. Values are in the byte order of the machine that wrote the file.
+ */
+
+enum
+{
+    SCENARIO_BINARY_RULE_DOUBLE_CORNER_ON_RIGHT     = 1 << 0,
+    SCENARIO_BINARY_RULE_LAW_OF_QUANTITY            = 1 << 1,
+    SCENARIO_BINARY_RULE_LAW_OF_QUALITY             = 1 << 2,
+    SCENARIO_BINARY_RULE_PEONS_CAPTURE_BACKWARDS    = 1 << 3,
+    SCENARIO_BINARY_RULE_FLYING_KINGS               = 1 << 4,
+    SCENARIO_BINARY_RULE_WHITE_FORWARD_TOP_TO_BOTTOM = 1 << 5
+};
+
+typedef struct
+{
+    char magic [8];
+    uint32_t version;
+    uint32_t scenario_count;
+} scenario_binary_file_header_t;
+
+typedef struct
+{
+    /* Same layout as board_t, so the board can be used straight from the mapping */
+    board_t board;
+
+    uint32_t challenge_move_count;
+    uint8_t board_side_size;
+    uint8_t rule_flags;
+    team_t team;
+    uint8_t scenario_mode;
+    team_t computer_team;
+    uint8_t padding [7];
+
+    /* Empty strings when the scenario has no name or icon */
+    char name [SCENARIO_BINARY_NAME_SIZE];
+    char icon_path [SCENARIO_BINARY_ICON_PATH_SIZE];
+} scenario_binary_record_t;
+
+typedef struct
+{
+    /* capture_cell is NO_CELL for a move without capture */
+    cell_id_t source_cell;
+    cell_id_t destination_cell;
+    cell_id_t capture_cell;
+    uint16_t padding;
+} scenario_binary_move_t;
+
+typedef struct
+{
+    file_mapping_t mapping;
+    const scenario_binary_file_header_t* header;
+    const uint64_t* record_offsets;
+} scenario_binary_library_t;
+
+/* A scenario to write, with the optional properties the text format has besides scenario_t */
+typedef struct
+{
+    const scenario_t* scenario;
+    const char* name;
+    const char* icon_path;
+} scenario_binary_entry_t;
+
+/**
+* Maps a .schb file and checks that its header and record table fit in it, the records stay in the mapping.
+*
+* \returns false if the file cannot be mapped or is not a valid library.
+*/
+bool scenario_binary_open(scenario_binary_library_t* library, const char* path);
+
+void scenario_binary_close(scenario_binary_library_t* library);
+
+size_t scenario_binary_count(const scenario_binary_library_t* library);
+
+const scenario_binary_record_t* scenario_binary_record(const scenario_binary_library_t* library, size_t index);
+
+const scenario_binary_move_t* scenario_binary_record_moves(const scenario_binary_record_t* record);
+
+ruleset_t scenario_binary_record_rules(const scenario_binary_record_t* record);
+
+/**
+* Fills a scenario from a record checked against the limits of the .sch loader, the board hash is computed again.
+* Only the challenge moves are allocated (an empty array outside of challenges).
+*
+* \returns false if the record does not hold a valid scenario, the error is logged and nothing is allocated.
+*/
+bool scenario_binary_record_to_scenario(const scenario_binary_record_t* record, scenario_t* out_scenario);
+
+/**
+* Writes a library holding the given scenarios in order.
+*
+* \returns false if the file could not be written.
+*/
+bool scenario_binary_write_file(const char* path, const scenario_binary_entry_t* entries, size_t entry_count);
+
+/**
+* Loads a .schb file holding a single scenario, exits like load_scenario_from_file when the file is not valid.
+* Libraries of several scenarios are rejected rather than read partially, they are read with scenario_binary_open.
+*/
+void load_scenario_from_binary_file(scenario_t* destination, const char* file_path);
+
+/**
+* \returns false if the file is not valid, the error is logged.
+*/
+bool try_load_scenario_from_binary_file(scenario_t* destination, const char* file_path);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SCENARIO_INDEX_HEADER
+#define SCENARIO_INDEX_HEADER
+
+#include <stdint.h>
+
+#include "scenario_loader.h"
+
+#define SCENARIO_INDEX_FILE_NAME "scenarios.idx"
+#define SCENARIO_INDEX_FILE_MAGIC "UCSIDX1"
+#define SCENARIO_INDEX_VERSION 1
+#define SCENARIO_INDEX_PATH_SIZE 256
+
+typedef struct
+{
+    char magic [8];
+    uint32_t version;
+    uint32_t entry_count;
+} scenario_index_file_header_t;
+
+/* A scenario file as it was when its header was scanned, the entry is stale once the file changes */
+typedef struct
+{
+    char path [SCENARIO_INDEX_PATH_SIZE];
+    int64_t modification_time;
+    uint64_t file_size;
+    scenario_header_t header;
+} scenario_index_entry_t;
+
+/**
+* Fills out_headers[i] with the header of the i-th path, the paths being files of the given directory.
+*
+* Headers come from the index file of the directory when the path, modification time and size of the file
+* still match, the other files are scanned. The index is then rewritten to hold exactly these files, which
+* silently does nothing if the directory cannot be written to.
+*/
+void scenario_index_get_headers(string_t dir_path, array(string_t)* paths, scenario_header_t* out_headers);
+
+#endif
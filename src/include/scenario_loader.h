@@ -3,7 +3,7 @@
 
 #include <stdint.h>
 
-#include "game.h"
+#include "scenario.h"
 #include "lexer.h"
 #include "strplus.h"
 
@@ -20,6 +20,10 @@
 #define PATH_SCENARIOS_EDITOR       "scenarios/editor/"
 #define SCENARIO_FILE_EXTENSION     ".sch"
 
+#define SCENARIO_HEADER_NAME_SIZE       64
+#define SCENARIO_HEADER_ICON_PATH_SIZE  128
+#define SCENARIO_HEADER_LINE_SIZE       512
+
 typedef struct 
 {
     token_t* current_token;
@@ -27,20 +31,44 @@ typedef struct
     scenario_t* destination;
     array(token_t) token_array;
     size_t iterator;
+    bool has_failed;
 } scenario_loader_t;
 
+/* Properties only shown by the scenario browser, the loader skips them. Empty strings when missing */
 typedef struct
 {
-    SDL_Texture* icon_texture;
-    SDL_Texture* name_texture;
-} scenario_info_t;
+    char name [SCENARIO_HEADER_NAME_SIZE];
+    char icon_path [SCENARIO_HEADER_ICON_PATH_SIZE];
+} scenario_header_t;
 
+/* Exits when the scenario is not valid, like load_scenario_from_file */
 void load_scenario_from_token_array(scenario_t* destination, array(token_t) scenario_file_token_array);
 
+/* Exits when the file cannot be read or the scenario is not valid, the error is logged first */
 void load_scenario_from_file(scenario_t* destination, string_t scenario_file_name);
 
+/**
+* Same as load_scenario_from_token_array but returns instead of exiting, nothing of the scenario is left to free on failure.
+*
+* \returns false if the scenario is not valid, the error is logged.
+*/
+bool try_load_scenario_from_token_array(scenario_t* destination, array(token_t) scenario_file_token_array);
+
+/**
+* Same as load_scenario_from_file but returns instead of exiting, nothing of the scenario is left to free on failure.
+*
+* \returns false if the file cannot be read or the scenario is not valid, the error is logged.
+*/
+bool try_load_scenario_from_file(scenario_t* destination, string_t scenario_file_name);
+
 array(string_t) get_scenario_paths_from_dir(string_t dir_path);
 
-scenario_info_t get_scenario_info_from_file(string_t file_path);
+/**
+* Reads the file line by line until both NAME and ICON are found, the rest of the file is not read.
+* Values too long for the header are truncated.
+*
+* \returns false if the file could not be opened.
+*/
+bool scan_scenario_header_from_file(string_t file_path, scenario_header_t* out_header);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,14 @@
+#ifndef SCENARIO_WRITER_HEADER
+#define SCENARIO_WRITER_HEADER
+
+#include <stdio.h>
+
+#include "scenario.h"
+
+/**
+* Writes the scenario as the text of a .sch file, load_scenario_from_file reads it back to the same scenario.
+* The name and the icon path are optional properties, they are left out when NULL or empty.
+*/
+void scenario_write_sch(FILE* f, const scenario_t* scenario, const char* name, const char* icon_path);
+
+#endif
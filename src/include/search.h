@@ -0,0 +1,98 @@
+#ifndef SEARCH_HEADER
+#define SEARCH_HEADER
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "board.h"
+
+#define SEARCH_MAX_PLY 64
+#define SEARCH_TRANSPOSITION_TABLE_SIZE (1 << 18)
+
+#define SEARCH_WIN_SCORE 1000000
+#define SEARCH_PEON_SCORE 100
+#define SEARCH_QUEEN_SCORE 300
+#define SEARCH_PEON_ADVANCE_SCORE 4
+
+typedef struct
+{
+    zobrist_key_t key;
+    int32_t score;
+    int8_t depth;
+    uint8_t bound;
+    uint16_t best_move_index;
+} search_transposition_entry_t;
+
+typedef struct
+{
+    /* Deepest iteration to run, SEARCH_MAX_PLY - 1 at most */
+    unsigned max_depth;
+
+    /* Seconds the search may take, 0 for no limit */
+    double time_budget_seconds;
+
+    /* Checked while searching so another thread can cut the search short, may be NULL */
+    atomic_bool* stop_requested;
+} search_limits_t;
+
+typedef struct
+{
+    bool has_move;
+    legal_move_t best_move;
+
+    /* From the point of view of the team that searched, in hundredths of a peon */
+    int score;
+
+    unsigned completed_depth;
+    uint64_t node_count;
+} search_result_t;
+
+/*
+ * Iterative deepening alpha-beta searcher. Moves come from board_generate_legal_moves, so every rule
+ * of the ruleset is respected, and forced captures are always searched past the nominal depth.
+ */
+typedef struct
+{
+    ruleset_t rules;
+
+    legal_move_list_t* move_lists;
+    search_transposition_entry_t* transposition_table;
+
+    search_limits_t limits;
+    double start_time;
+    uint64_t node_count;
+    bool is_aborted;
+
+    size_t root_best_move_index;
+} searcher_t;
+
+void searcher_init(searcher_t* searcher, const ruleset_t* rules);
+
+void searcher_free(searcher_t* searcher);
+
+/**
+* Forgets every position of the transposition table.
+*/
+void searcher_clear(searcher_t* searcher);
+
+/**
+* Searches the position until the depth or the time limit is reached.
+*
+* \returns the best move found by the deepest completed iteration, has_move is false only if the team cannot move.
+*/
+search_result_t searcher_find_best_move(searcher_t* searcher, const board_t* board, team_t playing_team, search_limits_t limits);
+
+/**
+* Searches the position like searcher_find_best_move, without giving up early on forced moves.
+*
+* \returns the score of the deepest completed iteration for the playing team, its static evaluation if none completed.
+*/
+int searcher_score_position(searcher_t* searcher, const board_t* board, team_t playing_team, search_limits_t limits);
+
+/**
+* \returns the static evaluation of the board for the playing team.
+*/
+int search_evaluate(const ruleset_t* rules, const board_t* board, team_t playing_team);
+
+#endif
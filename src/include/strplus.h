@@ -62,6 +62,13 @@ typedef struct
 
 size_t string_view_length(string_view_t string_view);
 
+/**
+* \returns a view of the whole string, the view borrows the characters so the string must outlive it.
+*/
+string_view_t string_view_from_string(string_t string);
+
+bool string_view_equals(string_view_t viewA, string_view_t viewB);
+
 /**
 * Creates a HEAP allocated string containing the characters within the given string view interval.
 *
@@ -1,13 +1,16 @@
 #if !defined(SUI_HEADER)
 #define SUI_HEADER 
 
+#include <stdbool.h>
+
 #include "SDL2/SDL.h"
 #include "SDL2/SDL_ttf.h"
 #include "SDL2/SDL_image.h"
 
-#ifndef MAX_GLOBAL_ELEMENT_COUNT
-#define MAX_GLOBAL_ELEMENT_COUNT 100
-#endif
+/* Elements live in chunks which never move, so the pointers handed out stay valid until the set is cleared */
+#define SUI_ELEMENT_CHUNK_SIZE 64
+
+#define SUI_HIT_GRID_CELL_SIZE 128
 
 enum
 {
@@ -60,6 +63,33 @@ typedef struct
     sui_generic_element_t text;
 } sui_simple_button_t;
 
+typedef struct
+{
+    size_t count;
+    sui_generic_element_t elements [SUI_ELEMENT_CHUNK_SIZE];
+} sui_element_chunk_t;
+
+/**
+* Elements of one screen. Clearing a set keeps its chunks for the next elements, and a set which is not active keeps
+* its elements, so a screen can be built once and activated again later.
+*/
+typedef struct
+{
+    sui_element_chunk_t** chunks;
+    size_t chunk_count;
+    size_t allocated_chunk_count;
+    size_t chunk_capacity;
+
+    /* Uniform grid over the buttons, each cell lists the buttons overlapping it in the order they were added */
+    bool is_hit_grid_dirty;
+    int hit_grid_x;
+    int hit_grid_y;
+    int hit_grid_columns;
+    int hit_grid_rows;
+    size_t* hit_grid_cell_starts;
+    sui_button_t** hit_grid_buttons;
+} sui_element_set_t;
+
 SDL_Texture* sui_load_texture(char* file, SDL_Renderer* renderer, SDL_Surface** out_surface);
 
 SDL_Rect sui_get_texture_rect(SDL_Texture* texture, int x, int y);
@@ -100,4 +130,19 @@ void sui_draw_elements(SDL_Renderer* renderer);
 
 void sui_clear_elements();
 
+void sui_element_set_init(sui_element_set_t* set);
+
+void sui_element_set_free(sui_element_set_t* set);
+
+/* Following calls add, draw and click the elements of this set, NULL goes back to the default set */
+void sui_element_set_activate(sui_element_set_t* set);
+
+sui_element_set_t* sui_active_element_set();
+
+/* Adding or clearing elements and clicking a button mark the elements dirty on their own, changes made
+   directly to an element must call this. Drawing the elements makes them clean again. */
+void sui_invalidate();
+
+bool sui_is_dirty();
+
 #endif
\ No newline at end of file
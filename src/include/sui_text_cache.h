@@ -0,0 +1,39 @@
+#ifndef SUI_TEXT_CACHE_HEADER
+#define SUI_TEXT_CACHE_HEADER
+
+#include <stdbool.h>
+
+#include "SDL2/SDL.h"
+#include "SDL2/SDL_ttf.h"
+
+#define SUI_GLYPH_ATLAS_SIZE 1024
+#define SUI_GLYPH_ATLAS_PADDING 1
+#define SUI_GLYPH_ATLAS_MAX_FONTS 8
+
+/* Latin-1 glyphs are indexed directly, the few others are searched */
+#define SUI_GLYPH_ATLAS_DIRECT_GLYPH_COUNT 256
+#define SUI_GLYPH_ATLAS_EXTRA_GLYPH_COUNT 64
+
+#define SUI_TEXT_CACHE_CAPACITY 64
+
+/**
+* Lays the text out from the glyph atlas of the font, rasterizing only the glyphs it has never seen.
+* The texture belongs to the caller.
+*
+* \returns the texture of the text, NULL if the text is empty or its glyphs do not fit in the atlas.
+*/
+SDL_Texture* sui_text_cache_render(SDL_Renderer* renderer, TTF_Font* font, const char* text, bool is_utf8, SDL_Color text_color);
+
+/**
+* Same as sui_text_cache_render but the texture belongs to the cache, which keeps the last SUI_TEXT_CACHE_CAPACITY
+* texts it was asked for. A texture stays valid until that many other texts were asked for, so it suits labels
+* that are on screen, not textures kept around for later.
+*
+* \returns the texture of the text, NULL if the text is empty.
+*/
+SDL_Texture* sui_text_cache_get(SDL_Renderer* renderer, TTF_Font* font, const char* text, bool is_utf8, SDL_Color text_color);
+
+/* Must run before the fonts and the renderer are destroyed */
+void sui_text_cache_free();
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef TABLEBASE_HEADER
+#define TABLEBASE_HEADER
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "board.h"
+#include "geometry.h"
+#include "file_mapping.h"
+
+/* Pieces are grouped by type, a table holds every position of a given number of pieces of each group */
+#define TABLEBASE_GROUP_COUNT 4
+#define TABLEBASE_MAX_PIECES_PER_GROUP 8
+#define TABLEBASE_TABLE_SLOT_COUNT 6561 /* (TABLEBASE_MAX_PIECES_PER_GROUP + 1) ^ TABLEBASE_GROUP_COUNT */
+
+#define TABLEBASE_FILE_MAGIC "UCSTB01"
+#define TABLEBASE_FILE_PATH_SIZE 512
+
+/* Leaves room in a path for the name of a table file, a rules key and four counts */
+#define TABLEBASE_DIRECTORY_SIZE (TABLEBASE_FILE_PATH_SIZE - 32)
+
+/*
+ * Every position takes one byte: 0 while unknown (a draw once the table is complete), 255 for
+ * placements that cannot happen in a game, and 1 + 2 * distance + is_win otherwise, the distance
+ * being the number of turns until the game ends with best play.
+ */
+#define TABLEBASE_VALUE_UNKNOWN 0
+#define TABLEBASE_VALUE_INVALID 255
+#define TABLEBASE_MAX_DISTANCE 126
+
+#define tablebase_value_loss(DISTANCE) ((uint8_t)(1 + 2 * (DISTANCE)))
+#define tablebase_value_win(DISTANCE) ((uint8_t)(2 + 2 * (DISTANCE)))
+#define tablebase_value_is_known(VALUE) ((VALUE) != TABLEBASE_VALUE_UNKNOWN && (VALUE) != TABLEBASE_VALUE_INVALID)
+#define tablebase_value_is_win(VALUE) (tablebase_value_is_known(VALUE) && (VALUE) % 2 == 0)
+#define tablebase_value_is_loss(VALUE) (tablebase_value_is_known(VALUE) && (VALUE) % 2 != 0)
+#define tablebase_value_distance(VALUE) (((VALUE) - 1) / 2)
+
+enum
+{
+    TABLEBASE_GROUP_WHITE_PEONS,
+    TABLEBASE_GROUP_BLACK_PEONS,
+    TABLEBASE_GROUP_WHITE_QUEENS,
+    TABLEBASE_GROUP_BLACK_QUEENS
+};
+
+enum
+{
+    TABLEBASE_OUTCOME_DRAW,
+    TABLEBASE_OUTCOME_WIN,
+    TABLEBASE_OUTCOME_LOSS
+};
+
+typedef struct
+{
+    uint8_t counts [TABLEBASE_GROUP_COUNT];
+} tablebase_material_t;
+
+typedef struct
+{
+    char magic [8];
+    uint16_t rules_key;
+    uint8_t counts [TABLEBASE_GROUP_COUNT];
+    uint8_t padding [2];
+    uint64_t entry_count;
+} tablebase_file_header_t;
+
+typedef struct
+{
+    /* Set once values is final, the threads which see it set read values without the lock */
+    atomic_bool was_load_attempted;
+    const uint8_t* values;
+    uint64_t entry_count;
+
+    file_mapping_t mapping;
+} tablebase_table_t;
+
+typedef struct
+{
+    char directory [TABLEBASE_DIRECTORY_SIZE];
+    ruleset_t rules;
+    const board_geometry_t* geometry;
+
+    /* Indexed by tablebase_material_slot, tables are mapped the first time they are needed */
+    tablebase_table_t* tables;
+
+    /* Held while a table is mapped, so probes from several threads map each table once */
+    atomic_flag load_lock;
+} tablebase_t;
+
+/* Result of a probe, from the point of view of the team to play */
+typedef struct
+{
+    uint8_t outcome;
+    unsigned distance;
+} tablebase_result_t;
+
+void tablebase_open(tablebase_t* tablebase, const char* directory, const ruleset_t* rules);
+
+void tablebase_close(tablebase_t* tablebase);
+
+tablebase_material_t tablebase_material_of(const tablebase_t* tablebase, const board_t* board);
+
+size_t tablebase_material_slot(tablebase_material_t material);
+
+unsigned tablebase_material_piece_count(tablebase_material_t material);
+
+/**
+* \returns the number of entries of the table of the material, both teams to play included.
+*/
+uint64_t tablebase_entry_count(const tablebase_t* tablebase, tablebase_material_t material);
+
+/**
+* \returns the entry of the position in the table of its material, which must be the material of the board.
+*/
+uint64_t tablebase_index(const tablebase_t* tablebase, tablebase_material_t material, const board_t* board, team_t playing_team);
+
+/**
+* Builds the position stored at the given entry of the table of the material, the inverse of tablebase_index.
+*/
+void tablebase_position_from_index(const tablebase_t* tablebase, tablebase_material_t material, uint64_t index, board_t* out_board, team_t* out_playing_team);
+
+/**
+* \returns false if the path does not fit in path_size characters.
+*/
+bool tablebase_table_file_path(const tablebase_t* tablebase, tablebase_material_t material, char* out_path, size_t path_size);
+
+/**
+* Maps the file of the table of the material in memory, does nothing if it is already mapped.
+* Safe to call from several threads, as are the probes which call it.
+*
+* \returns true if the table is available.
+*/
+bool tablebase_load_table(tablebase_t* tablebase, tablebase_material_t material);
+
+/**
+* Reads the raw value of the position, positions where one of the teams has no piece left are solved without any table.
+*
+* \returns false if the table of the position is not available.
+*/
+bool tablebase_probe_value(tablebase_t* tablebase, const board_t* board, team_t playing_team, uint8_t* out_value);
+
+/**
+* \returns false if the table of the position is not available.
+*/
+bool tablebase_probe(tablebase_t* tablebase, const board_t* board, team_t playing_team, tablebase_result_t* out_result);
+
+#endif
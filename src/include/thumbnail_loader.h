@@ -0,0 +1,106 @@
+#ifndef THUMBNAIL_LOADER_HEADER
+#define THUMBNAIL_LOADER_HEADER
+
+#include <stdbool.h>
+
+#include "scenario_loader.h"
+#include "SDL2/SDL.h"
+#include "SDL2/SDL_ttf.h"
+
+#define THUMBNAIL_LOADER_MAX_THREADS 4
+
+/* Textures of this many elements before and after the requested range are kept when the range moves */
+#define THUMBNAIL_LOADER_KEEP_MARGIN_FACTOR 2
+
+#define THUMBNAIL_LOADER_MAX_UPLOADS_PER_FRAME 8
+
+enum
+{
+    THUMBNAIL_IDLE,
+    THUMBNAIL_QUEUED,
+    THUMBNAIL_DECODING,
+    THUMBNAIL_DECODED,
+    THUMBNAIL_READY,
+    THUMBNAIL_MISSING
+};
+
+typedef struct
+{
+    /* Written by the workers under the mutex while queued or decoding */
+    uint8_t state;
+    SDL_Surface* surface;
+
+    /* Only touched by the render thread */
+    SDL_Texture* icon_texture;
+    SDL_Texture* name_texture;
+} thumbnail_t;
+
+/*
+ * Loads the icons of the scenario browser in the background: worker threads decode the PNG files of
+ * the requested elements and the render thread turns them into textures a few per frame. Textures
+ * of elements far from the requested range are released, so memory does not grow with the number
+ * of scenarios.
+ */
+typedef struct
+{
+    const scenario_header_t* headers;
+    thumbnail_t* thumbnails;
+    size_t thumbnail_count;
+
+    /* Indices of the thumbnails waiting for a worker, rebuilt every time the requested range moves */
+    size_t* queue;
+    size_t queue_start;
+    size_t queue_end;
+
+    size_t keep_start;
+    size_t keep_end;
+
+    SDL_mutex* mutex;
+    SDL_cond* has_work;
+    bool quit_requested;
+
+    SDL_Thread* threads [THUMBNAIL_LOADER_MAX_THREADS];
+    size_t thread_count;
+} thumbnail_loader_t;
+
+/**
+* Starts the workers, nothing is loaded until thumbnail_loader_request is called. The headers must outlive the loader.
+*/
+void thumbnail_loader_init(thumbnail_loader_t* loader, const scenario_header_t* headers, size_t thumbnail_count);
+
+/**
+* Stops the workers and releases every surface and texture.
+*/
+void thumbnail_loader_free(thumbnail_loader_t* loader);
+
+/**
+* Replaces the pending requests: the elements of [start, end) are decoded first, then prefetch_count elements
+* after and before them. Textures outside of a wider margin around the range are released.
+*/
+void thumbnail_loader_request(thumbnail_loader_t* loader, size_t start, size_t end, size_t prefetch_count);
+
+/**
+* Turns decoded icons into textures, at most THUMBNAIL_LOADER_MAX_UPLOADS_PER_FRAME of them. Must run on the render thread.
+*
+* \returns true if an element of [visible_start, visible_end) got its icon.
+*/
+bool thumbnail_loader_upload(thumbnail_loader_t* loader, SDL_Renderer* renderer, size_t visible_start, size_t visible_end);
+
+/**
+* \returns true while a thumbnail near the requested range is still being loaded or waits to be uploaded.
+*/
+bool thumbnail_loader_has_pending(thumbnail_loader_t* loader);
+
+/**
+* \returns the icon texture of the element, NULL while it is loading or when it has none.
+*/
+SDL_Texture* thumbnail_loader_icon(const thumbnail_loader_t* loader, size_t index);
+
+/**
+* Renders the name of the element the first time it is asked for. Must run on the render thread.
+*
+* \returns the name texture of the element, NULL when it has no name.
+*/
+SDL_Texture* thumbnail_loader_name(thumbnail_loader_t* loader, SDL_Renderer* renderer, TTF_Font* font, SDL_Color color, size_t index);
+
+#endif
@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "strplus.h"
+
 enum
 {
     TOKEN_EMPTY,
@@ -16,6 +18,7 @@ enum
 
 typedef unsigned char token_type_t;
 
+/* Identifiers and strings borrow their characters from the source given to the lexer, tokens own no memory */
 typedef struct
 {
     token_type_t type;
@@ -23,16 +26,14 @@ typedef struct
     union 
     {
         char symbol;
-        char* identifier;
+        string_view_t identifier;
         char char_value;
-        char* string_value;
+        string_view_t string_value;
         uint16_t integer_value;
     };
 
 } token_t;
 
-void token_free(token_t* token);
-
 bool token_equals(token_t* token1, token_t* token2);
 
 bool token_is_symbol(token_t* token, char symbol);
@@ -43,6 +43,10 @@
 #define UI_EDITOR_LABEL_LAW_QUALITY "LAW OF QUALITY"
 #define UI_EDITOR_LABEL_PEON_BACK_CAPTURE "PEONS CAPTURE BACKWARDS"
 #define UI_EDITOR_LABEL_FLYING_KINGS "FLYING KINGS"
+#define UI_EDITOR_LABEL_COMPUTER_PLAYER "COMPUTER PLAYS"
+
+#define UI_EDITOR_LABEL_WHITE "WHITE"
+#define UI_EDITOR_LABEL_BLACK "BLACK"
 
 #else
 
@@ -77,6 +81,10 @@
 #define UI_EDITOR_LABEL_LAW_QUALITY "LEI DA QUALIDADE"
 #define UI_EDITOR_LABEL_PEON_BACK_CAPTURE "PEÃO CAPTURA PARA TRÁS"
 #define UI_EDITOR_LABEL_FLYING_KINGS "DAMAS VOADORAS"
+#define UI_EDITOR_LABEL_COMPUTER_PLAYER "COMPUTADOR JOGA"
+
+#define UI_EDITOR_LABEL_WHITE "BRANCAS"
+#define UI_EDITOR_LABEL_BLACK "NEGRAS"
 
 #endif
 
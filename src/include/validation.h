@@ -1,15 +1,35 @@
 #ifndef VALIDATION_HEADER
 #define VALIDATION_HEADER
 
-#include "game.h"
-#include "interaction.h"
+#include "board.h"
 
-bool validation_is_peon_moving_forward(cell_value_t piece_type, board_position_t movement);
+#define IS_DIAGONAL(MOVEMENT_VECTOR) ((MOVEMENT_VECTOR).x == (MOVEMENT_VECTOR).y || (MOVEMENT_VECTOR).x == -(MOVEMENT_VECTOR).y)
 
-bool validate_move_based_on_rules(incomplete_move_info_t move, tree_t* out_updated_capture_tree);
+/* Value of each captured piece for the law of quality */
+#define LAW_OF_QUALITY_PEON_POINTS 1
+#define LAW_OF_QUALITY_QUEEN_POINTS 2
 
-void validation_capture_tree_apply_law_of_quantity(tree_t capture_tree);
+/* Length and value of the best capture sequence that starts with a given capture */
+typedef struct
+{
+    size_t capture_count;
+    size_t points;
+} capture_chain_score_t;
 
-void validation_capture_tree_apply_law_of_quality(tree_t capture_tree);
+bool validation_is_peon_moving_forward(const ruleset_t* rules, cell_value_t piece_type, board_position_t movement);
+
+/**
+* Validates a move of the playing team, when the capture subtree has children only the captures it contains are allowed.
+*
+* \returns true if the move is valid, out_updated_capture_subtree is set to the matching child of the capture subtree or FTREE_NO_NODE for quiet moves.
+*/
+bool validate_move_based_on_rules(const ruleset_t* rules, const board_t* board, team_t playing_team, const ftree_t* capture_tree, ftnode_id_t capture_subtree, incomplete_move_info_t move, ftnode_id_t* out_updated_capture_subtree);
+
+/**
+* Compares two capture sequences with the laws of quantity and quality that the ruleset applies.
+*
+* \returns a positive value if only a may be played, a negative value if only b may be played, 0 if both may be played.
+*/
+int validation_compare_capture_chains(const ruleset_t* rules, capture_chain_score_t a, capture_chain_score_t b);
 
 #endif
\ No newline at end of file
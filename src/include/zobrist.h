@@ -0,0 +1,16 @@
+#ifndef ZOBRIST_HEADER
+#define ZOBRIST_HEADER
+
+#include <stdint.h>
+
+#include "board.h"
+
+#define ZOBRIST_PIECE_TYPE_COUNT 5
+
+/* Key of a piece type standing on a cell, zero for NO_PIECE */
+#define zobrist_piece_key(CELL, PIECE_TYPE) (zobrist_piece_keys[CELL][(PIECE_TYPE) + 2])
+
+extern const zobrist_key_t zobrist_piece_keys [MAX_BOARD_PLAYABLE_CELL_COUNT][ZOBRIST_PIECE_TYPE_COUNT];
+extern const zobrist_key_t zobrist_black_to_move_key;
+
+#endif
@@ -11,8 +11,6 @@
 static void move_selected_piece_in_1v1_scenario(incomplete_move_info_t incomplete_move);
 static void move_selected_piece_in_challenge_scenario(incomplete_move_info_t incomplete_move);
 static void switch_teams();
-static bool is_crowning_cell_of_team(team_t team, cell_id_t cell);
-static void promote_to_queen_if_valid(cell_id_t piece_cell);
 
 void challenge_auto_play()
 {
@@ -28,19 +26,52 @@ void challenge_auto_play()
     game.current_challenge_move_index++;
     
     board_apply_move(&game.scenario_data.board, expected_move);
+    game_invalidate();
 
     move_info_t next_expected_move = array_ele(&game.scenario_data.challenge_moves, move_info_t, game.current_challenge_move_index);
 
     if(expected_move.destination_cell == next_expected_move.source_cell) return;
 
-    promote_to_queen_if_valid(expected_move.destination_cell);
+    board_promote_to_queen_if_valid(&game.scenario_data.rules, &game.scenario_data.board, expected_move.destination_cell);
     switch_teams();
 }
 
+void computer_play_turn()
+{
+    legal_move_t move;
+
+    if(!game.computer_player.is_searching)
+    {
+        /* A scenario may start with the computer unable to move, the game is over rather than searched every frame */
+        if(!board_contains_any_valid_moves_for_team(&game.scenario_data.rules, &game.scenario_data.board, game.current_team))
+        {
+            game_check_for_and_activate_victory();
+            return;
+        }
+
+        computer_player_start_search(&game.computer_player, &game.scenario_data.board, game.current_team);
+        return;
+    }
+
+    if(!computer_player_poll_move(&game.computer_player, &move)) return;
+
+    board_play_legal_move(&game.scenario_data.rules, &game.scenario_data.board, &move);
+    game_invalidate();
+    switch_teams();
+
+    game.contains_last_move_info = true;
+    game.last_move_source_cell_id = move.source_cell;
+    game.last_move_dest_cell_id = legal_move_final_cell(&move);
+
+    game_check_for_and_activate_victory();
+}
+
 void place_piece_on_hovered_cell()
 {
-    if(game.is_cell_hovered) 
-        game.scenario_data.board.playable_cells[game.currently_hovered_cell_id] = game.piece_type_to_place;
+    if(!game.is_cell_hovered) return;
+
+    board_set_cell(&game.scenario_data.board, game.currently_hovered_cell_id, game.piece_type_to_place);
+    game_invalidate();
 }
 
 void select_hovered_piece()
@@ -51,6 +82,7 @@ void select_hovered_piece()
 
     game.is_piece_selected = true;
     game.selected_piece_cell_id = game.currently_hovered_cell_id;
+    game_invalidate();
 }
 
 void move_selected_piece_to_hovered_cell()
@@ -73,22 +105,29 @@ void move_selected_piece_to_hovered_cell()
             break;
     }
 
+    game_invalidate();
     game_check_for_and_activate_victory();
 }
 
 void update_currently_hovered_cell()
 {
-    if(game.input.mouseX < game.screen_scenario_board_rect.x || game.input.mouseX > game.screen_scenario_board_rect.x + BOARD_SECTION_WIDTH)
+    if(game.input.mouseX < game.screen_scenario_board_rect.x || game.input.mouseX >= game.screen_scenario_board_rect.x + BOARD_SECTION_WIDTH)
     {
+        if(game.is_cell_hovered) game_invalidate();
+
         game.is_cell_hovered = false;
         return;
     }
 
     board_position_t cell_position;
-    cell_position.x = game.scenario_data.board_side_size * ((int)game.input.mouseX - game.screen_scenario_board_rect.x) / BOARD_SECTION_WIDTH;
-    cell_position.y = game.scenario_data.board_side_size * (int)game.input.mouseY / BOARD_SECTION_HEIGHT;
+    cell_position.x = game.scenario_data.rules.board_side_size * ((int)game.input.mouseX - game.screen_scenario_board_rect.x) / BOARD_SECTION_WIDTH;
+    cell_position.y = game.scenario_data.rules.board_side_size * (int)game.input.mouseY / BOARD_SECTION_HEIGHT;
 
-    game.currently_hovered_cell_id = cell_position_to_cell_id(cell_position);
+    cell_id_t hovered_cell_id = cell_position_to_cell_id(&game.scenario_data.rules, cell_position);
+
+    if(!game.is_cell_hovered || game.currently_hovered_cell_id != hovered_cell_id) game_invalidate();
+
+    game.currently_hovered_cell_id = hovered_cell_id;
     game.is_cell_hovered = true;
 }
 
@@ -102,33 +141,21 @@ void update_team_displayer()
     {
         game.team_displayer->color = (SDL_Color){ BLACK_PIECE_COLOR_VALS, 255 };
     }
-}
 
-static bool is_crowning_cell_of_team(team_t team, cell_id_t cell)
-{
-    if(game.scenario_data.is_white_peon_forward_top_to_bottom)
-    {
-        if(team == WHITE_TEAM) return cell < PLAYABLE_CELL_COUNT && cell >= (PLAYABLE_CELL_COUNT - PLAYABLE_CELL_COUNT_PER_LINE);
-        
-        return cell < PLAYABLE_CELL_COUNT_PER_LINE && cell >= 0;
-    }
-    
-    if(team == WHITE_TEAM) return cell < PLAYABLE_CELL_COUNT_PER_LINE && cell >= 0;
-    
-    return cell < PLAYABLE_CELL_COUNT && cell >= (PLAYABLE_CELL_COUNT - PLAYABLE_CELL_COUNT_PER_LINE);        
+    sui_invalidate();
 }
 
 static void move_selected_piece_in_1v1_scenario(incomplete_move_info_t incomplete_move)
 {
-    tree_t updated_current_capture_tree;
+    ftnode_id_t updated_capture_subtree;
     move_info_t complete_move;
-    bool was_move_validated = validate_move_based_on_rules(incomplete_move, &updated_current_capture_tree);
+    bool was_move_validated = validate_move_based_on_rules(&game.scenario_data.rules, &game.scenario_data.board, game.current_team, game.capture_tree, game.current_capture_subtree, incomplete_move, &updated_capture_subtree);
 
     if(!was_move_validated) return;
 
     if(game.force_capture_move)
     {
-        complete_move = tree_value(updated_current_capture_tree, move_info_t);
+        complete_move = ftree_value(game.capture_tree, move_info_t, updated_capture_subtree);
     }
     else
     {
@@ -139,16 +166,16 @@ static void move_selected_piece_in_1v1_scenario(incomplete_move_info_t incomplet
 
     board_apply_move(&game.scenario_data.board, complete_move);
 
-    if(updated_current_capture_tree != NULL && tree_child_count(updated_current_capture_tree) > 0) 
+    if(updated_capture_subtree != FTREE_NO_NODE && ftree_child_count(game.capture_tree, updated_capture_subtree) > 0) 
     {
         game.force_capture_move = true;
         game.is_piece_selected = true;
         game.selected_piece_cell_id = complete_move.destination_cell;
-        game.current_capture_subtree = updated_current_capture_tree;
+        game.current_capture_subtree = updated_capture_subtree;
         return;
     }
 
-    promote_to_queen_if_valid(complete_move.destination_cell);
+    board_promote_to_queen_if_valid(&game.scenario_data.rules, &game.scenario_data.board, complete_move.destination_cell);
     switch_teams();
 
     game.contains_last_move_info = true;
@@ -163,10 +190,12 @@ static void move_selected_piece_in_challenge_scenario(incomplete_move_info_t inc
     if(incomplete_move.source_cell != expected_move.source_cell || incomplete_move.destination_cell != expected_move.destination_cell)
     {
         game.challenge_feedback_displayer->texture = assetman_get_asset("$ChallengeWrong");
+        sui_invalidate();
         return;
     }
 
     game.challenge_feedback_displayer->texture = assetman_get_asset("$ChallengeCorrect");
+    sui_invalidate();
     
     game.current_challenge_move_index++;
 
@@ -183,7 +212,7 @@ static void move_selected_piece_in_challenge_scenario(incomplete_move_info_t inc
         return;
     }
     
-    promote_to_queen_if_valid(expected_move.destination_cell);
+    board_promote_to_queen_if_valid(&game.scenario_data.rules, &game.scenario_data.board, expected_move.destination_cell);
     switch_teams();
 
     game.contains_last_move_info = true;
@@ -191,16 +220,6 @@ static void move_selected_piece_in_challenge_scenario(incomplete_move_info_t inc
     game.last_move_dest_cell_id = expected_move.destination_cell;
 }
 
-static void promote_to_queen_if_valid(cell_id_t piece_cell)
-{
-    cell_value_t type_of_moved_piece = game.scenario_data.board.playable_cells[piece_cell];
-
-    if(piece_is_peon(type_of_moved_piece) && is_crowning_cell_of_team(game.current_team, piece_cell))
-    {
-        game.scenario_data.board.playable_cells[piece_cell] = piece_promote_to_queen(type_of_moved_piece);
-    }
-}
-
 static void switch_teams()
 {
     game.is_piece_selected = false;
@@ -209,8 +228,5 @@ static void switch_teams()
     update_team_displayer();
 
     if(game.scenario_data.scenario_mode == SCENARIO_MODE_1V1)
-    {
-        tree_free(game.capture_tree);
         game_1v1_scenario_set_capture_data();
-    }
 }
\ No newline at end of file
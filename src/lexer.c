@@ -1,10 +1,9 @@
 #include <ctype.h>
-#include <string.h>
 #include <stdlib.h>
 
 #include "include/lexer.h"
 
-static void lexer_skip_spaces(lexer_t* lexer)
+void lexer_skip_spaces(lexer_t* lexer)
 {
     while(*lexer->current_char_ptr == ' ' || 
           *lexer->current_char_ptr == '\t' || 
@@ -76,16 +75,11 @@ token_t lexer_collect_id(lexer_t* lexer)
     token_t token;
     token.type = TOKEN_ID;
 
-    char* start_id = lexer->current_char_ptr;
-    size_t id_size;
+    token.identifier.start = lexer->current_char_ptr;
 
     while(isalnum(*lexer->current_char_ptr) || *lexer->current_char_ptr == '_') lexer->current_char_ptr++;
     
-    id_size = lexer->current_char_ptr - start_id;
-
-    token.identifier = malloc(id_size + 1);
-    memcpy(token.identifier, start_id, id_size);
-    token.identifier[id_size] = '\0';
+    token.identifier.length = (size_t)(lexer->current_char_ptr - token.identifier.start);
 
     return token;
 }
@@ -99,8 +93,8 @@ token_t lexer_collect_char(lexer_t* lexer)
 
     token.char_value = *lexer->current_char_ptr;
     
-    lexer->current_char_ptr++;
-    lexer->current_char_ptr++;
+    if(*lexer->current_char_ptr != '\0') lexer->current_char_ptr++;
+    if(*lexer->current_char_ptr == '\'') lexer->current_char_ptr++;
 
     return token;
 }
@@ -112,18 +106,13 @@ token_t lexer_collect_string(lexer_t* lexer)
 
     lexer->current_char_ptr++;
 
-    char* start_string = lexer->current_char_ptr;
-    size_t string_size;
+    token.string_value.start = lexer->current_char_ptr;
 
-    while(*lexer->current_char_ptr != '\"') lexer->current_char_ptr++;
+    while(*lexer->current_char_ptr != '\"' && *lexer->current_char_ptr != '\0') lexer->current_char_ptr++;
     
-    string_size = lexer->current_char_ptr - start_string;
-
-    token.identifier = malloc(string_size + 1);
-    memcpy(token.identifier, start_string, string_size);
-    token.identifier[string_size] = '\0';
+    token.string_value.length = (size_t)(lexer->current_char_ptr - token.string_value.start);
 
-    lexer->current_char_ptr++;
+    if(*lexer->current_char_ptr == '\"') lexer->current_char_ptr++;
 
     return token;
 }
@@ -161,13 +150,7 @@ bool lexer_go_to_next_token_equal_to(lexer_t* lexer, token_t* token_to_find)
     {
         token_t token = lexer_collect_next_token(lexer);
 
-        if(token_equals(&token, token_to_find))
-        {
-            token_free(&token);
-            return true;
-        }
-
-        token_free(&token);
+        if(token_equals(&token, token_to_find)) return true;
     }
 
     return false;
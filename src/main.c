@@ -8,17 +8,28 @@
 #include "include/scenario_loader.h"
 #include "include/rendering.h"
 #include "include/assetman_setup.h"
+#include "include/sui_text_cache.h"
+#include "include/headless.h"
+#include "include/profiler.h"
 #include "include/SDL2/SDL.h"
 #include "include/SDL2/SDL_ttf.h"
 
 #define GAME_WINDOW_FLAGS SDL_WINDOW_SHOWN | SDL_WINDOW_FULLSCREEN_DESKTOP
 #define GAME_LOOP_DELAY_MS 15
+#define GAME_IDLE_WAIT_TIMEOUT_MS 1000
+#define GAME_PROFILER_OVERLAY_KEY SDLK_F3
+#define GAME_PROFILER_EXPORT_KEY SDLK_F4
+#define GAME_PROFILER_TRACE_PATH "log/trace.json"
 
 static void safe_exit();
 
 int main(int argc, char** argv)
 {
+    /* Any argument runs a batch command instead of the game, before SDL is initialised */
+    if(argc > 1) return headless_run(argc - 1, &argv[1]);
+
     atexit(safe_exit);
+    profiler_init();
 
     game.window = NULL;
     game.renderer = NULL;
@@ -64,6 +75,12 @@ int main(int argc, char** argv)
     game.is_text_input_field_active = false;
     game.text_input_field[0] = '\0';
     game.on_text_input_field_changed = NULL;
+    game.is_profiler_overlay_visible = false;
+
+    sui_element_set_init(&game.selector_elements);
+
+    for (size_t i = 0; i < EDITOR_SECTION_COUNT; i++)
+        sui_element_set_init(&game.editor_section_elements[i]);
     
     game_set_mode_menu(NULL);
 
@@ -71,39 +88,93 @@ int main(int argc, char** argv)
     Uint32 previous_time = SDL_GetTicks();
     Uint32 current_time;
 
+    game.needs_redraw = true;
+
     while (game.is_playing)
     {
-        current_time = SDL_GetTicks();
-        game.delta_time = (float) (current_time - previous_time) / 1000;
-
         game.input.type = GAME_INPUT_NONE;
 
-        while (SDL_PollEvent(&event))
+        bool has_event;
+
+        /* Nothing changes on screen until some input arrives, so the loop sleeps instead of redrawing the same frame.
+           The profiler overlay keeps redrawing to stay up to date. */
+        if(game.needs_redraw || sui_is_dirty() || game_is_animating() || game.is_profiler_overlay_visible)
+        {
+            has_event = SDL_PollEvent(&event);
+        }
+        else
+        {
+            has_event = SDL_WaitEventTimeout(&event, GAME_IDLE_WAIT_TIMEOUT_MS);
+            previous_time = SDL_GetTicks();
+        }
+
+        while (has_event)
         {
             switch(event.type)
             {
+                case SDL_KEYDOWN:
+                    if(event.key.keysym.sym == GAME_PROFILER_OVERLAY_KEY)
+                    {
+                        game.is_profiler_overlay_visible = !game.is_profiler_overlay_visible;
+                        game_invalidate();
+                    }
+                    else if(event.key.keysym.sym == GAME_PROFILER_EXPORT_KEY)
+                    {
+                        if(profiler_export_trace(GAME_PROFILER_TRACE_PATH)) LOGGER_LOGS("Profiler trace written to " GAME_PROFILER_TRACE_PATH);
+                        else LOGGER_ERRORS("Could not write the profiler trace to " GAME_PROFILER_TRACE_PATH);
+                    }
+                    else
+                    {
+                        game_catch_input(&event);
+                    }
+                    break;
                 case SDL_MOUSEMOTION:
                 case SDL_MOUSEBUTTONDOWN:
-                case SDL_KEYDOWN:
                     game_catch_input(&event);
                     break;
                 case SDL_TEXTINPUT:
                     game_text_input_field_receive(event.text.text);
                     break;
+                case SDL_WINDOWEVENT:
+                    game_invalidate();
+                    break;
+                case SDL_RENDER_TARGETS_RESET:
+                    /* The content of render targets is lost, the board background has to be drawn again */
+                    if(game.board_background != NULL) render_board_background_build();
+                    break;
                 case SDL_QUIT: 
                     game_quit(NULL);
                     break;
                 default: 
                     break;
             }
+
+            has_event = SDL_PollEvent(&event);
         }
 
+        current_time = SDL_GetTicks();
+        game.delta_time = (float) (current_time - previous_time) / 1000;
+
+        /* A frame is only recorded when it is drawn, so idle loops do not hide the slow frames */
+        PROFILER_BEGIN(PROFILER_SCOPE_FRAME);
+        PROFILER_BEGIN(PROFILER_SCOPE_UPDATE);
+
         game.update();
-            
-        SDL_SetRenderDrawColor(game.renderer, BACKGROUND_COLOR_VALS, 255);
-        SDL_RenderClear(game.renderer);
-        render_frame();
-        SDL_RenderPresent(game.renderer);
+
+        PROFILER_END(PROFILER_SCOPE_UPDATE);
+
+        if(game.needs_redraw || sui_is_dirty() || game.is_profiler_overlay_visible)
+        {
+            SDL_SetRenderDrawColor(game.renderer, BACKGROUND_COLOR_VALS, 255);
+            SDL_RenderClear(game.renderer);
+            render_frame();
+            if(game.is_profiler_overlay_visible) render_profiler_overlay();
+            SDL_RenderPresent(game.renderer);
+
+            PROFILER_END(PROFILER_SCOPE_FRAME);
+
+            game.needs_redraw = false;
+        }
 
         SDL_Delay(GAME_LOOP_DELAY_MS);
 
@@ -117,6 +188,13 @@ int main(int argc, char** argv)
 
 static void safe_exit()
 {
+    sui_text_cache_free();
+    render_profiler_overlay_free();
+    sui_element_set_free(&game.menu_elements);
+    sui_element_set_free(&game.selector_elements);
+
+    for (size_t i = 0; i < EDITOR_SECTION_COUNT; i++)
+        sui_element_set_free(&game.editor_section_elements[i]);
     assetman_finish(true);
 
     if(game.renderer != NULL) SDL_DestroyRenderer(game.renderer);
@@ -0,0 +1,123 @@
+#include "include/match.h"
+
+static size_t match_count_position(dynarray(zobrist_key_t)* position_hashes, zobrist_key_t position_hash);
+static uint64_t match_next_random(uint64_t* random_state);
+
+void match_player_init(match_player_t* player, const ruleset_t* rules, search_limits_t limits, bool plays_randomly)
+{
+    searcher_init(&player->searcher, rules);
+    player->limits = limits;
+    player->plays_randomly = plays_randomly;
+}
+
+void match_player_free(match_player_t* player)
+{
+    searcher_free(&player->searcher);
+}
+
+void match_play(match_t* match, const scenario_t* scenario, match_player_t* white_player, match_player_t* black_player, const match_settings_t* settings)
+{
+    dynarray(zobrist_key_t) position_hashes = dynarray_new(zobrist_key_t, 0);
+    board_t board = scenario->board;
+    team_t playing_team = scenario->team;
+    uint64_t random_state = settings->random_seed;
+    legal_move_list_t move_list;
+
+    /* What the searchers remember from earlier games would make the result depend on the order games are played in */
+    searcher_clear(&white_player->searcher);
+    searcher_clear(&black_player->searcher);
+
+    match->result = MATCH_RESULT_DRAW;
+    match->moves = dynarray_new(legal_move_t, 0);
+
+    for (;;)
+    {
+        team_t opponent_team = playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM;
+        uint8_t opponent_win = opponent_team == WHITE_TEAM ? MATCH_RESULT_WHITE_WIN : MATCH_RESULT_BLACK_WIN;
+
+        if(dynarray_size(&match->moves) >= settings->max_turns)
+        {
+            if(!board_contains_any_valid_moves_for_team(&scenario->rules, &board, playing_team)) match->result = opponent_win;
+            break;
+        }
+
+        zobrist_key_t position_hash = board_position_hash(&board, playing_team);
+
+        if(match_count_position(&position_hashes, position_hash) + 1 >= MATCH_REPETITION_LIMIT) break;
+
+        dynarray_add(&position_hashes, zobrist_key_t, &position_hash);
+
+        match_player_t* player = playing_team == WHITE_TEAM ? white_player : black_player;
+        legal_move_t move;
+
+        if(player->plays_randomly || dynarray_size(&match->moves) < settings->random_opening_turns)
+        {
+            board_generate_legal_moves(&scenario->rules, &board, playing_team, &move_list);
+
+            if(move_list.move_count == 0)
+            {
+                match->result = opponent_win;
+                break;
+            }
+
+            move = move_list.moves[match_next_random(&random_state) % move_list.move_count];
+        }
+        else
+        {
+            search_result_t search_result = searcher_find_best_move(&player->searcher, &board, playing_team, player->limits);
+
+            if(!search_result.has_move)
+            {
+                match->result = opponent_win;
+                break;
+            }
+
+            move = search_result.best_move;
+        }
+
+        board_play_legal_move(&scenario->rules, &board, &move);
+        dynarray_add(&match->moves, legal_move_t, &move);
+
+        playing_team = opponent_team;
+    }
+
+    dynarray_free(&position_hashes);
+}
+
+void match_free(match_t* match)
+{
+    dynarray_free(&match->moves);
+}
+
+const char* match_result_name(uint8_t result)
+{
+    switch (result)
+    {
+        case MATCH_RESULT_WHITE_WIN:
+            return "white wins";
+        case MATCH_RESULT_BLACK_WIN:
+            return "black wins";
+        default:
+            return "draw";
+    }
+}
+
+static size_t match_count_position(dynarray(zobrist_key_t)* position_hashes, zobrist_key_t position_hash)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < dynarray_size(position_hashes); i++)
+        if(dynarray_ele(position_hashes, zobrist_key_t, i) == position_hash) count++;
+
+    return count;
+}
+
+/* splitmix64, the state is the seed of the game so every game can be replayed from its settings */
+static uint64_t match_next_random(uint64_t* random_state)
+{
+    uint64_t z = (*random_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    return z ^ (z >> 31);
+}
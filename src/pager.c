@@ -4,6 +4,7 @@ void pager_init(pager_t* pager, size_t total_element_count, size_t max_elements_
 {
     pager->total_element_count = total_element_count;
     pager->max_elements_per_page = max_elements_per_page;
+    pager->current_page_start = 0;
     pager->current_page_end = 0;
 }
 
@@ -0,0 +1,25 @@
+#include "include/perft.h"
+
+uint64_t perft_count(const ruleset_t* rules, const board_t* board, team_t playing_team, unsigned depth, bool* out_has_truncated_move_list)
+{
+    if(depth == 0) return 1;
+
+    legal_move_list_t move_list;
+    board_generate_legal_moves(rules, board, playing_team, &move_list);
+
+    if(move_list.is_truncated) *out_has_truncated_move_list = true;
+
+    if(depth == 1) return move_list.move_count;
+
+    uint64_t node_count = 0;
+
+    for (size_t i = 0; i < move_list.move_count; i++)
+    {
+        board_t next_board = *board;
+        board_play_legal_move(rules, &next_board, &move_list.moves[i]);
+
+        node_count += perft_count(rules, &next_board, playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM, depth - 1, out_has_truncated_move_list);
+    }
+
+    return node_count;
+}
@@ -0,0 +1,48 @@
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <time.h>
+
+#include "include/platform.h"
+
+size_t platform_processor_count(size_t fallback_count)
+{
+#ifdef _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+
+    return system_info.dwNumberOfProcessors > 0 ? (size_t)system_info.dwNumberOfProcessors : fallback_count;
+#else
+    long processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return processor_count > 0 ? (size_t)processor_count : fallback_count;
+#endif
+}
+
+uint64_t platform_now_nanoseconds()
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    uint64_t ticks = (uint64_t)counter.QuadPart;
+    uint64_t ticks_per_second = (uint64_t)frequency.QuadPart;
+
+    return ticks / ticks_per_second * 1000000000u + ticks % ticks_per_second * 1000000000u / ticks_per_second;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+double platform_now_seconds()
+{
+    return (double)platform_now_nanoseconds() / 1e9;
+}
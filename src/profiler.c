@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "include/profiler.h"
+#include "include/platform.h"
+
+typedef struct
+{
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    uint32_t thread_id;
+    uint32_t scope;
+} profiler_event_t;
+
+typedef struct
+{
+    uint32_t durations_us [PROFILER_SCOPE_HISTORY_SIZE];
+    size_t next_index;
+    size_t sample_count;
+} profiler_history_t;
+
+/* Samples are only recorded by a handful of threads, a spin lock around the few stores of a sample is enough */
+static struct
+{
+    atomic_bool is_recording;
+    atomic_flag lock;
+    atomic_uint next_thread_id;
+    uint64_t base_ns;
+
+    profiler_history_t histories [PROFILER_SCOPE_COUNT];
+
+    profiler_event_t events [PROFILER_TRACE_CAPACITY];
+    size_t event_count;
+} profiler = { .lock = ATOMIC_FLAG_INIT };
+
+static _Thread_local uint32_t profiler_thread_id;
+
+static const char* const profiler_scope_names [PROFILER_SCOPE_COUNT] =
+{
+    "Frame",
+    "Update",
+    "Render",
+    "SUI draw",
+    "Capture tree",
+    "Scenario load",
+    "Scenario index",
+    "Thumbnail decode",
+    "Thumbnail upload"
+};
+
+static uint64_t profiler_now_ns();
+static uint32_t profiler_current_thread_id();
+static void profiler_lock();
+static void profiler_unlock();
+static size_t profiler_copy_history(profiler_scope_t scope, uint32_t* out_durations);
+static int profiler_compare_durations(const void* a, const void* b);
+
+void profiler_init()
+{
+    profiler.base_ns = profiler_now_ns();
+    atomic_store(&profiler.next_thread_id, 1);
+
+    profiler_current_thread_id();
+
+    atomic_store(&profiler.is_recording, true);
+}
+
+uint64_t profiler_begin()
+{
+    if(!atomic_load_explicit(&profiler.is_recording, memory_order_relaxed)) return 0;
+
+    return profiler_now_ns();
+}
+
+void profiler_end(profiler_scope_t scope, uint64_t start_ns)
+{
+    if(start_ns == 0) return;
+
+    uint64_t duration_ns = profiler_now_ns() - start_ns;
+    uint64_t duration_us = duration_ns / 1000;
+    uint32_t thread_id = profiler_current_thread_id();
+
+    profiler_lock();
+
+    profiler_history_t* history = &profiler.histories[scope];
+
+    history->durations_us[history->next_index] = duration_us > UINT32_MAX ? UINT32_MAX : (uint32_t)duration_us;
+    history->next_index = (history->next_index + 1) % PROFILER_SCOPE_HISTORY_SIZE;
+    if(history->sample_count < PROFILER_SCOPE_HISTORY_SIZE) history->sample_count++;
+
+    profiler.events[profiler.event_count & (PROFILER_TRACE_CAPACITY - 1)] = (profiler_event_t){ start_ns, duration_ns, thread_id, (uint32_t)scope };
+    profiler.event_count++;
+
+    profiler_unlock();
+}
+
+const char* profiler_scope_name(profiler_scope_t scope)
+{
+    return profiler_scope_names[scope];
+}
+
+void profiler_scope_stats(profiler_scope_t scope, profiler_stats_t* out_stats)
+{
+    uint32_t durations [PROFILER_SCOPE_HISTORY_SIZE];
+    size_t count = profiler_copy_history(scope, durations);
+
+    *out_stats = (profiler_stats_t){0};
+    out_stats->sample_count = count;
+
+    if(count == 0) return;
+
+    qsort(durations, count, sizeof(uint32_t), profiler_compare_durations);
+
+    out_stats->p50_us = durations[(count - 1) / 2];
+    out_stats->p99_us = durations[(count - 1) * 99 / 100];
+    out_stats->max_us = durations[count - 1];
+}
+
+uint32_t profiler_scope_histogram(profiler_scope_t scope, uint32_t* out_buckets, size_t bucket_count, uint32_t bucket_width_us)
+{
+    uint32_t durations [PROFILER_SCOPE_HISTORY_SIZE];
+    size_t count = profiler_copy_history(scope, durations);
+    uint32_t fullest_count = 0;
+
+    memset(out_buckets, 0, bucket_count * sizeof(uint32_t));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t bucket = durations[i] / bucket_width_us;
+        if(bucket >= bucket_count) bucket = bucket_count - 1;
+
+        out_buckets[bucket]++;
+        if(out_buckets[bucket] > fullest_count) fullest_count = out_buckets[bucket];
+    }
+
+    return fullest_count;
+}
+
+bool profiler_export_trace(const char* file_path)
+{
+    FILE* f = fopen(file_path, "w");
+
+    if(f == NULL) return false;
+
+    /* Copied first so the recording threads do not wait for the file */
+    profiler_event_t* events = malloc(PROFILER_TRACE_CAPACITY * sizeof(profiler_event_t));
+
+    if(events == NULL)
+    {
+        fclose(f);
+        return false;
+    }
+
+    profiler_lock();
+
+    size_t event_count = profiler.event_count < PROFILER_TRACE_CAPACITY ? profiler.event_count : PROFILER_TRACE_CAPACITY;
+    size_t first_event = profiler.event_count - event_count;
+
+    for (size_t i = 0; i < event_count; i++)
+        events[i] = profiler.events[(first_event + i) & (PROFILER_TRACE_CAPACITY - 1)];
+
+    profiler_unlock();
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    fputs("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Main\"}}", f);
+
+    for (size_t i = 0; i < event_count; i++)
+    {
+        const profiler_event_t* event = &events[i];
+
+        fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            profiler_scope_names[event->scope], (unsigned)event->thread_id,
+            (double)(event->start_ns - profiler.base_ns) / 1000.0, (double)event->duration_ns / 1000.0);
+    }
+
+    fputs("\n]}\n", f);
+
+    free(events);
+
+    return fclose(f) == 0;
+}
+
+static uint64_t profiler_now_ns()
+{
+    return platform_now_nanoseconds();
+}
+
+static uint32_t profiler_current_thread_id()
+{
+    if(profiler_thread_id == 0) profiler_thread_id = atomic_fetch_add(&profiler.next_thread_id, 1);
+
+    return profiler_thread_id;
+}
+
+static void profiler_lock()
+{
+    while(atomic_flag_test_and_set_explicit(&profiler.lock, memory_order_acquire));
+}
+
+static void profiler_unlock()
+{
+    atomic_flag_clear_explicit(&profiler.lock, memory_order_release);
+}
+
+static size_t profiler_copy_history(profiler_scope_t scope, uint32_t* out_durations)
+{
+    profiler_lock();
+
+    const profiler_history_t* history = &profiler.histories[scope];
+    size_t count = history->sample_count;
+
+    memcpy(out_durations, history->durations_us, count * sizeof(uint32_t));
+
+    profiler_unlock();
+
+    return count;
+}
+
+static int profiler_compare_durations(const void* a, const void* b)
+{
+    uint32_t first = *(const uint32_t*)a;
+    uint32_t second = *(const uint32_t*)b;
+
+    return (first > second) - (first < second);
+}
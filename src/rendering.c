@@ -1,16 +1,24 @@
 #include "include/assetman_setup.h"
 #include "include/rendering.h"
 #include "include/sui.h"
+#include "include/profiler.h"
 
-static void render_piece(cell_value_t piece, int x, int y);
+static void piece_quad_add(cell_value_t piece, int x, int y, SDL_Vertex* vertices, int* indices, int first_vertex);
 static void render_board(board_t* board);
+static void render_board_pattern(const SDL_Rect* board_rect);
 static void render_board_pieces(board_t* board);
 static void render_cell(cell_id_t cell, Uint8 r, Uint8 g, Uint8 b);
 static void render_frame_scenario();
 static void render_frame_editor();
+static void render_profiler_overlay_refresh();
+
+static SDL_Texture* profiler_overlay_lines [PROFILER_SCOPE_COUNT];
+static Uint32 profiler_overlay_refresh_time;
 
 void render_frame()
 {
+    PROFILER_BEGIN(PROFILER_SCOPE_RENDER_FRAME);
+
     switch (game.mode)
     {
         case MODE_MENU:
@@ -28,6 +36,8 @@ void render_frame()
         default:
             break;
     }
+
+    PROFILER_END(PROFILER_SCOPE_RENDER_FRAME);
 }
 
 void render_only_board()
@@ -36,36 +46,32 @@ void render_only_board()
     render_board_pieces(&game.scenario_data.board);
 }
 
-static void render_piece(cell_value_t piece, int x, int y)
+static void piece_quad_add(cell_value_t piece, int x, int y, SDL_Vertex* vertices, int* indices, int first_vertex)
 {
-    SDL_Rect piece_rect;
-    piece_rect.x = game.screen_scenario_board_rect.x + x * CELL_WIDTH + PIECE_PIXEL_OFFSET_X;
-    piece_rect.y = game.screen_scenario_board_rect.y + y * CELL_HEIGHT + PIECE_PIXEL_OFFSET_Y; 
-    piece_rect.w = PIECE_WIDTH; 
-    piece_rect.h = PIECE_HEIGHT;
-    
-    switch (piece)
-    {
-        case PIECE_WHITE_PEON:
-            SDL_RenderCopy(game.renderer, assetman_get_asset("$WhitePeon"), NULL, &piece_rect);
-            break;
-        case PIECE_WHITE_QUEEN:
-            SDL_RenderCopy(game.renderer, assetman_get_asset("$WhiteQueen"), NULL, &piece_rect);
-            break;
-        case PIECE_BLACK_PEON:
-            SDL_RenderCopy(game.renderer, assetman_get_asset("$BlackPeon"), NULL, &piece_rect);
-            break;
-        case PIECE_BLACK_QUEEN:
-            SDL_RenderCopy(game.renderer, assetman_get_asset("$BlackQueen"), NULL, &piece_rect);
-            break;
-    }
+    const SDL_Color color = { 255, 255, 255, 255 };
+    SDL_FRect source_rect = piece_atlas_source_rect(piece);
 
-    SDL_SetRenderDrawColor(game.renderer, WHITE_CELLS_COLOR_VALS, 255);
+    float left = (float)(game.screen_scenario_board_rect.x + x * CELL_WIDTH + PIECE_PIXEL_OFFSET_X);
+    float top = (float)(game.screen_scenario_board_rect.y + y * CELL_HEIGHT + PIECE_PIXEL_OFFSET_Y);
+    float right = left + (float)PIECE_WIDTH;
+    float bottom = top + (float)PIECE_HEIGHT;
+
+    vertices[0] = (SDL_Vertex){ { left, top }, color, { source_rect.x, source_rect.y } };
+    vertices[1] = (SDL_Vertex){ { right, top }, color, { source_rect.x + source_rect.w, source_rect.y } };
+    vertices[2] = (SDL_Vertex){ { right, bottom }, color, { source_rect.x + source_rect.w, source_rect.y + source_rect.h } };
+    vertices[3] = (SDL_Vertex){ { left, bottom }, color, { source_rect.x, source_rect.y + source_rect.h } };
+
+    indices[0] = first_vertex;
+    indices[1] = first_vertex + 1;
+    indices[2] = first_vertex + 2;
+    indices[3] = first_vertex;
+    indices[4] = first_vertex + 2;
+    indices[5] = first_vertex + 3;
 }
 
 static void render_cell(cell_id_t cell, Uint8 r, Uint8 g, Uint8 b)
 {
-    board_position_t cell_position = cell_id_to_cell_position(cell);
+    board_position_t cell_position = cell_id_to_cell_position(&game.scenario_data.rules, cell);
     
     SDL_Rect cell_rect;
     cell_rect.x = game.screen_scenario_board_rect.x + cell_position.x * CELL_WIDTH;
@@ -79,31 +85,71 @@ static void render_cell(cell_id_t cell, Uint8 r, Uint8 g, Uint8 b)
 
 static void render_board(board_t* board)
 {
-    bool is_playable_cell = !game.scenario_data.double_corner_on_right;
+    SDL_Rect board_rect;
+    board_rect.x = game.screen_scenario_board_rect.x;
+    board_rect.y = game.screen_scenario_board_rect.y;
+    board_rect.w = game.scenario_data.rules.board_side_size * CELL_WIDTH;
+    board_rect.h = game.scenario_data.rules.board_side_size * CELL_HEIGHT;
 
-    SDL_Rect cell_rect;
-    cell_rect.w = CELL_WIDTH;
-    cell_rect.h = CELL_HEIGHT;
+    if(game.board_background != NULL)
+        SDL_RenderCopy(game.renderer, game.board_background, NULL, &board_rect);
+    else
+        render_board_pattern(&board_rect);
+}
+
+void render_board_background_build()
+{
+    render_board_background_free();
+
+    SDL_Rect board_rect = { 0, 0, game.scenario_data.rules.board_side_size * CELL_WIDTH, game.scenario_data.rules.board_side_size * CELL_HEIGHT };
+
+    game.board_background = SDL_CreateTexture(game.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, board_rect.w, board_rect.h);
+
+    /* Without render targets the pattern keeps being drawn every frame */
+    if(game.board_background == NULL)
+    {
+        LOGGER_LOGF("Could not create the board background texture, %s", SDL_GetError());
+        return;
+    }
+
+    SDL_SetRenderTarget(game.renderer, game.board_background);
+    render_board_pattern(&board_rect);
+    SDL_SetRenderTarget(game.renderer, NULL);
+
+    game_invalidate();
+}
+
+void render_board_background_free()
+{
+    if(game.board_background == NULL) return;
+
+    SDL_DestroyTexture(game.board_background);
+    game.board_background = NULL;
+}
+
+/* The whole board is filled with the color of the unplayable cells, the playable ones go out in a single batch over it */
+static void render_board_pattern(const SDL_Rect* board_rect)
+{
+    bool is_playable_cell = !game.scenario_data.rules.double_corner_on_right;
+
+    SDL_Rect playable_cell_rects [MAX_BOARD_PLAYABLE_CELL_COUNT];
+    int playable_cell_count = 0;
 
     board_unit_t x;
     board_unit_t y;
 
-    for(y = 0; y < game.scenario_data.board_side_size; y++)
+    for(y = 0; y < game.scenario_data.rules.board_side_size; y++)
     {
-        for(x = 0; x < game.scenario_data.board_side_size; x++)
+        for(x = 0; x < game.scenario_data.rules.board_side_size; x++)
         {
-            cell_rect.x = game.screen_scenario_board_rect.x + x * CELL_WIDTH;
-            cell_rect.y = game.screen_scenario_board_rect.y + y * CELL_HEIGHT;
-
             if(is_playable_cell) 
             {   
-                SDL_SetRenderDrawColor(game.renderer, WHITE_CELLS_COLOR_VALS, 255);
-                SDL_RenderFillRect(game.renderer, &cell_rect);
-            }
-            else
-            {
-                SDL_SetRenderDrawColor(game.renderer, BLACK_CELLS_COLOR_VALS, 255);
-                SDL_RenderFillRect(game.renderer, &cell_rect);
+                SDL_Rect* cell_rect = &playable_cell_rects[playable_cell_count++];
+
+                cell_rect->x = board_rect->x + x * CELL_WIDTH;
+                cell_rect->y = board_rect->y + y * CELL_HEIGHT;
+                cell_rect->w = CELL_WIDTH;
+                cell_rect->h = CELL_HEIGHT;
             }
             
             is_playable_cell = !is_playable_cell;
@@ -111,25 +157,39 @@ static void render_board(board_t* board)
 
         is_playable_cell = !is_playable_cell;
     }
+
+    SDL_SetRenderDrawColor(game.renderer, BLACK_CELLS_COLOR_VALS, 255);
+    SDL_RenderFillRect(game.renderer, board_rect);
+
+    SDL_SetRenderDrawColor(game.renderer, WHITE_CELLS_COLOR_VALS, 255);
+    SDL_RenderFillRects(game.renderer, playable_cell_rects, playable_cell_count);
 }
 
+/* Every piece is a quad textured from the piece atlas, so the whole board takes one draw call */
 static void render_board_pieces(board_t* board)
 {
-    bool is_playable_cell = !game.scenario_data.double_corner_on_right;
+    bool is_playable_cell = !game.scenario_data.rules.double_corner_on_right;
+
+    SDL_Vertex vertices [MAX_BOARD_PLAYABLE_CELL_COUNT * 4];
+    int indices [MAX_BOARD_PLAYABLE_CELL_COUNT * 6];
+    int piece_count = 0;
 
     board_unit_t x;
     board_unit_t y;
 
     cell_id_t cell_index = 0;
 
-    for(y = 0; y < game.scenario_data.board_side_size; y++)
+    for(y = 0; y < game.scenario_data.rules.board_side_size; y++)
     {
-        for(x = 0; x < game.scenario_data.board_side_size; x++)
+        for(x = 0; x < game.scenario_data.rules.board_side_size; x++)
         {
             if(is_playable_cell) 
             {   
                 if(board->playable_cells[cell_index] != NO_PIECE)
-                    render_piece(board->playable_cells[cell_index], x, y);
+                {
+                    piece_quad_add(board->playable_cells[cell_index], x, y, &vertices[piece_count * 4], &indices[piece_count * 6], piece_count * 4);
+                    piece_count++;
+                }
                 
                 cell_index++;
             }
@@ -139,6 +199,9 @@ static void render_board_pieces(board_t* board)
 
         is_playable_cell = !is_playable_cell;
     }
+
+    if(piece_count > 0)
+        SDL_RenderGeometry(game.renderer, assetman_get_asset_by_handle(piece_atlas.texture_handle), vertices, piece_count * 4, indices, piece_count * 6);
 }
 
 static void render_frame_scenario()
@@ -171,4 +234,101 @@ static void render_frame_editor()
     
     render_board_pieces(&game.scenario_data.board);
     sui_draw_elements(game.renderer);
-}
\ No newline at end of file
+}
+
+void render_profiler_overlay()
+{
+    const int line_height = 32;
+    const int bar_width = 16;
+    const int histogram_height = 120;
+    const int margin = 10;
+
+    Uint32 now = SDL_GetTicks();
+
+    if(profiler_overlay_refresh_time == 0 || now - profiler_overlay_refresh_time >= PROFILER_OVERLAY_REFRESH_MS)
+    {
+        render_profiler_overlay_refresh();
+        profiler_overlay_refresh_time = now;
+    }
+
+    uint32_t buckets [PROFILER_OVERLAY_BUCKET_COUNT];
+    uint32_t fullest_count = profiler_scope_histogram(PROFILER_SCOPE_FRAME, buckets, PROFILER_OVERLAY_BUCKET_COUNT, PROFILER_OVERLAY_BUCKET_WIDTH_US);
+
+    SDL_Rect panel_rect = { margin, margin, 2 * margin + PROFILER_OVERLAY_BUCKET_COUNT * bar_width, 0 };
+    panel_rect.w = panel_rect.w < 640 ? 640 : panel_rect.w;
+    panel_rect.h = 3 * margin + PROFILER_SCOPE_COUNT * line_height + histogram_height;
+
+    SDL_BlendMode previous_blend_mode;
+    SDL_GetRenderDrawBlendMode(game.renderer, &previous_blend_mode);
+    SDL_SetRenderDrawBlendMode(game.renderer, SDL_BLENDMODE_BLEND);
+
+    SDL_SetRenderDrawColor(game.renderer, 0, 0, 0, 200);
+    SDL_RenderFillRect(game.renderer, &panel_rect);
+
+    int y = panel_rect.y + margin;
+
+    for (size_t i = 0; i < PROFILER_SCOPE_COUNT; i++)
+    {
+        if(profiler_overlay_lines[i] == NULL) continue;
+
+        SDL_Rect line_rect = sui_get_texture_rect(profiler_overlay_lines[i], panel_rect.x + margin, y);
+        SDL_RenderCopy(game.renderer, profiler_overlay_lines[i], NULL, &line_rect);
+
+        y += line_height;
+    }
+
+    int histogram_bottom = panel_rect.y + panel_rect.h - margin;
+
+    for (int i = 0; i < PROFILER_OVERLAY_BUCKET_COUNT && fullest_count > 0; i++)
+    {
+        int bar_height = (int)((uint64_t)buckets[i] * (uint64_t)histogram_height / fullest_count);
+        SDL_Rect bar_rect = { panel_rect.x + margin + i * bar_width, histogram_bottom - bar_height, bar_width - 2, bar_height };
+
+        if((i + 1) * PROFILER_OVERLAY_BUCKET_WIDTH_US <= PROFILER_OVERLAY_FRAME_BUDGET_US)
+            SDL_SetRenderDrawColor(game.renderer, 90, 200, 90, 255);
+        else
+            SDL_SetRenderDrawColor(game.renderer, 220, 70, 70, 255);
+
+        SDL_RenderFillRect(game.renderer, &bar_rect);
+    }
+
+    int budget_x = panel_rect.x + margin + PROFILER_OVERLAY_FRAME_BUDGET_US * bar_width / PROFILER_OVERLAY_BUCKET_WIDTH_US;
+
+    SDL_SetRenderDrawColor(game.renderer, 255, 255, 255, 255);
+    SDL_RenderDrawLine(game.renderer, budget_x, histogram_bottom - histogram_height, budget_x, histogram_bottom);
+
+    SDL_SetRenderDrawBlendMode(game.renderer, previous_blend_mode);
+}
+
+void render_profiler_overlay_free()
+{
+    for (size_t i = 0; i < PROFILER_SCOPE_COUNT; i++)
+    {
+        if(profiler_overlay_lines[i] != NULL) SDL_DestroyTexture(profiler_overlay_lines[i]);
+        profiler_overlay_lines[i] = NULL;
+    }
+
+    profiler_overlay_refresh_time = 0;
+}
+
+/* Scopes which were never reached get no line */
+static void render_profiler_overlay_refresh()
+{
+    TTF_Font* font = assetman_get_asset("$Font26pt");
+    char line [128];
+
+    render_profiler_overlay_free();
+
+    for (size_t i = 0; i < PROFILER_SCOPE_COUNT; i++)
+    {
+        profiler_stats_t stats;
+        profiler_scope_stats((profiler_scope_t)i, &stats);
+
+        if(stats.sample_count == 0) continue;
+
+        snprintf(line, sizeof(line), "%s: p50 %.2f ms, p99 %.2f ms, max %.2f ms",
+            profiler_scope_name((profiler_scope_t)i), stats.p50_us / 1000.0, stats.p99_us / 1000.0, stats.max_us / 1000.0);
+
+        profiler_overlay_lines[i] = sui_texture_from_text(game.renderer, font, line, (SDL_Color){ 255, 255, 255, 255 });
+    }
+}
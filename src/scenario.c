@@ -0,0 +1,35 @@
+#include "include/scenario.h"
+
+void scenario_set_default(scenario_t* scenario)
+{
+    scenario->scenario_mode = SCENARIO_MODE_1V1;
+    scenario->team = WHITE_TEAM;
+    scenario->computer_team = NO_TEAM;
+    scenario->rules.board_side_size = 8;
+    scenario->rules.flying_kings = true;
+    scenario->rules.peons_capture_backwards = false;
+    scenario->rules.is_white_peon_forward_top_to_bottom = false;
+    scenario->rules.applies_law_of_quantity = true;
+    scenario->rules.applies_law_of_quality = false;
+    scenario->rules.double_corner_on_right = true;
+    board_clear(&scenario->board);
+    scenario->challenge_moves = array_stt(0, NULL);
+}
+
+size_t scenario_challenge_turn_length(scenario_t* scenario, size_t first_move_index)
+{
+    size_t move_count = array_size(&scenario->challenge_moves);
+    size_t last_move_index = first_move_index;
+
+    while(last_move_index + 1 < move_count)
+    {
+        move_info_t move = array_ele(&scenario->challenge_moves, move_info_t, last_move_index);
+        move_info_t next_move = array_ele(&scenario->challenge_moves, move_info_t, last_move_index + 1);
+
+        if(move.destination_cell != next_move.source_cell) break;
+
+        last_move_index++;
+    }
+
+    return last_move_index - first_move_index + 1;
+}
@@ -0,0 +1,293 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/scenario_binary.h"
+#include "include/geometry.h"
+#include "include/logger.h"
+
+static bool scenario_binary_records_fit(const scenario_binary_library_t* library);
+static bool scenario_binary_record_is_valid(const scenario_binary_record_t* record);
+static uint8_t scenario_binary_rule_flags(const ruleset_t* rules);
+static size_t scenario_binary_record_size(size_t challenge_move_count);
+static size_t scenario_binary_challenge_move_count(const scenario_t* scenario);
+
+bool scenario_binary_open(scenario_binary_library_t* library, const char* path)
+{
+    if(!file_mapping_open(&library->mapping, path)) return false;
+
+    library->header = library->mapping.data;
+    library->record_offsets = (const uint64_t*)(library->header + 1);
+
+    if(library->mapping.size < sizeof(scenario_binary_file_header_t) ||
+        memcmp(library->header->magic, SCENARIO_BINARY_FILE_MAGIC, sizeof(library->header->magic)) != 0 ||
+        library->header->version != SCENARIO_BINARY_VERSION ||
+        !scenario_binary_records_fit(library))
+    {
+        file_mapping_close(&library->mapping);
+        return false;
+    }
+
+    return true;
+}
+
+void scenario_binary_close(scenario_binary_library_t* library)
+{
+    file_mapping_close(&library->mapping);
+
+    library->header = NULL;
+    library->record_offsets = NULL;
+}
+
+size_t scenario_binary_count(const scenario_binary_library_t* library)
+{
+    return library->header->scenario_count;
+}
+
+const scenario_binary_record_t* scenario_binary_record(const scenario_binary_library_t* library, size_t index)
+{
+    return (const scenario_binary_record_t*)((const uint8_t*)library->mapping.data + library->record_offsets[index]);
+}
+
+const scenario_binary_move_t* scenario_binary_record_moves(const scenario_binary_record_t* record)
+{
+    return (const scenario_binary_move_t*)(record + 1);
+}
+
+ruleset_t scenario_binary_record_rules(const scenario_binary_record_t* record)
+{
+    ruleset_t rules;
+
+    rules.board_side_size = record->board_side_size;
+    rules.double_corner_on_right = record->rule_flags & SCENARIO_BINARY_RULE_DOUBLE_CORNER_ON_RIGHT;
+    rules.applies_law_of_quantity = record->rule_flags & SCENARIO_BINARY_RULE_LAW_OF_QUANTITY;
+    rules.applies_law_of_quality = record->rule_flags & SCENARIO_BINARY_RULE_LAW_OF_QUALITY;
+    rules.peons_capture_backwards = record->rule_flags & SCENARIO_BINARY_RULE_PEONS_CAPTURE_BACKWARDS;
+    rules.flying_kings = record->rule_flags & SCENARIO_BINARY_RULE_FLYING_KINGS;
+    rules.is_white_peon_forward_top_to_bottom = record->rule_flags & SCENARIO_BINARY_RULE_WHITE_FORWARD_TOP_TO_BOTTOM;
+
+    return rules;
+}
+
+bool scenario_binary_record_to_scenario(const scenario_binary_record_t* record, scenario_t* out_scenario)
+{
+    if(!scenario_binary_record_is_valid(record)) return false;
+
+    out_scenario->rules = scenario_binary_record_rules(record);
+    out_scenario->board = record->board;
+    out_scenario->board.hash = board_compute_hash(&out_scenario->board);
+    out_scenario->team = record->team;
+    out_scenario->scenario_mode = record->scenario_mode;
+    out_scenario->computer_team = record->computer_team;
+
+    if(record->scenario_mode != SCENARIO_MODE_CHALLENGE)
+    {
+        out_scenario->challenge_moves = array_stt(0, NULL);
+        return true;
+    }
+
+    const scenario_binary_move_t* moves = scenario_binary_record_moves(record);
+    out_scenario->challenge_moves = array_new(move_info_t, record->challenge_move_count);
+
+    for (uint32_t i = 0; i < record->challenge_move_count; i++)
+    {
+        move_info_t* move = rrr_array_ele(&out_scenario->challenge_moves, sizeof(move_info_t), i);
+
+        move->source_cell = moves[i].source_cell;
+        move->destination_cell = moves[i].destination_cell;
+        move->is_capture_move = moves[i].capture_cell != NO_CELL;
+        move->capture_cell = move->is_capture_move ? moves[i].capture_cell : 0;
+    }
+
+    return true;
+}
+
+bool scenario_binary_write_file(const char* path, const scenario_binary_entry_t* entries, size_t entry_count)
+{
+    FILE* f = fopen(path, "wb");
+
+    if(f == NULL) return false;
+
+    scenario_binary_file_header_t header = {0};
+    memcpy(header.magic, SCENARIO_BINARY_FILE_MAGIC, sizeof(header.magic));
+    header.version = SCENARIO_BINARY_VERSION;
+    header.scenario_count = (uint32_t)entry_count;
+
+    bool is_written = fwrite(&header, sizeof(header), 1, f) == 1;
+    uint64_t record_offset = sizeof(header) + entry_count * sizeof(uint64_t);
+
+    for (size_t i = 0; i < entry_count && is_written; i++)
+    {
+        is_written = fwrite(&record_offset, sizeof(record_offset), 1, f) == 1;
+        record_offset += scenario_binary_record_size(scenario_binary_challenge_move_count(entries[i].scenario));
+    }
+
+    for (size_t i = 0; i < entry_count && is_written; i++)
+    {
+        const scenario_t* scenario = entries[i].scenario;
+        size_t challenge_move_count = scenario_binary_challenge_move_count(scenario);
+        scenario_binary_record_t record;
+
+        memset(&record, 0, sizeof(record));
+        record.board = scenario->board;
+        record.challenge_move_count = (uint32_t)challenge_move_count;
+        record.board_side_size = scenario->rules.board_side_size;
+        record.rule_flags = scenario_binary_rule_flags(&scenario->rules);
+        record.team = scenario->team;
+        record.scenario_mode = scenario->scenario_mode;
+        record.computer_team = scenario->computer_team;
+
+        if(entries[i].name != NULL) snprintf(record.name, SCENARIO_BINARY_NAME_SIZE, "%s", entries[i].name);
+        if(entries[i].icon_path != NULL) snprintf(record.icon_path, SCENARIO_BINARY_ICON_PATH_SIZE, "%s", entries[i].icon_path);
+
+        is_written = fwrite(&record, sizeof(record), 1, f) == 1;
+
+        const move_info_t* challenge_moves = scenario->challenge_moves.data;
+
+        for (size_t j = 0; j < challenge_move_count && is_written; j++)
+        {
+            scenario_binary_move_t move = { challenge_moves[j].source_cell, challenge_moves[j].destination_cell, NO_CELL, 0 };
+
+            if(challenge_moves[j].is_capture_move) move.capture_cell = challenge_moves[j].capture_cell;
+
+            is_written = fwrite(&move, sizeof(move), 1, f) == 1;
+        }
+    }
+
+    return fclose(f) == 0 && is_written;
+}
+
+void load_scenario_from_binary_file(scenario_t* destination, const char* file_path)
+{
+    if(!try_load_scenario_from_binary_file(destination, file_path)) exit(EXIT_FAILURE);
+}
+
+bool try_load_scenario_from_binary_file(scenario_t* destination, const char* file_path)
+{
+    scenario_binary_library_t library;
+
+    if(!scenario_binary_open(&library, file_path))
+    {
+        LOGGER_ERRORF("Could not load compiled scenario file \'%s\'!", file_path);
+        return false;
+    }
+
+    size_t scenario_count = scenario_binary_count(&library);
+
+    if(scenario_count != 1)
+    {
+        LOGGER_ERRORF("Compiled scenario file \'%s\' holds %zu scenarios, only a single scenario can be loaded from it!", file_path, scenario_count);
+        scenario_binary_close(&library);
+        return false;
+    }
+
+    bool is_loaded = scenario_binary_record_to_scenario(scenario_binary_record(&library, 0), destination);
+    scenario_binary_close(&library);
+
+    if(!is_loaded) LOGGER_ERRORF("Could not load compiled scenario file \'%s\'!", file_path);
+
+    return is_loaded;
+}
+
+static bool scenario_binary_records_fit(const scenario_binary_library_t* library)
+{
+    size_t file_size = library->mapping.size;
+    size_t scenario_count = library->header->scenario_count;
+
+    if((file_size - sizeof(scenario_binary_file_header_t)) / sizeof(uint64_t) < scenario_count) return false;
+
+    for (size_t i = 0; i < scenario_count; i++)
+    {
+        uint64_t record_offset = library->record_offsets[i];
+
+        if(record_offset % sizeof(uint64_t) != 0 || record_offset > file_size || file_size - record_offset < sizeof(scenario_binary_record_t))
+            return false;
+
+        const scenario_binary_record_t* record = scenario_binary_record(library, i);
+
+        if(file_size - record_offset < scenario_binary_record_size(record->challenge_move_count)) return false;
+    }
+
+    return true;
+}
+
+/* Applies the limits the text loader enforces, a record is trusted no more than a .sch file */
+static bool scenario_binary_record_is_valid(const scenario_binary_record_t* record)
+{
+    const board_geometry_t* geometry = board_geometry_get(record->board_side_size, record->rule_flags & SCENARIO_BINARY_RULE_DOUBLE_CORNER_ON_RIGHT);
+
+    if(geometry == NULL)
+    {
+        LOGGER_ERRORF("Board size %d is not supported!", record->board_side_size);
+        return false;
+    }
+
+    if(record->team != WHITE_TEAM && record->team != BLACK_TEAM)
+    {
+        LOGGER_ERRORF("Value %d does not represent a valid team value!", record->team);
+        return false;
+    }
+
+    if(record->computer_team != NO_TEAM && record->computer_team != WHITE_TEAM && record->computer_team != BLACK_TEAM)
+    {
+        LOGGER_ERRORF("Value %d does not represent a valid computer team!", record->computer_team);
+        return false;
+    }
+
+    if(record->scenario_mode != SCENARIO_MODE_1V1 && record->scenario_mode != SCENARIO_MODE_CHALLENGE)
+    {
+        LOGGER_ERRORF("Value %d does not represent a possible scenario type!", record->scenario_mode);
+        return false;
+    }
+
+    for (cell_id_t i = 0; i < MAX_BOARD_PLAYABLE_CELL_COUNT; i++)
+    {
+        cell_value_t piece_type = record->board.playable_cells[i];
+
+        if(piece_type < PIECE_BLACK_QUEEN || piece_type > PIECE_BLACK_PEON || (i >= geometry->playable_cell_count && piece_type != NO_PIECE))
+        {
+            LOGGER_ERRORF("Cell %d holds %d, which is not a valid piece type on this board!", i + 1, piece_type);
+            return false;
+        }
+    }
+
+    if(record->scenario_mode != SCENARIO_MODE_CHALLENGE) return true;
+
+    const scenario_binary_move_t* moves = scenario_binary_record_moves(record);
+
+    for (uint32_t i = 0; i < record->challenge_move_count; i++)
+    {
+        if(moves[i].source_cell >= geometry->playable_cell_count || moves[i].destination_cell >= geometry->playable_cell_count ||
+            (moves[i].capture_cell != NO_CELL && moves[i].capture_cell >= geometry->playable_cell_count))
+        {
+            LOGGER_ERRORF("Challenge move %u uses a cell outside of the board!", i + 1);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static uint8_t scenario_binary_rule_flags(const ruleset_t* rules)
+{
+    uint8_t rule_flags = 0;
+
+    if(rules->double_corner_on_right) rule_flags |= SCENARIO_BINARY_RULE_DOUBLE_CORNER_ON_RIGHT;
+    if(rules->applies_law_of_quantity) rule_flags |= SCENARIO_BINARY_RULE_LAW_OF_QUANTITY;
+    if(rules->applies_law_of_quality) rule_flags |= SCENARIO_BINARY_RULE_LAW_OF_QUALITY;
+    if(rules->peons_capture_backwards) rule_flags |= SCENARIO_BINARY_RULE_PEONS_CAPTURE_BACKWARDS;
+    if(rules->flying_kings) rule_flags |= SCENARIO_BINARY_RULE_FLYING_KINGS;
+    if(rules->is_white_peon_forward_top_to_bottom) rule_flags |= SCENARIO_BINARY_RULE_WHITE_FORWARD_TOP_TO_BOTTOM;
+
+    return rule_flags;
+}
+
+static size_t scenario_binary_record_size(size_t challenge_move_count)
+{
+    return sizeof(scenario_binary_record_t) + challenge_move_count * sizeof(scenario_binary_move_t);
+}
+
+static size_t scenario_binary_challenge_move_count(const scenario_t* scenario)
+{
+    return scenario->scenario_mode == SCENARIO_MODE_CHALLENGE ? scenario->challenge_moves.size : 0;
+}
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "include/scenario_index.h"
+#include "include/profiler.h"
+
+static scenario_index_entry_t* scenario_index_load(string_t index_path, size_t* out_entry_count);
+static void scenario_index_save(string_t index_path, const scenario_index_entry_t* entries, size_t entry_count);
+static bool scenario_index_stat_file(string_t path, scenario_index_entry_t* entry);
+static int scenario_index_compare_entries(const void* entry1, const void* entry2);
+
+void scenario_index_get_headers(string_t dir_path, array(string_t)* paths, scenario_header_t* out_headers)
+{
+    PROFILER_BEGIN(PROFILER_SCOPE_SCENARIO_INDEX);
+
+    string_t index_path = string_heap_concat(dir_path, SCENARIO_INDEX_FILE_NAME);
+    size_t old_entry_count;
+    scenario_index_entry_t* old_entries = scenario_index_load(index_path, &old_entry_count);
+
+    size_t path_count = array_size(paths);
+    size_t new_entry_count = 0;
+    scenario_index_entry_t* new_entries = malloc((path_count > 0 ? path_count : 1) * sizeof(scenario_index_entry_t));
+    bool has_changed = false;
+
+    for (size_t i = 0; i < path_count; i++)
+    {
+        string_t path = array_ele(paths, string_t, i);
+        scenario_index_entry_t* entry = &new_entries[new_entry_count];
+
+        if(!scenario_index_stat_file(path, entry))
+        {
+            scan_scenario_header_from_file(path, &out_headers[i]);
+            continue;
+        }
+
+        const scenario_index_entry_t* cached_entry = old_entry_count > 0 ?
+            bsearch(entry, old_entries, old_entry_count, sizeof(scenario_index_entry_t), scenario_index_compare_entries) : NULL;
+
+        if(cached_entry != NULL && cached_entry->modification_time == entry->modification_time && cached_entry->file_size == entry->file_size)
+        {
+            entry->header = cached_entry->header;
+        }
+        else
+        {
+            scan_scenario_header_from_file(path, &entry->header);
+            has_changed = true;
+        }
+
+        out_headers[i] = entry->header;
+        new_entry_count++;
+    }
+
+    if(has_changed || new_entry_count != old_entry_count)
+    {
+        qsort(new_entries, new_entry_count, sizeof(scenario_index_entry_t), scenario_index_compare_entries);
+        scenario_index_save(index_path, new_entries, new_entry_count);
+    }
+
+    free(new_entries);
+    free(old_entries);
+    free(index_path);
+
+    PROFILER_END(PROFILER_SCOPE_SCENARIO_INDEX);
+}
+
+/* Entries of the returned array are sorted by path, a missing or damaged index reads as an empty one */
+static scenario_index_entry_t* scenario_index_load(string_t index_path, size_t* out_entry_count)
+{
+    FILE* f = fopen(index_path, "rb");
+    scenario_index_file_header_t header;
+    scenario_index_entry_t* entries = NULL;
+    long file_size = -1;
+
+    *out_entry_count = 0;
+
+    if(f == NULL) return NULL;
+
+    if(fseek(f, 0, SEEK_END) == 0) file_size = ftell(f);
+
+    /* The count is only trusted when the file holds exactly that many entries */
+    if(file_size >= 0 && fseek(f, 0, SEEK_SET) == 0 &&
+        fread(&header, sizeof(header), 1, f) == 1 &&
+        memcmp(header.magic, SCENARIO_INDEX_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == SCENARIO_INDEX_VERSION && header.entry_count > 0 &&
+        (uint64_t)file_size == sizeof(header) + (uint64_t)header.entry_count * sizeof(scenario_index_entry_t))
+    {
+        entries = malloc(header.entry_count * sizeof(scenario_index_entry_t));
+
+        if(entries != NULL && fread(entries, sizeof(scenario_index_entry_t), header.entry_count, f) == header.entry_count)
+        {
+            for (size_t i = 0; i < header.entry_count; i++)
+            {
+                entries[i].path[SCENARIO_INDEX_PATH_SIZE - 1] = '\0';
+                entries[i].header.name[SCENARIO_HEADER_NAME_SIZE - 1] = '\0';
+                entries[i].header.icon_path[SCENARIO_HEADER_ICON_PATH_SIZE - 1] = '\0';
+            }
+
+            *out_entry_count = header.entry_count;
+            qsort(entries, *out_entry_count, sizeof(scenario_index_entry_t), scenario_index_compare_entries);
+        }
+        else
+        {
+            free(entries);
+            entries = NULL;
+        }
+    }
+
+    fclose(f);
+
+    return entries;
+}
+
+static void scenario_index_save(string_t index_path, const scenario_index_entry_t* entries, size_t entry_count)
+{
+    FILE* f = fopen(index_path, "wb");
+
+    if(f == NULL) return;
+
+    scenario_index_file_header_t header = {0};
+    memcpy(header.magic, SCENARIO_INDEX_FILE_MAGIC, sizeof(header.magic));
+    header.version = SCENARIO_INDEX_VERSION;
+    header.entry_count = (uint32_t)entry_count;
+
+    fwrite(&header, sizeof(header), 1, f);
+    fwrite(entries, sizeof(scenario_index_entry_t), entry_count, f);
+
+    fclose(f);
+}
+
+/* Fills the key of the entry, files that cannot be stat'ed or whose path does not fit are left out of the index */
+static bool scenario_index_stat_file(string_t path, scenario_index_entry_t* entry)
+{
+    struct stat file_status;
+
+    if(strlen(path) >= SCENARIO_INDEX_PATH_SIZE || stat(path, &file_status) != 0) return false;
+
+    memset(entry, 0, sizeof(scenario_index_entry_t));
+    strcpy(entry->path, path);
+    entry->modification_time = (int64_t)file_status.st_mtime;
+    entry->file_size = (uint64_t)file_status.st_size;
+
+    return true;
+}
+
+static int scenario_index_compare_entries(const void* entry1, const void* entry2)
+{
+    return strcmp(((const scenario_index_entry_t*)entry1)->path, ((const scenario_index_entry_t*)entry2)->path);
+}
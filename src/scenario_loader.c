@@ -7,28 +7,112 @@
 #include <dirent.h>
 #endif
 
-#include "include/assetman_setup.h"
 #include "include/scenario_loader.h"
+#include "include/scenario_binary.h"
 #include "include/strplus.h"
 #include "include/lexer.h"
+#include "include/geometry.h"
 #include "include/logger.h"
-#include "include/rendering.h"
+#include "include/profiler.h"
 
 static void scenario_loader_eat_property(scenario_loader_t* scenario_loader, uint8_t expected_property_token_type);
 static void scenario_loader_eat_token(scenario_loader_t* scenario_loader, uint8_t type_to_eat);
 static void scenario_loader_eat_symbol(scenario_loader_t* scenario_loader, char symbol);
-static uint8_t id_to_scenario_type(string_t id);
-static bool id_to_peon_movement_option(string_t id);
-static bool id_to_boolean(string_t id);
-static cell_value_t id_to_piece_type(string_t id);
+static uint8_t scenario_keyword_of(string_view_t id);
+static uint8_t id_to_scenario_type(scenario_loader_t* scenario_loader, string_view_t id);
+static bool id_to_peon_movement_option(scenario_loader_t* scenario_loader, string_view_t id);
+static bool id_to_boolean(scenario_loader_t* scenario_loader, string_view_t id);
+static team_t id_to_team(scenario_loader_t* scenario_loader, string_view_t id);
+static team_t id_to_computer_team(scenario_loader_t* scenario_loader, string_view_t id);
+static cell_value_t id_to_piece_type(scenario_loader_t* scenario_loader, string_view_t id);
+static cell_id_t scenario_loader_eat_cell(scenario_loader_t* scenario_loader);
 static void scenario_loader_load_id(scenario_loader_t* scenario_loader);
 static void scenario_loader_load_singlecell_piece_assignment(scenario_loader_t* scenario_loader);
 static void scenario_loader_load_multicell_piece_assignment(scenario_loader_t* scenario_loader);
 static void scenario_loader_load_statement(scenario_loader_t* scenario_loader);
 static void scenario_loader_load_challenge_moves(scenario_loader_t* scenario_loader);
 static void parse_single_challenge_move(scenario_loader_t* scenario_loader, dynarray(move_info_t)* challenge_moves);
+static bool scenario_header_next_token(lexer_t* lexer, token_t* out_token);
+
+/* Every identifier a scenario file can contain, identifiers are turned into one of these once instead of being compared to each name in turn */
+enum
+{
+    SCENARIO_KEYWORD_UNKNOWN,
+    SCENARIO_KEYWORD_SCENARIO_TYPE,
+    SCENARIO_KEYWORD_NAME,
+    SCENARIO_KEYWORD_ICON,
+    SCENARIO_KEYWORD_TEAM,
+    SCENARIO_KEYWORD_COMPUTER_PLAYER,
+    SCENARIO_KEYWORD_BOARD,
+    SCENARIO_KEYWORD_FLYING_KINGS,
+    SCENARIO_KEYWORD_PEONS_CAPTURE_BACKWARDS,
+    SCENARIO_KEYWORD_PEONS_MOVEMENT,
+    SCENARIO_KEYWORD_APPLY_LAW_OF_QUANTITY,
+    SCENARIO_KEYWORD_APPLY_LAW_OF_QUALITY,
+    SCENARIO_KEYWORD_DOUBLE_CORNER_SIDE,
+    SCENARIO_KEYWORD_CHALLENGE,
+    SCENARIO_KEYWORD_SCENARIO_1V1,
+    SCENARIO_KEYWORD_SCENARIO_CHALLENGE,
+    SCENARIO_KEYWORD_WHITE_BOTTOM_TO_TOP,
+    SCENARIO_KEYWORD_WHITE_TOP_TO_BOTTOM,
+    SCENARIO_KEYWORD_BLACK_BOTTOM_TO_TOP,
+    SCENARIO_KEYWORD_BLACK_TOP_TO_BOTTOM,
+    SCENARIO_KEYWORD_TRUE,
+    SCENARIO_KEYWORD_FALSE,
+    SCENARIO_KEYWORD_WHITE,
+    SCENARIO_KEYWORD_BLACK,
+    SCENARIO_KEYWORD_NONE,
+    SCENARIO_KEYWORD_WHITE_PEON,
+    SCENARIO_KEYWORD_WHITE_QUEEN,
+    SCENARIO_KEYWORD_BLACK_PEON,
+    SCENARIO_KEYWORD_BLACK_QUEEN,
+    SCENARIO_KEYWORD_EMPTY,
+    SCENARIO_KEYWORD_COUNT
+};
+
+#define SCENARIO_KEYWORD(TEXT) { sizeof(TEXT) - 1, TEXT }
+
+/* Indexed by keyword, the length comes first so most names are rejected without looking at their characters */
+static const struct { size_t length; const char* text; } scenario_keywords [SCENARIO_KEYWORD_COUNT] =
+{
+    { 0, "" },
+    SCENARIO_KEYWORD("SCENARIO_TYPE"),
+    SCENARIO_KEYWORD("NAME"),
+    SCENARIO_KEYWORD("ICON"),
+    SCENARIO_KEYWORD("TEAM"),
+    SCENARIO_KEYWORD("COMPUTER_PLAYER"),
+    SCENARIO_KEYWORD("BOARD"),
+    SCENARIO_KEYWORD("FLYING_KINGS"),
+    SCENARIO_KEYWORD("PEONS_CAPTURE_BACKWARDS"),
+    SCENARIO_KEYWORD("PEONS_MOVEMENT"),
+    SCENARIO_KEYWORD("APPLY_LAW_OF_QUANTITY"),
+    SCENARIO_KEYWORD("APPLY_LAW_OF_QUALITY"),
+    SCENARIO_KEYWORD("DOUBLE_CORNER_SIDE"),
+    SCENARIO_KEYWORD("CHALLENGE"),
+    SCENARIO_KEYWORD("SCENARIO_1V1"),
+    SCENARIO_KEYWORD("SCENARIO_CHALLENGE"),
+    SCENARIO_KEYWORD("WHITE_BOTTOM_TO_TOP"),
+    SCENARIO_KEYWORD("WHITE_TOP_TO_BOTTOM"),
+    SCENARIO_KEYWORD("BLACK_BOTTOM_TO_TOP"),
+    SCENARIO_KEYWORD("BLACK_TOP_TO_BOTTOM"),
+    SCENARIO_KEYWORD("TRUE"),
+    SCENARIO_KEYWORD("FALSE"),
+    SCENARIO_KEYWORD("WHITE"),
+    SCENARIO_KEYWORD("BLACK"),
+    SCENARIO_KEYWORD("NONE"),
+    SCENARIO_KEYWORD("WHITE_PEON"),
+    SCENARIO_KEYWORD("WHITE_QUEEN"),
+    SCENARIO_KEYWORD("BLACK_PEON"),
+    SCENARIO_KEYWORD("BLACK_QUEEN"),
+    SCENARIO_KEYWORD("EMPTY")
+};
 
 void load_scenario_from_token_array(scenario_t* destination, array(token_t) token_array)
+{
+    if(!try_load_scenario_from_token_array(destination, token_array)) exit(EXIT_FAILURE);
+}
+
+bool try_load_scenario_from_token_array(scenario_t* destination, array(token_t) token_array)
 {
     scenario_loader_t scenario_loader;
     scenario_loader.destination = destination;
@@ -36,25 +120,61 @@ void load_scenario_from_token_array(scenario_t* destination, array(token_t) toke
     scenario_loader.iterator = 0;
     scenario_loader.prev_token = NULL;
     scenario_loader.current_token = NULL;
+    scenario_loader.has_failed = false;
 
     scenario_set_default(destination);
 
-    while(scenario_loader.iterator < array_size(&scenario_loader.token_array))
+    while(!scenario_loader.has_failed && scenario_loader.iterator < array_size(&scenario_loader.token_array))
     {
         scenario_loader.prev_token = scenario_loader.current_token;
         scenario_loader.current_token = rrr_array_ele(&scenario_loader.token_array, sizeof(token_t), scenario_loader.iterator);
         scenario_loader_load_statement(&scenario_loader);
     }
+
+    if(!scenario_loader.has_failed && board_geometry_get(destination->rules.board_side_size, destination->rules.double_corner_on_right) == NULL)
+    {
+        LOGGER_ERRORF("Board size %d is not supported!", destination->rules.board_side_size);
+        scenario_loader.has_failed = true;
+    }
+
+    if(scenario_loader.has_failed && destination->scenario_mode == SCENARIO_MODE_CHALLENGE)
+    {
+        array_free(&destination->challenge_moves);
+        destination->challenge_moves = array_stt(0, NULL);
+    }
+
+    return !scenario_loader.has_failed;
 }
 
 void load_scenario_from_file(scenario_t* destination, string_t file_path)
+{
+    if(!try_load_scenario_from_file(destination, file_path)) exit(EXIT_FAILURE);
+}
+
+bool try_load_scenario_from_file(scenario_t* destination, string_t file_path)
 {
     FILE* f;
     size_t scenario_src_size;
     string_t scenario_src;
 
+    PROFILER_BEGIN(PROFILER_SCOPE_SCENARIO_LOAD);
+
+    if(string_ends_with(file_path, SCENARIO_BINARY_FILE_EXTENSION))
+    {
+        bool is_loaded = try_load_scenario_from_binary_file(destination, file_path);
+        PROFILER_END(PROFILER_SCOPE_SCENARIO_LOAD);
+        return is_loaded;
+    }
+
     f = fopen(file_path, "rb");
 
+    if(f == NULL)
+    {
+        LOGGER_ERRORF("Could not open scenario file \'%s\'!", file_path);
+        PROFILER_END(PROFILER_SCOPE_SCENARIO_LOAD);
+        return false;
+    }
+
     fseek(f, 0, SEEK_END);
     scenario_src_size = ftell(f);
     fseek(f, 0, SEEK_SET);
@@ -72,17 +192,59 @@ void load_scenario_from_file(scenario_t* destination, string_t file_path)
     
     tokens = lexer_collect_tokens(&lexer);
 
-    load_scenario_from_token_array(destination, tokens);
+    bool is_loaded = try_load_scenario_from_token_array(destination, tokens);
 
     free(scenario_src);
 
-    for (size_t i = 0; i < array_size(&tokens); i++)
+    array_free(&tokens);
+
+    PROFILER_END(PROFILER_SCOPE_SCENARIO_LOAD);
+
+    return is_loaded;
+}
+
+bool scan_scenario_header_from_file(string_t file_path, scenario_header_t* out_header)
+{
+    FILE* f = fopen(file_path, "rb");
+    char line [SCENARIO_HEADER_LINE_SIZE];
+    bool has_name = false;
+    bool has_icon = false;
+
+    out_header->name[0] = '\0';
+    out_header->icon_path[0] = '\0';
+
+    if(f == NULL) return false;
+
+    while(!(has_name && has_icon) && fgets(line, SCENARIO_HEADER_LINE_SIZE, f) != NULL)
     {
-        token_t* current_token = rrr_array_ele(&tokens, sizeof(token_t), i);
-        token_free(current_token);
+        lexer_t lexer;
+        token_t token;
+
+        lexer_init(&lexer, line);
+
+        while(scenario_header_next_token(&lexer, &token))
+        {
+            if(token.type != TOKEN_ID) continue;
+
+            uint8_t keyword = scenario_keyword_of(token.identifier);
+
+            if(keyword != SCENARIO_KEYWORD_NAME && keyword != SCENARIO_KEYWORD_ICON) continue;
+            if(!scenario_header_next_token(&lexer, &token) || !token_is_symbol(&token, ':')) continue;
+            if(!scenario_header_next_token(&lexer, &token) || token.type != TOKEN_STRING) continue;
+
+            char* value = keyword == SCENARIO_KEYWORD_NAME ? out_header->name : out_header->icon_path;
+            size_t value_size = keyword == SCENARIO_KEYWORD_NAME ? SCENARIO_HEADER_NAME_SIZE : SCENARIO_HEADER_ICON_PATH_SIZE;
+
+            snprintf(value, value_size, "%.*s", (int)token.string_value.length, token.string_value.start);
+
+            if(keyword == SCENARIO_KEYWORD_NAME) has_name = true;
+            else has_icon = true;
+        }
     }
 
-    array_free(&tokens);
+    fclose(f);
+
+    return true;
 }
 
 #ifdef _WIN32
@@ -123,6 +285,12 @@ array(string_t) get_scenario_paths_from_dir(string_t dir_path)
     DIR* dir = opendir(dir_path);
     struct dirent* direntp;
 
+    if(dir == NULL)
+    {
+        LOGGER_ERRORF("Could not open the scenario directory \'%s\'!", dir_path);
+        return dynarray_to_array(&file_paths_list, string_t);
+    }
+
     while((direntp = readdir(dir)) != NULL)
     {
         size_t len_fname = strlen(direntp->d_name);
@@ -142,67 +310,6 @@ array(string_t) get_scenario_paths_from_dir(string_t dir_path)
 
 #endif
 
-scenario_info_t get_scenario_info_from_file(string_t file_path)
-{
-    FILE* f;
-    size_t scenario_src_size;
-    string_t scenario_src;
-    
-    f = fopen(file_path, "rb");
-
-    fseek(f, 0, SEEK_END);
-    scenario_src_size = ftell(f);
-    fseek(f, 0, SEEK_SET);
-
-    scenario_src = malloc(scenario_src_size+1);
-    fread(scenario_src, 1, scenario_src_size, f);
-    scenario_src[scenario_src_size] = '\0';
-
-    fclose(f);
-
-    scenario_info_t scenario_info = { NULL, NULL};
-
-    lexer_t lexer;
-    token_t icon_property_token = { .type = TOKEN_ID, .identifier = "ICON" };
-    token_t name_property_token = { .type = TOKEN_ID, .identifier = "NAME" };
-
-    lexer_init(&lexer, scenario_src);
-
-    bool found_icon = lexer_go_to_next_token_equal_to(&lexer, &icon_property_token);
-
-    if(found_icon)
-    {
-        token_t assigment_symbol_token = lexer_collect_next_token(&lexer); 
-        token_t icon_file_path_token = lexer_collect_next_token(&lexer);
-
-        SDL_Surface* icon_surface = IMG_Load(icon_file_path_token.string_value);
-        scenario_info.icon_texture = SDL_CreateTextureFromSurface(game.renderer, icon_surface);
-
-        SDL_FreeSurface(icon_surface);
-        token_free(&assigment_symbol_token);
-        token_free(&icon_file_path_token);
-    }
-
-    lexer_restart(&lexer);
-
-    bool found_name = lexer_go_to_next_token_equal_to(&lexer, &name_property_token);
-
-    if(found_name)
-    {
-        TTF_Font* browser_font = assetman_get_asset("$Font35pt");
-        token_t assigment_symbol_token = lexer_collect_next_token(&lexer); 
-        token_t name_file_path_token = lexer_collect_next_token(&lexer);
-
-        scenario_info.name_texture = sui_texture_from_text(game.renderer, browser_font, name_file_path_token.string_value, (SDL_Color){ 135, 131, 209, 255});
-
-        token_free(&assigment_symbol_token);
-        token_free(&name_file_path_token);
-    }
-
-    free(scenario_src);
-    return scenario_info;
-}
-
 static void scenario_loader_eat_property(scenario_loader_t* scenario_loader, uint8_t expected_property_token_type)
 {
     scenario_loader_eat_token(scenario_loader, TOKEN_ID);
@@ -212,10 +319,20 @@ static void scenario_loader_eat_property(scenario_loader_t* scenario_loader, uin
 
 static void scenario_loader_eat_token(scenario_loader_t* scenario_loader, uint8_t type_to_eat)
 {
+    if(scenario_loader->has_failed) return;
+
+    if(scenario_loader->current_token == NULL)
+    {
+        LOGGER_ERRORF("Scenario file ended while loading it (expected %d)", type_to_eat);
+        scenario_loader->has_failed = true;
+        return;
+    }
+
     if(scenario_loader->current_token->type != type_to_eat)
     {
         LOGGER_ERRORF("Unexpected token found while loading scenario file (expected %d, received %d)", type_to_eat, scenario_loader->current_token->type);
-        exit(EXIT_FAILURE);
+        scenario_loader->has_failed = true;
+        return;
     }
 
     scenario_loader->iterator++;
@@ -234,167 +351,219 @@ static void scenario_loader_eat_symbol(scenario_loader_t* scenario_loader, char
 {
     scenario_loader_eat_token(scenario_loader, TOKEN_SYMBOL);
 
-    if(scenario_loader->prev_token->symbol != symbol)
+    if(!scenario_loader->has_failed && scenario_loader->prev_token->symbol != symbol)
     {
-        LOGGER_ERRORF("Unexpected symbol found while loading scenario file (expected symbol %c, received symbol %c)", symbol, scenario_loader->current_token->symbol);
-        exit(EXIT_FAILURE);
+        LOGGER_ERRORF("Unexpected symbol found while loading scenario file (expected symbol %c, received symbol %c)", symbol, scenario_loader->prev_token->symbol);
+        scenario_loader->has_failed = true;
     }
 }
 
-static uint8_t id_to_scenario_type(string_t id)
+static cell_id_t scenario_loader_eat_cell(scenario_loader_t* scenario_loader)
 {
-    if(string_equals(id, "SCENARIO_1V1"))       return SCENARIO_MODE_1V1;
-    if(string_equals(id, "SCENARIO_CHALLENGE")) return SCENARIO_MODE_CHALLENGE;
+    scenario_loader_eat_token(scenario_loader, TOKEN_INTEGER);
 
-    LOGGER_ERRORF("Identifier \'%s\' does not represent a possible peon movement option!", id);
-    exit(EXIT_FAILURE);
-}
+    if(scenario_loader->has_failed) return 0;
 
-static bool id_to_peon_movement_option(string_t id)
-{
-    if(string_equals(id, "WHITE_BOTTOM_TO_TOP")|| string_equals(id, "BLACK_TOP_TO_BOTTOM")) return false;
-    if(string_equals(id, "WHITE_TOP_TO_BOTTOM") || string_equals(id, "BLACK_BOTTOM_TO_TOP")) return true;
+    if(scenario_loader->prev_token->integer_value < 1 || scenario_loader->prev_token->integer_value > MAX_BOARD_PLAYABLE_CELL_COUNT)
+    {
+        LOGGER_ERRORF("Cell %d is outside of every supported board!", (int)scenario_loader->prev_token->integer_value);
+        scenario_loader->has_failed = true;
+        return 0;
+    }
 
-    LOGGER_ERRORF("Identifier \'%s\' does not represent a possible peon movement option!", id);
-    exit(EXIT_FAILURE);
+    return (cell_id_t)(scenario_loader->prev_token->integer_value - 1);
 }
 
-static bool id_to_boolean(string_t id)
+static uint8_t scenario_keyword_of(string_view_t id)
 {
-    if(string_equals(id, "TRUE"))   return true;
-    if(string_equals(id, "FALSE"))  return false;
+    for (uint8_t keyword = 1; keyword < SCENARIO_KEYWORD_COUNT; keyword++)
+    {
+        if(scenario_keywords[keyword].length == id.length && memcmp(scenario_keywords[keyword].text, id.start, id.length) == 0)
+            return keyword;
+    }
 
-    LOGGER_ERRORF("Identifier \'%s\' does not represent a boolean value!", id);
-    exit(EXIT_FAILURE);
+    return SCENARIO_KEYWORD_UNKNOWN;
 }
 
-static team_t id_to_team(string_t id)
+static uint8_t id_to_scenario_type(scenario_loader_t* scenario_loader, string_view_t id)
 {
-    if(string_equals(id, "WHITE")) return WHITE_TEAM;
-    if(string_equals(id, "BLACK")) return BLACK_TEAM;
+    switch(scenario_keyword_of(id))
+    {
+        case SCENARIO_KEYWORD_SCENARIO_1V1:         return SCENARIO_MODE_1V1;
+        case SCENARIO_KEYWORD_SCENARIO_CHALLENGE:   return SCENARIO_MODE_CHALLENGE;
+        default: break;
+    }
 
-    LOGGER_ERRORF("Identifier \'%s\' does not represent a valid team value!", id);
-    exit(EXIT_FAILURE);
+    LOGGER_ERRORF("Identifier \'%.*s\' does not represent a possible scenario type!", (int)id.length, id.start);
+    scenario_loader->has_failed = true;
+    return SCENARIO_MODE_1V1;
 }
 
-static cell_value_t id_to_piece_type(string_t id)
+static bool id_to_peon_movement_option(scenario_loader_t* scenario_loader, string_view_t id)
 {
-    if(string_equals(id, "WHITE_PEON"))     return PIECE_WHITE_PEON;
-    if(string_equals(id, "WHITE_QUEEN"))    return PIECE_WHITE_QUEEN;
-    if(string_equals(id, "BLACK_PEON"))     return PIECE_BLACK_PEON;
-    if(string_equals(id, "BLACK_QUEEN"))    return PIECE_BLACK_QUEEN;
-    if(string_equals(id, "EMPTY"))          return NO_PIECE;
-
-    LOGGER_ERRORF("Identifier \'%s\' does not represent a valid piece type!", id);
-    exit(EXIT_FAILURE);
-}
-
-static void scenario_loader_load_id(scenario_loader_t* scenario_loader)
-{
-    if(string_equals(scenario_loader->current_token->identifier, "TEAM"))
+    switch(scenario_keyword_of(id))
     {
-        scenario_loader_eat_property(scenario_loader, TOKEN_ID);
-        scenario_loader->destination->team = id_to_team(scenario_loader->prev_token->identifier);
-        return;
+        case SCENARIO_KEYWORD_WHITE_BOTTOM_TO_TOP:
+        case SCENARIO_KEYWORD_BLACK_TOP_TO_BOTTOM:  return false;
+        case SCENARIO_KEYWORD_WHITE_TOP_TO_BOTTOM:
+        case SCENARIO_KEYWORD_BLACK_BOTTOM_TO_TOP:  return true;
+        default: break;
     }
 
-    if(string_equals(scenario_loader->current_token->identifier, "BOARD"))
-    {
-        scenario_loader_eat_property(scenario_loader, TOKEN_INTEGER);
-        scenario_loader->destination->board_side_size = scenario_loader->prev_token->integer_value;
-        return;
-    }
+    LOGGER_ERRORF("Identifier \'%.*s\' does not represent a possible peon movement option!", (int)id.length, id.start);
+    scenario_loader->has_failed = true;
+    return false;
+}
 
-    if(string_equals(scenario_loader->current_token->identifier, "DOUBLE_CORNER_SIDE"))
+static bool id_to_boolean(scenario_loader_t* scenario_loader, string_view_t id)
+{
+    switch(scenario_keyword_of(id))
     {
-        scenario_loader_eat_property(scenario_loader, TOKEN_ID);
-        scenario_loader->destination->double_corner_on_right = id_to_boolean(scenario_loader->prev_token->identifier);
-        return;
+        case SCENARIO_KEYWORD_TRUE:     return true;
+        case SCENARIO_KEYWORD_FALSE:    return false;
+        default: break;
     }
 
-    if(string_equals(scenario_loader->current_token->identifier, "APPLY_LAW_OF_QUANTITY"))
-    {
-        scenario_loader_eat_property(scenario_loader, TOKEN_ID);
-        scenario_loader->destination->applies_law_of_quantity = id_to_boolean(scenario_loader->prev_token->identifier);
-        return;
-    }
+    LOGGER_ERRORF("Identifier \'%.*s\' does not represent a boolean value!", (int)id.length, id.start);
+    scenario_loader->has_failed = true;
+    return false;
+}
 
-    if(string_equals(scenario_loader->current_token->identifier, "APPLY_LAW_OF_QUALITY"))
+static team_t id_to_team(scenario_loader_t* scenario_loader, string_view_t id)
+{
+    switch(scenario_keyword_of(id))
     {
-        scenario_loader_eat_property(scenario_loader, TOKEN_ID);
-        scenario_loader->destination->applies_law_of_quality = id_to_boolean(scenario_loader->prev_token->identifier);
-        return;
+        case SCENARIO_KEYWORD_WHITE:    return WHITE_TEAM;
+        case SCENARIO_KEYWORD_BLACK:    return BLACK_TEAM;
+        default: break;
     }
 
-    if(string_equals(scenario_loader->current_token->identifier, "FLYING_KINGS"))
-    {
-        scenario_loader_eat_property(scenario_loader, TOKEN_ID);
-        scenario_loader->destination->flying_kings = id_to_boolean(scenario_loader->prev_token->identifier);
-        return;
-    }
+    LOGGER_ERRORF("Identifier \'%.*s\' does not represent a valid team value!", (int)id.length, id.start);
+    scenario_loader->has_failed = true;
+    return WHITE_TEAM;
+}
 
-    if(string_equals(scenario_loader->current_token->identifier, "PEONS_CAPTURE_BACKWARDS"))
-    {
-        scenario_loader_eat_property(scenario_loader, TOKEN_ID);
-        scenario_loader->destination->peons_capture_backwards = id_to_boolean(scenario_loader->prev_token->identifier);
-        return;
-    }
+static team_t id_to_computer_team(scenario_loader_t* scenario_loader, string_view_t id)
+{
+    if(scenario_keyword_of(id) == SCENARIO_KEYWORD_NONE) return NO_TEAM;
 
-    if(string_equals(scenario_loader->current_token->identifier, "PEONS_MOVEMENT"))
-    {
-        scenario_loader_eat_property(scenario_loader, TOKEN_ID);
-        scenario_loader->destination->is_white_peon_forward_top_to_bottom = id_to_peon_movement_option(scenario_loader->prev_token->identifier);
-        return;
-    }
+    return id_to_team(scenario_loader, id);
+}
 
-    if(string_equals(scenario_loader->current_token->identifier, "SCENARIO_TYPE"))
+static cell_value_t id_to_piece_type(scenario_loader_t* scenario_loader, string_view_t id)
+{
+    switch(scenario_keyword_of(id))
     {
-        scenario_loader_eat_property(scenario_loader, TOKEN_ID);
-        scenario_loader->destination->scenario_mode = id_to_scenario_type(scenario_loader->prev_token->identifier);
-        return;
+        case SCENARIO_KEYWORD_WHITE_PEON:   return PIECE_WHITE_PEON;
+        case SCENARIO_KEYWORD_WHITE_QUEEN:  return PIECE_WHITE_QUEEN;
+        case SCENARIO_KEYWORD_BLACK_PEON:   return PIECE_BLACK_PEON;
+        case SCENARIO_KEYWORD_BLACK_QUEEN:  return PIECE_BLACK_QUEEN;
+        case SCENARIO_KEYWORD_EMPTY:        return NO_PIECE;
+        default: break;
     }
 
-    if(string_equals(scenario_loader->current_token->identifier, "CHALLENGE"))
-    {
-        scenario_loader_load_challenge_moves(scenario_loader);
-        return;
-    }
+    LOGGER_ERRORF("Identifier \'%.*s\' does not represent a valid piece type!", (int)id.length, id.start);
+    scenario_loader->has_failed = true;
+    return NO_PIECE;
+}
+
+static void scenario_loader_load_id(scenario_loader_t* scenario_loader)
+{
+    scenario_t* destination = scenario_loader->destination;
+    string_view_t property = scenario_loader->current_token->identifier;
 
-    if(string_equals(scenario_loader->current_token->identifier, "NAME") || string_equals(scenario_loader->current_token->identifier, "ICON"))
+    switch(scenario_keyword_of(property))
     {
-        scenario_loader_eat_property(scenario_loader, TOKEN_STRING);
-        return;
+        case SCENARIO_KEYWORD_TEAM:
+            scenario_loader_eat_property(scenario_loader, TOKEN_ID);
+            if(scenario_loader->has_failed) return;
+            destination->team = id_to_team(scenario_loader, scenario_loader->prev_token->identifier);
+            return;
+        case SCENARIO_KEYWORD_COMPUTER_PLAYER:
+            scenario_loader_eat_property(scenario_loader, TOKEN_ID);
+            if(scenario_loader->has_failed) return;
+            destination->computer_team = id_to_computer_team(scenario_loader, scenario_loader->prev_token->identifier);
+            return;
+        case SCENARIO_KEYWORD_BOARD:
+            scenario_loader_eat_property(scenario_loader, TOKEN_INTEGER);
+            if(scenario_loader->has_failed) return;
+            destination->rules.board_side_size = scenario_loader->prev_token->integer_value;
+            return;
+        case SCENARIO_KEYWORD_DOUBLE_CORNER_SIDE:
+            scenario_loader_eat_property(scenario_loader, TOKEN_ID);
+            if(scenario_loader->has_failed) return;
+            destination->rules.double_corner_on_right = id_to_boolean(scenario_loader, scenario_loader->prev_token->identifier);
+            return;
+        case SCENARIO_KEYWORD_APPLY_LAW_OF_QUANTITY:
+            scenario_loader_eat_property(scenario_loader, TOKEN_ID);
+            if(scenario_loader->has_failed) return;
+            destination->rules.applies_law_of_quantity = id_to_boolean(scenario_loader, scenario_loader->prev_token->identifier);
+            return;
+        case SCENARIO_KEYWORD_APPLY_LAW_OF_QUALITY:
+            scenario_loader_eat_property(scenario_loader, TOKEN_ID);
+            if(scenario_loader->has_failed) return;
+            destination->rules.applies_law_of_quality = id_to_boolean(scenario_loader, scenario_loader->prev_token->identifier);
+            return;
+        case SCENARIO_KEYWORD_FLYING_KINGS:
+            scenario_loader_eat_property(scenario_loader, TOKEN_ID);
+            if(scenario_loader->has_failed) return;
+            destination->rules.flying_kings = id_to_boolean(scenario_loader, scenario_loader->prev_token->identifier);
+            return;
+        case SCENARIO_KEYWORD_PEONS_CAPTURE_BACKWARDS:
+            scenario_loader_eat_property(scenario_loader, TOKEN_ID);
+            if(scenario_loader->has_failed) return;
+            destination->rules.peons_capture_backwards = id_to_boolean(scenario_loader, scenario_loader->prev_token->identifier);
+            return;
+        case SCENARIO_KEYWORD_PEONS_MOVEMENT:
+            scenario_loader_eat_property(scenario_loader, TOKEN_ID);
+            if(scenario_loader->has_failed) return;
+            destination->rules.is_white_peon_forward_top_to_bottom = id_to_peon_movement_option(scenario_loader, scenario_loader->prev_token->identifier);
+            return;
+        case SCENARIO_KEYWORD_SCENARIO_TYPE:
+            scenario_loader_eat_property(scenario_loader, TOKEN_ID);
+            if(scenario_loader->has_failed) return;
+            destination->scenario_mode = id_to_scenario_type(scenario_loader, scenario_loader->prev_token->identifier);
+            return;
+        case SCENARIO_KEYWORD_CHALLENGE:
+            scenario_loader_load_challenge_moves(scenario_loader);
+            return;
+        case SCENARIO_KEYWORD_NAME:
+        case SCENARIO_KEYWORD_ICON:
+            scenario_loader_eat_property(scenario_loader, TOKEN_STRING);
+            return;
+        default:
+            break;
     }
 
-    LOGGER_ERRORF("Identifier \'%s\' does not represent a valid property!", scenario_loader->current_token->identifier);
-    exit(EXIT_FAILURE);
+    LOGGER_ERRORF("Identifier \'%.*s\' does not represent a valid property!", (int)property.length, property.start);
+    scenario_loader->has_failed = true;
 }
 
 static void scenario_loader_load_singlecell_piece_assignment(scenario_loader_t* scenario_loader)
 {
-    scenario_loader_eat_token(scenario_loader, TOKEN_INTEGER);
-
-    cell_id_t cell_id = scenario_loader->prev_token->integer_value - 1;
+    cell_id_t cell_id = scenario_loader_eat_cell(scenario_loader);
 
     scenario_loader_eat_symbol(scenario_loader, ':');
     scenario_loader_eat_token(scenario_loader, TOKEN_ID);
 
-    cell_value_t piece_type = id_to_piece_type(scenario_loader->prev_token->identifier);
+    if(scenario_loader->has_failed) return;
+
+    cell_value_t piece_type = id_to_piece_type(scenario_loader, scenario_loader->prev_token->identifier);
     
-    scenario_loader->destination->board.playable_cells[cell_id] = piece_type;
+    if(scenario_loader->has_failed) return;
+
+    board_set_cell(&scenario_loader->destination->board, cell_id, piece_type);
 }
 
 static void scenario_loader_load_multicell_piece_assignment(scenario_loader_t* scenario_loader)
 {
     scenario_loader_eat_symbol(scenario_loader, '[');
-    scenario_loader_eat_token(scenario_loader, TOKEN_INTEGER);
 
-    cell_id_t start_cell_id = scenario_loader->prev_token->integer_value - 1;
+    cell_id_t start_cell_id = scenario_loader_eat_cell(scenario_loader);
 
     scenario_loader_eat_symbol(scenario_loader, ';');
-    scenario_loader_eat_token(scenario_loader, TOKEN_INTEGER);
 
-    cell_id_t end_cell_id = scenario_loader->prev_token->integer_value - 1;
+    cell_id_t end_cell_id = scenario_loader_eat_cell(scenario_loader);
 
     scenario_loader_eat_symbol(scenario_loader, ']');
     scenario_loader_eat_symbol(scenario_loader, ':');
@@ -408,11 +577,15 @@ static void scenario_loader_load_multicell_piece_assignment(scenario_loader_t* s
 
     scenario_loader_eat_token(scenario_loader, TOKEN_ID);
 
-    cell_value_t piece_type = id_to_piece_type(scenario_loader->prev_token->identifier);
+    if(scenario_loader->has_failed) return;
+
+    cell_value_t piece_type = id_to_piece_type(scenario_loader, scenario_loader->prev_token->identifier);
+
+    if(scenario_loader->has_failed) return;
 
     for(cell_id_t cell_id = start_cell_id; cell_id < end_cell_id + 1; cell_id++)
     {
-        scenario_loader->destination->board.playable_cells[cell_id] = piece_type;
+        board_set_cell(&scenario_loader->destination->board, cell_id, piece_type);
     }
 }
 
@@ -428,9 +601,15 @@ static void scenario_loader_load_statement(scenario_loader_t* scenario_loader)
             break;
         case TOKEN_SYMBOL:
             if(scenario_loader->current_token->symbol == '[')
+            {
                 scenario_loader_load_multicell_piece_assignment(scenario_loader);
-            break;
+                break;
+            }
+            /* fall through */
         default:
+            /* Nothing else can start a statement, and skipping the token would loop forever */
+            LOGGER_ERRORF("Unexpected token found while loading scenario file (received %d)", scenario_loader->current_token->type);
+            scenario_loader->has_failed = true;
             break;
     }
 }
@@ -445,7 +624,7 @@ static void scenario_loader_load_challenge_moves(scenario_loader_t* scenario_loa
         scenario_loader_eat_symbol(scenario_loader, ':');
         scenario_loader_eat_symbol(scenario_loader, '{');
 
-        while(!token_is_symbol(scenario_loader->current_token, '}'))
+        while(!scenario_loader->has_failed && scenario_loader->current_token != NULL && !token_is_symbol(scenario_loader->current_token, '}'))
             scenario_loader_eat_token(scenario_loader, scenario_loader->current_token->type);
 
         scenario_loader_eat_symbol(scenario_loader, '}');
@@ -459,11 +638,17 @@ static void scenario_loader_load_challenge_moves(scenario_loader_t* scenario_loa
 
     dynarray(move_info_t) challenge_moves = dynarray_new(move_info_t, 0);
 
-    while(!token_is_symbol(scenario_loader->current_token, '}')) 
+    while(!scenario_loader->has_failed && scenario_loader->current_token != NULL && !token_is_symbol(scenario_loader->current_token, '}')) 
         parse_single_challenge_move(scenario_loader, &challenge_moves);
 
     scenario_loader_eat_symbol(scenario_loader, '}');
 
+    if(scenario_loader->has_failed)
+    {
+        dynarray_free(&challenge_moves);
+        return;
+    }
+
     scenario_loader->destination->challenge_moves = dynarray_to_array(&challenge_moves, move_info_t);
 }
 
@@ -474,22 +659,32 @@ static void parse_single_challenge_move(scenario_loader_t* scenario_loader, dyna
     current_move.is_capture_move = false;
     scenario_loader_eat_symbol(scenario_loader, '(');
 
-    scenario_loader_eat_token(scenario_loader, TOKEN_INTEGER);
-    current_move.source_cell = scenario_loader->prev_token->integer_value - 1;
+    current_move.source_cell = scenario_loader_eat_cell(scenario_loader);
     scenario_loader_eat_symbol(scenario_loader, ',');
 
-    scenario_loader_eat_token(scenario_loader, TOKEN_INTEGER);
-    current_move.destination_cell = scenario_loader->prev_token->integer_value - 1;
+    current_move.destination_cell = scenario_loader_eat_cell(scenario_loader);
 
-    if(token_is_symbol(scenario_loader->current_token, ','))
+    if(!scenario_loader->has_failed && scenario_loader->current_token != NULL && token_is_symbol(scenario_loader->current_token, ','))
     {
         scenario_loader_eat_symbol(scenario_loader, ',');
-        scenario_loader_eat_token(scenario_loader, TOKEN_INTEGER);
         current_move.is_capture_move = true;
-        current_move.capture_cell = scenario_loader->prev_token->integer_value - 1;
+        current_move.capture_cell = scenario_loader_eat_cell(scenario_loader);
     }
     
     scenario_loader_eat_symbol(scenario_loader, ')');
 
+    if(scenario_loader->has_failed) return;
+
     dynarray_add(challenge_moves, move_info_t, &current_move);
 }
+
+static bool scenario_header_next_token(lexer_t* lexer, token_t* out_token)
+{
+    lexer_skip_spaces(lexer);
+
+    if(*lexer->current_char_ptr == '\0') return false;
+
+    *out_token = lexer_collect_next_token(lexer);
+
+    return true;
+}
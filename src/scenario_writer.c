@@ -0,0 +1,121 @@
+#include <inttypes.h>
+
+#include "include/scenario_writer.h"
+
+static void save_single_cell_assignment(FILE* f, cell_id_t cid, cell_value_t piece_type);
+static void save_multi_cell_assignment(FILE* f, cell_id_t start_cid, cell_id_t end_cid, cell_value_t piece_type);
+static void save_challenge_moves(FILE* f, const scenario_t* scenario);
+static const char* piece_type_to_str(cell_value_t piece_type);
+static const char* scenario_mode_to_str(uint8_t mode);
+static const char* boolean_to_str(bool boolean);
+static const char* team_to_str(team_t team);
+static const char* computer_team_to_str(team_t team);
+static const char* peon_movement_to_str(bool is_white_peon_forward_top_to_bottom);
+
+void scenario_write_sch(FILE* f, const scenario_t* scenario, const char* name, const char* icon_path)
+{
+    cell_id_t playable_cell_count = (cell_id_t)(scenario->rules.board_side_size * scenario->rules.board_side_size / 2);
+
+    fprintf(f, "SCENARIO_TYPE : %s\n", scenario_mode_to_str(scenario->scenario_mode));
+
+    if(name != NULL && name[0] != '\0')
+        fprintf(f, "NAME:\"%s\"\n", name);
+
+    if(icon_path != NULL && icon_path[0] != '\0')
+        fprintf(f, "ICON:\"%s\"\n", icon_path);
+
+    fprintf(f, "TEAM : %s\n", team_to_str(scenario->team));
+    fprintf(f, "COMPUTER_PLAYER : %s\n", computer_team_to_str(scenario->computer_team));
+    fprintf(f, "BOARD : %"PRId16"\n", scenario->rules.board_side_size);
+    fprintf(f, "FLYING_KINGS : %s\n", boolean_to_str(scenario->rules.flying_kings));
+    fprintf(f, "PEONS_CAPTURE_BACKWARDS : %s\n", boolean_to_str(scenario->rules.peons_capture_backwards));
+    fprintf(f, "PEONS_MOVEMENT : %s\n", peon_movement_to_str(scenario->rules.is_white_peon_forward_top_to_bottom));
+    fprintf(f, "APPLY_LAW_OF_QUANTITY : %s\n", boolean_to_str(scenario->rules.applies_law_of_quantity));
+    fprintf(f, "APPLY_LAW_OF_QUALITY : %s\n", boolean_to_str(scenario->rules.applies_law_of_quality));
+    fprintf(f, "DOUBLE_CORNER_SIDE : %s\n", boolean_to_str(scenario->rules.double_corner_on_right));
+
+    for (cell_id_t cid = 0; cid < playable_cell_count; cid++)
+    {
+        cell_value_t piece_type = scenario->board.playable_cells[cid];
+
+        cell_id_t start_cid = cid;
+
+        while (cid+1 < playable_cell_count && scenario->board.playable_cells[cid+1] == piece_type) cid++;
+
+        if(start_cid == cid)
+            save_single_cell_assignment(f, cid, piece_type);
+        else
+            save_multi_cell_assignment(f, start_cid, cid, piece_type);
+    }
+
+    if(scenario->scenario_mode == SCENARIO_MODE_CHALLENGE && scenario->challenge_moves.size > 0)
+        save_challenge_moves(f, scenario);
+}
+
+static void save_single_cell_assignment(FILE* f, cell_id_t cid, cell_value_t piece_type)
+{
+    if(piece_type == NO_PIECE) return;
+
+    fprintf(f, "%" PRIu16 " : %s\n", cid+1, piece_type_to_str(piece_type));
+}
+
+static void save_multi_cell_assignment(FILE* f, cell_id_t start_cid, cell_id_t end_cid, cell_value_t piece_type)
+{
+    if(piece_type == NO_PIECE) return;
+
+    fprintf(f, "[%"PRIu16 ";%" PRIu16 "] : %s\n", start_cid+1, end_cid+1, piece_type_to_str(piece_type));
+}
+
+static void save_challenge_moves(FILE* f, const scenario_t* scenario)
+{
+    const move_info_t* moves = scenario->challenge_moves.data;
+
+    fprintf(f, "CHALLENGE : {");
+
+    for (size_t i = 0; i < scenario->challenge_moves.size; i++)
+    {
+        if(moves[i].is_capture_move)
+            fprintf(f, " (%" PRIu16 ", %" PRIu16 ", %" PRIu16 ")", moves[i].source_cell+1, moves[i].destination_cell+1, moves[i].capture_cell+1);
+        else
+            fprintf(f, " (%" PRIu16 ", %" PRIu16 ")", moves[i].source_cell+1, moves[i].destination_cell+1);
+    }
+
+    fprintf(f, " }\n");
+}
+
+static const char* piece_type_to_str(cell_value_t piece_type)
+{
+    switch(piece_type)
+    {
+        case PIECE_WHITE_PEON:  return "WHITE_PEON";
+        case PIECE_BLACK_PEON:  return "BLACK_PEON";
+        case PIECE_WHITE_QUEEN: return "WHITE_QUEEN";
+        case PIECE_BLACK_QUEEN: return "BLACK_QUEEN";
+        default:                return "EMPTY";
+    }
+}
+
+static const char* scenario_mode_to_str(uint8_t mode)
+{
+    return mode == SCENARIO_MODE_1V1 ? "SCENARIO_1V1" : "SCENARIO_CHALLENGE";
+}
+
+static const char* boolean_to_str(bool boolean)
+{
+    return boolean ? "TRUE" : "FALSE";
+}
+
+static const char* team_to_str(team_t team)
+{
+    return team == WHITE_TEAM ? "WHITE" : "BLACK";
+}
+
+static const char* computer_team_to_str(team_t team)
+{
+    return team == NO_TEAM ? "NONE" : team_to_str(team);
+}
+
+static const char* peon_movement_to_str(bool is_white_peon_forward_top_to_bottom)
+{
+    return is_white_peon_forward_top_to_bottom ? "WHITE_TOP_TO_BOTTOM" : "WHITE_BOTTOM_TO_TOP";
+}
@@ -0,0 +1,249 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/search.h"
+#include "include/geometry.h"
+#include "include/platform.h"
+
+#define SEARCH_INFINITE_SCORE (SEARCH_WIN_SCORE + 1)
+#define SEARCH_NODES_BETWEEN_LIMIT_CHECKS 2048
+#define SEARCH_NO_MOVE_INDEX ((uint16_t)0xFFFF)
+
+enum
+{
+    SEARCH_BOUND_EXACT,
+    SEARCH_BOUND_LOWER,
+    SEARCH_BOUND_UPPER
+};
+
+static void searcher_start(searcher_t* searcher, search_limits_t* limits);
+static int searcher_negamax(searcher_t* searcher, const board_t* board, team_t playing_team, int depth, unsigned ply, int alpha, int beta);
+static bool searcher_should_stop(searcher_t* searcher);
+static int search_score_to_table(int score, unsigned ply);
+static int search_score_from_table(int score, unsigned ply);
+
+void searcher_init(searcher_t* searcher, const ruleset_t* rules)
+{
+    searcher->rules = *rules;
+    searcher->move_lists = malloc(SEARCH_MAX_PLY * sizeof(legal_move_list_t));
+    searcher->transposition_table = calloc(SEARCH_TRANSPOSITION_TABLE_SIZE, sizeof(search_transposition_entry_t));
+}
+
+void searcher_free(searcher_t* searcher)
+{
+    free(searcher->move_lists);
+    free(searcher->transposition_table);
+
+    searcher->move_lists = NULL;
+    searcher->transposition_table = NULL;
+}
+
+void searcher_clear(searcher_t* searcher)
+{
+    memset(searcher->transposition_table, 0, SEARCH_TRANSPOSITION_TABLE_SIZE * sizeof(search_transposition_entry_t));
+}
+
+search_result_t searcher_find_best_move(searcher_t* searcher, const board_t* board, team_t playing_team, search_limits_t limits)
+{
+    search_result_t result = {0};
+    legal_move_list_t* root_moves = &searcher->move_lists[0];
+
+    searcher_start(searcher, &limits);
+
+    board_generate_legal_moves(&searcher->rules, board, playing_team, root_moves);
+
+    if(root_moves->move_count == 0) return result;
+
+    result.has_move = true;
+    result.best_move = root_moves->moves[0];
+
+    /* Nothing to think about, the move is forced */
+    if(root_moves->move_count == 1) return result;
+
+    for (unsigned depth = 1; depth <= limits.max_depth; depth++)
+    {
+        searcher->root_best_move_index = SEARCH_NO_MOVE_INDEX;
+
+        int score = searcher_negamax(searcher, board, playing_team, (int)depth, 0, -SEARCH_INFINITE_SCORE, SEARCH_INFINITE_SCORE);
+
+        /* An interrupted iteration still searched the previous best move first, so any better move it found can be trusted */
+        if(searcher->root_best_move_index != SEARCH_NO_MOVE_INDEX)
+            result.best_move = root_moves->moves[searcher->root_best_move_index];
+
+        if(searcher->is_aborted) break;
+
+        result.score = score;
+        result.completed_depth = depth;
+
+        if(abs(score) >= SEARCH_WIN_SCORE - SEARCH_MAX_PLY) break;
+    }
+
+    result.node_count = searcher->node_count;
+    return result;
+}
+
+int searcher_score_position(searcher_t* searcher, const board_t* board, team_t playing_team, search_limits_t limits)
+{
+    int score = search_evaluate(&searcher->rules, board, playing_team);
+
+    searcher_start(searcher, &limits);
+
+    for (unsigned depth = 1; depth <= limits.max_depth; depth++)
+    {
+        int iteration_score = searcher_negamax(searcher, board, playing_team, (int)depth, 0, -SEARCH_INFINITE_SCORE, SEARCH_INFINITE_SCORE);
+
+        if(searcher->is_aborted) break;
+
+        score = iteration_score;
+
+        if(abs(score) >= SEARCH_WIN_SCORE - SEARCH_MAX_PLY) break;
+    }
+
+    return score;
+}
+
+int search_evaluate(const ruleset_t* rules, const board_t* board, team_t playing_team)
+{
+    const board_geometry_t* geometry = board_geometry_of(rules);
+    int score = 0;
+
+    for (cell_id_t cid = 0; cid < geometry->playable_cell_count; cid++)
+    {
+        cell_value_t piece_type = board->playable_cells[cid];
+
+        if(piece_type == NO_PIECE) continue;
+
+        int piece_score = SEARCH_QUEEN_SCORE;
+
+        if(piece_is_peon(piece_type))
+        {
+            bool crowns_on_bottom_line = piece_is_white(piece_type) == rules->is_white_peon_forward_top_to_bottom;
+            board_coordinate_t y = geometry->cell_positions[cid].y;
+            int advance = crowns_on_bottom_line ? y : rules->board_side_size - 1 - y;
+
+            piece_score = SEARCH_PEON_SCORE + advance * SEARCH_PEON_ADVANCE_SCORE;
+        }
+
+        score += piece_team(piece_type) == playing_team ? piece_score : -piece_score;
+    }
+
+    return score;
+}
+
+static void searcher_start(searcher_t* searcher, search_limits_t* limits)
+{
+    if(limits->max_depth == 0 || limits->max_depth >= SEARCH_MAX_PLY) limits->max_depth = SEARCH_MAX_PLY - 1;
+
+    searcher->limits = *limits;
+    searcher->start_time = platform_now_seconds();
+    searcher->node_count = 0;
+    searcher->is_aborted = false;
+}
+
+static int searcher_negamax(searcher_t* searcher, const board_t* board, team_t playing_team, int depth, unsigned ply, int alpha, int beta)
+{
+    searcher->node_count++;
+
+    if(searcher_should_stop(searcher)) return 0;
+
+    zobrist_key_t key = board_position_hash(board, playing_team);
+    search_transposition_entry_t* entry = &searcher->transposition_table[key & (SEARCH_TRANSPOSITION_TABLE_SIZE - 1)];
+    uint16_t table_move_index = SEARCH_NO_MOVE_INDEX;
+
+    if(entry->key == key)
+    {
+        table_move_index = entry->best_move_index;
+
+        if(ply > 0 && entry->depth >= depth)
+        {
+            int table_score = search_score_from_table(entry->score, ply);
+
+            if(entry->bound == SEARCH_BOUND_EXACT) return table_score;
+            if(entry->bound == SEARCH_BOUND_LOWER && table_score >= beta) return table_score;
+            if(entry->bound == SEARCH_BOUND_UPPER && table_score <= alpha) return table_score;
+        }
+    }
+
+    legal_move_list_t* move_list = &searcher->move_lists[ply];
+    board_generate_legal_moves(&searcher->rules, board, playing_team, move_list);
+
+    if(move_list->move_count == 0) return -SEARCH_WIN_SCORE + (int)ply;
+
+    /* Captures are forced, so the search only stops on quiet positions */
+    bool is_capturing = move_list->moves[0].capture_count > 0;
+
+    if(ply == SEARCH_MAX_PLY - 1 || (depth <= 0 && !is_capturing)) return search_evaluate(&searcher->rules, board, playing_team);
+
+    int original_alpha = alpha;
+    int best_score = -SEARCH_INFINITE_SCORE;
+    uint16_t best_move_index = SEARCH_NO_MOVE_INDEX;
+    size_t first_move_index = table_move_index < move_list->move_count ? table_move_index : 0;
+
+    for (size_t n = 0; n < move_list->move_count; n++)
+    {
+        /* The best move of the table goes first, the rest keep their order */
+        size_t i = n == 0 ? first_move_index : (n <= first_move_index ? n - 1 : n);
+
+        board_t next_board = *board;
+        board_play_legal_move(&searcher->rules, &next_board, &move_list->moves[i]);
+
+        int score = -searcher_negamax(searcher, &next_board, playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM, depth - 1, ply + 1, -beta, -alpha);
+
+        if(searcher->is_aborted) return 0;
+
+        if(score > best_score)
+        {
+            best_score = score;
+            best_move_index = (uint16_t)i;
+
+            if(ply == 0) searcher->root_best_move_index = i;
+        }
+
+        if(score > alpha) alpha = score;
+
+        if(alpha >= beta) break;
+    }
+
+    entry->key = key;
+    entry->score = search_score_to_table(best_score, ply);
+    entry->depth = (int8_t)(depth < 0 ? 0 : depth);
+    entry->best_move_index = best_move_index;
+
+    if(best_score <= original_alpha) entry->bound = SEARCH_BOUND_UPPER;
+    else if(best_score >= beta) entry->bound = SEARCH_BOUND_LOWER;
+    else entry->bound = SEARCH_BOUND_EXACT;
+
+    return best_score;
+}
+
+static bool searcher_should_stop(searcher_t* searcher)
+{
+    if(searcher->is_aborted) return true;
+
+    if(searcher->node_count % SEARCH_NODES_BETWEEN_LIMIT_CHECKS != 0) return false;
+
+    if(searcher->limits.stop_requested != NULL && atomic_load(searcher->limits.stop_requested))
+        searcher->is_aborted = true;
+
+    if(searcher->limits.time_budget_seconds > 0 && platform_now_seconds() - searcher->start_time >= searcher->limits.time_budget_seconds)
+        searcher->is_aborted = true;
+
+    return searcher->is_aborted;
+}
+
+/* Win scores are stored relative to the position, so they stay right when it is reached through a different number of moves */
+static int search_score_to_table(int score, unsigned ply)
+{
+    if(score >= SEARCH_WIN_SCORE - SEARCH_MAX_PLY) return score + (int)ply;
+    if(score <= -SEARCH_WIN_SCORE + SEARCH_MAX_PLY) return score - (int)ply;
+
+    return score;
+}
+
+static int search_score_from_table(int score, unsigned ply)
+{
+    if(score >= SEARCH_WIN_SCORE - SEARCH_MAX_PLY) return score - (int)ply;
+    if(score <= -SEARCH_WIN_SCORE + SEARCH_MAX_PLY) return score + (int)ply;
+
+    return score;
+}
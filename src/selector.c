@@ -1,19 +1,23 @@
-#include <inttypes.h> 
-
 #include "include/game.h"
 #include "include/assetman_setup.h"
 #include "include/scenario_loader.h"
+#include "include/scenario_index.h"
 #include "include/rendering.h"
 
 #define GSELECTOR_STANDARD NULL
 #define GSELECTOR_EDITOR ((void*)1)
 
-#define SELECTOR_ITEMS_PER_PAGE 8
 #define SCENARIO_ICON_SIDE 250
 #define SCENARIO_TEXT_OFFSET 180
 #define SCENARIO_SPACING 450
 
-static void selector_refresh();
+/* Pages before and after the current one whose thumbnails are loaded ahead of time */
+#define SELECTOR_PREFETCH_PAGE_COUNT 1
+
+static void selector_show_page();
+static void selector_build_page();
+static void selector_update_icons();
+static SDL_Texture* selector_icon_texture(size_t index);
 static void selector_section_navbar(bool is_standard_section);
 static void selector_go_to_next_page(void* event_data);
 static void selector_go_to_prev_page(void* event_data);
@@ -29,11 +33,8 @@ void game_set_mode_selector(void* event_data)
     game.selector.is_standard_section = event_data == GSELECTOR_STANDARD;
     event_data = game.selector.is_standard_section ? PATH_SCENARIOS_STANDARD : PATH_SCENARIOS_EDITOR;
 
-    sui_clear_elements();
+    sui_element_set_activate(&game.selector_elements);
 
-    SDL_Texture* default_scenario_icon = assetman_get_asset("$DefaultSchIcon");
-    SDL_Texture* default_scenario_name = assetman_get_asset("$DefaultSchName");
-    
     SDL_Texture* back_button_text_texture = sui_texture_from_text(game.renderer, assetman_get_asset("$Font45pt"), UI_BACK_BUTTON_TEXT, (SDL_Color){ 0, 0, 0, 255 });
     SDL_Texture* next_page_button_texture = sui_load_texture(PATH_IMAGES "next_page.png", game.renderer, NULL);
     SDL_Texture* prev_page_button_texture = sui_load_texture(PATH_IMAGES "prev_page.png", game.renderer, NULL);
@@ -54,41 +55,33 @@ void game_set_mode_selector(void* event_data)
     assetman_set_asset(true, "SelectorStd", TEXTURE_ASSET_TYPE, standard_section_texture);
     assetman_set_asset(true, "SelectorEditor", TEXTURE_ASSET_TYPE, editor_section_texture);
 
-    uint8_t num_id = 0;
-    char sch_icon_id [] = "SelectorSchIcon000";
-    char sch_name_id [] = "SelectorSchName000"; 
-
     game.selector.file_paths = get_scenario_paths_from_dir(event_data);
+    game.selector.headers = malloc((array_size(&game.selector.file_paths) + 1) * sizeof(scenario_header_t));
 
-    for (size_t i = 0; i < array_size(&game.selector.file_paths); i++)
-    {
-        string_t current_file_path = array_ele(&game.selector.file_paths, string_t, i);
-        scenario_info_t given_scenario_info = get_scenario_info_from_file(current_file_path);
-
-        if(given_scenario_info.icon_texture != NULL)
-            assetman_set_asset(false, sch_icon_id, TEXTURE_ASSET_TYPE, given_scenario_info.icon_texture);
-        else
-            assetman_set_asset(false, sch_icon_id, UNHANDLED_ASSET, default_scenario_icon);
-
-        if(given_scenario_info.name_texture != NULL)
-            assetman_set_asset(false, sch_name_id, TEXTURE_ASSET_TYPE, given_scenario_info.name_texture);
-        else
-            assetman_set_asset(false, sch_name_id, UNHANDLED_ASSET, default_scenario_name);
-
-        num_id++;
-        sprintf(&sch_icon_id[15], "%03"PRIu8, num_id);
-        sprintf(&sch_name_id[15], "%03"PRIu8, num_id);
-    }
+    scenario_index_get_headers(event_data, &game.selector.file_paths, game.selector.headers);
+    thumbnail_loader_init(&game.selector.thumbnails, game.selector.headers, array_size(&game.selector.file_paths));
 
     pager_init(&game.selector.pager, array_size(&game.selector.file_paths), SELECTOR_ITEMS_PER_PAGE);
     pager_next_page(&game.selector.pager);
 
-    selector_refresh();
+    selector_show_page();
 
     LOGGER_LOGS("Finished loading Scenario Browser!");
 }
 
-static void selector_refresh()
+void selector_update_thumbnails()
+{
+    if(thumbnail_loader_upload(&game.selector.thumbnails, game.renderer, game.selector.pager.current_page_start, game.selector.pager.current_page_end))
+        selector_update_icons();
+}
+
+static void selector_show_page()
+{
+    thumbnail_loader_request(&game.selector.thumbnails, game.selector.pager.current_page_start, game.selector.pager.current_page_end, SELECTOR_ITEMS_PER_PAGE * SELECTOR_PREFETCH_PAGE_COUNT);
+    selector_build_page();
+}
+
+static void selector_build_page()
 {
     SDL_Rect row_area_rect = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT/2 };
     SDL_Rect row_rects[SELECTOR_ITEMS_PER_PAGE];
@@ -106,12 +99,7 @@ static void selector_refresh()
         sui_rect_row(&row_area_rect, row_rects + SELECTOR_ITEMS_PER_PAGE/2, SELECTOR_ITEMS_PER_PAGE/2, SCENARIO_ICON_SIDE, SCENARIO_ICON_SIDE, 20);
     }
 
-    uint8_t num_id = (uint8_t)game.selector.pager.current_page_start;
-    char sch_icon_id [] = "SelectorSchIcon000";
-    char sch_name_id [] = "SelectorSchName000";
-
-    sprintf(&sch_icon_id[15], "%03"PRIu8, num_id);
-    sprintf(&sch_name_id[15], "%03"PRIu8, num_id);
+    TTF_Font* browser_font = assetman_get_asset("$Font35pt");
 
     for (size_t i = game.selector.pager.current_page_start; i < game.selector.pager.current_page_end; i++)
     {
@@ -120,9 +108,12 @@ static void selector_refresh()
         string_t path_of_scenario_to_load = array_ele(&game.selector.file_paths, string_t, i);
 
         sui_button_element_add(&row_rects[i_relative_to_page], game_set_mode_scenario, path_of_scenario_to_load);
-        sui_texture_element_add_v1(&row_rects[i_relative_to_page], assetman_get_asset(sch_icon_id));
 
-        SDL_Texture* name_texture = assetman_get_asset(sch_name_id);
+        SDL_Texture* name_texture = thumbnail_loader_name(&game.selector.thumbnails, game.renderer, browser_font, (SDL_Color){ 135, 131, 209, 255 }, i);
+
+        if(name_texture == NULL) name_texture = assetman_get_asset("$DefaultSchName");
+
+        game.selector.icon_elements[i_relative_to_page] = sui_texture_element_add_v1(&row_rects[i_relative_to_page], selector_icon_texture(i));
 
         int text_width;
         int text_height;
@@ -133,10 +124,6 @@ static void selector_refresh()
         text_rect.y += SCENARIO_TEXT_OFFSET;
 
         sui_texture_element_add_v1(&text_rect, name_texture);
-
-        num_id++;
-        sprintf(&sch_icon_id[15], "%03"PRIu8, num_id);
-        sprintf(&sch_name_id[15], "%03"PRIu8, num_id);
     }
 
     if(!pager_is_first_page(&game.selector.pager))
@@ -206,11 +193,27 @@ static void selector_section_navbar(bool is_standard_section)
 static void selector_go_to_next_page(void* event_data)
 {
     pager_next_page(&game.selector.pager);
-    selector_refresh();
+    selector_show_page();
 }
 
 static void selector_go_to_prev_page(void* event_data)
 {
     pager_prev_page(&game.selector.pager);
-    selector_refresh();
-}
\ No newline at end of file
+    selector_show_page();
+}
+
+/* Thumbnails only change the icons of the page, the other elements are left as they were built */
+static void selector_update_icons()
+{
+    for (size_t i = game.selector.pager.current_page_start; i < game.selector.pager.current_page_end; i++)
+        game.selector.icon_elements[i - game.selector.pager.current_page_start]->texture = selector_icon_texture(i);
+
+    sui_invalidate();
+}
+
+static SDL_Texture* selector_icon_texture(size_t index)
+{
+    SDL_Texture* icon_texture = thumbnail_loader_icon(&game.selector.thumbnails, index);
+
+    return icon_texture != NULL ? icon_texture : assetman_get_asset("$DefaultSchIcon");
+}
@@ -150,6 +150,28 @@ size_t string_view_length(string_view_t string_view)
     return string_view.length;
 }
 
+string_view_t string_view_from_string(string_t string)
+{
+    string_view_t view;
+    view.length = string_length(string);
+    view.start = string;
+    return view;
+}
+
+bool string_view_equals(string_view_t viewA, string_view_t viewB)
+{
+    size_t i;
+
+    if(viewA.length != viewB.length) return false;
+
+    for (i = 0; i < viewA.length; i++)
+    {
+        if(viewA.start[i] != viewB.start[i]) return false;
+    }
+
+    return true;
+}
+
 string_t string_view_to_heap_string(string_view_t view)
 {
     string_t string = malloc(view.length + 1);
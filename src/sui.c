@@ -1,10 +1,18 @@
+#include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 
 #include "include/sui.h"
+#include "include/sui_text_cache.h"
+#include "include/profiler.h"
 
-static size_t elements_current_index = 0;
-static sui_generic_element_t elements [MAX_GLOBAL_ELEMENT_COUNT];
+static sui_element_set_t default_elements = { .is_hit_grid_dirty = true };
+static sui_element_set_t* active_elements = &default_elements;
+static bool is_dirty = true;
+
+static sui_generic_element_t* sui_elements_alloc(size_t count);
+static void sui_element_init(sui_generic_element_t* element, sui_element_type_t type, SDL_Rect* rect);
+static void sui_hit_grid_build(sui_element_set_t* set);
 
 static bool is_position_inside_rect(SDL_Rect* rect, int pixelX, int pixelY)
 {
@@ -40,9 +48,11 @@ SDL_Rect sui_get_texture_rect(SDL_Texture* texture, int x, int y)
 
 SDL_Texture* sui_texture_from_text(SDL_Renderer* renderer, TTF_Font* font, char* text, SDL_Color text_color)
 {
-    SDL_Texture* text_texture;
+    SDL_Texture* text_texture = sui_text_cache_render(renderer, font, text, false, text_color);
     SDL_Surface* text_surface;
 
+    if(text_texture != NULL) return text_texture;
+
     text_surface = TTF_RenderText_Blended(font, text, text_color);
 
     if(text_surface == NULL) return NULL;
@@ -56,9 +66,11 @@ SDL_Texture* sui_texture_from_text(SDL_Renderer* renderer, TTF_Font* font, char*
 
 SDL_Texture* sui_texture_from_utf8_text(SDL_Renderer* renderer, TTF_Font* font, char* text, SDL_Color text_color)
 {
-    SDL_Texture* text_texture;
+    SDL_Texture* text_texture = sui_text_cache_render(renderer, font, text, true, text_color);
     SDL_Surface* text_surface;
 
+    if(text_texture != NULL) return text_texture;
+
     text_surface = TTF_RenderUTF8_Blended(font, text, text_color);
 
     if(text_surface == NULL) return NULL;
@@ -72,17 +84,11 @@ SDL_Texture* sui_texture_from_utf8_text(SDL_Renderer* renderer, TTF_Font* font,
 
 sui_element_t* sui_element_add(sui_element_type_t type, SDL_Rect* rect)
 {
-    if(elements_current_index >= MAX_GLOBAL_ELEMENT_COUNT) return NULL;
-
-    sui_element_t* element = &elements[elements_current_index].element;
-
-    memset(element, 0, sizeof(sui_generic_element_t));
-    element->type = type;
-    if(rect != NULL) element->rect = *rect;
+    sui_generic_element_t* element = sui_elements_alloc(1);
 
-    elements_current_index++;
+    sui_element_init(element, type, rect);
 
-    return element;
+    return &element->element;
 }
 
 sui_button_t* sui_button_element_add(SDL_Rect* rect, sui_click_event_t event, void* event_data)
@@ -118,27 +124,24 @@ sui_solid_rect_t* sui_solid_rect_element_add(SDL_Rect* rect, SDL_Color color)
 
 sui_simple_button_t* sui_simple_button_with_text_add(SDL_Renderer* renderer, SDL_Rect* rect, TTF_Font* font, char* text, sui_click_event_t event, void* event_data, SDL_Color text_color, SDL_Color background_color)
 {
-    sui_button_t* button_trigger = sui_button_element_add(rect, event, event_data);
-    sui_solid_rect_t* button_background = sui_solid_rect_element_add(rect, background_color);
-    sui_texture_t* button_text = (sui_texture_t*)sui_element_add(SUI_TEXTURE_COMPONENT_TYPE, NULL);
-
-    button_text->texture = sui_texture_from_text(renderer, font, text, text_color);
-
-    int button_text_width;
-    int button_text_height;
-    SDL_QueryTexture(button_text->texture, NULL, NULL, &button_text_width, &button_text_height);
-
-    button_text->element.rect = sui_rect_centered(rect, button_text_width, button_text_height);
-
-    return (sui_simple_button_t*)button_trigger;
+    return sui_simple_button_with_texture_add(rect, sui_texture_from_text(renderer, font, text, text_color), event, event_data, background_color);
 }
 
 sui_simple_button_t* sui_simple_button_with_texture_add(SDL_Rect* rect, SDL_Texture* texture, sui_click_event_t event, void* event_data, SDL_Color background_color)
 {
-    sui_button_t* button_trigger = sui_button_element_add(rect, event, event_data);
-    sui_solid_rect_t* button_background = sui_solid_rect_element_add(rect, background_color);
-    sui_texture_t* button_text = (sui_texture_t*)sui_element_add(SUI_TEXTURE_COMPONENT_TYPE, NULL);
+    /* The three elements are allocated together since the caller sees them as one sui_simple_button_t */
+    sui_simple_button_t* simple_button = (sui_simple_button_t*)sui_elements_alloc(3);
 
+    sui_element_init(&simple_button->button_trigger, SUI_BUTTON_COMPONENT_TYPE, rect);
+    sui_element_init(&simple_button->background, SUI_SOLID_RECT_COMPONENT_TYPE, rect);
+    sui_element_init(&simple_button->text, SUI_TEXTURE_COMPONENT_TYPE, NULL);
+
+    sui_button_t* button_trigger = &simple_button->button_trigger.as_button_element;
+    sui_texture_t* button_text = &simple_button->text.as_texture_element;
+
+    button_trigger->event = event;
+    button_trigger->event_data = event_data;
+    simple_button->background.as_solidrect_element.color = background_color;
     button_text->texture = texture;
 
     int button_text_width;
@@ -212,17 +215,30 @@ void sui_rect_column(SDL_Rect* container, SDL_Rect* rect_array, size_t count, si
 
 void sui_check_buttons(int mouseX, int mouseY)
 {
-    size_t i;
+    sui_element_set_t* set = active_elements;
+
+    if(set->is_hit_grid_dirty) sui_hit_grid_build(set);
 
-    for (i = 0; i < elements_current_index; i++)
+    int column = mouseX - set->hit_grid_x;
+    int row = mouseY - set->hit_grid_y;
+
+    if(column < 0 || row < 0) return;
+
+    column /= SUI_HIT_GRID_CELL_SIZE;
+    row /= SUI_HIT_GRID_CELL_SIZE;
+
+    if(column >= set->hit_grid_columns || row >= set->hit_grid_rows) return;
+
+    size_t cell = (size_t)row * (size_t)set->hit_grid_columns + (size_t)column;
+
+    for (size_t i = set->hit_grid_cell_starts[cell]; i < set->hit_grid_cell_starts[cell + 1]; i++)
     {
-        sui_generic_element_t* element = &elements[i];
+        sui_button_t* button = set->hit_grid_buttons[i];
 
-        if(element->element.type != SUI_BUTTON_COMPONENT_TYPE) continue;
-        
-        if(is_position_inside_rect(&element->element.rect, mouseX, mouseY))
+        if(is_position_inside_rect(&button->element.rect, mouseX, mouseY))
         {
-            element->as_button_element.event(element->as_button_element.event_data);
+            button->event(button->event_data);
+            is_dirty = true;
             return;
         }
     }
@@ -230,36 +246,218 @@ void sui_check_buttons(int mouseX, int mouseY)
 
 void sui_draw_elements(SDL_Renderer* renderer)
 {
-    size_t i;
+    PROFILER_BEGIN(PROFILER_SCOPE_SUI_DRAW);
 
-    for (i = 0; i < elements_current_index; i++)
+    for (size_t chunk_index = 0; chunk_index < active_elements->chunk_count; chunk_index++)
     {
-        sui_generic_element_t* element = &elements[i];
+        sui_element_chunk_t* chunk = active_elements->chunks[chunk_index];
 
-        switch (element->element.type)
+        for (size_t i = 0; i < chunk->count; i++)
         {
-            case SUI_BUTTON_COMPONENT_TYPE:
-                break;                
-            case SUI_TEXTURE_COMPONENT_TYPE:
-                if(element->as_texture_element.texture == NULL) break;
-                SDL_RenderCopy(renderer, element->as_texture_element.texture, NULL, &element->element.rect);
-                break;
-            case SUI_SOLID_RECT_COMPONENT_TYPE:
-                SDL_SetRenderDrawColor(renderer, 
-                                        element->as_solidrect_element.color.r, 
-                                        element->as_solidrect_element.color.g, 
-                                        element->as_solidrect_element.color.b, 
-                                        element->as_solidrect_element.color.a);
-                
-                SDL_RenderFillRect(renderer, &element->element.rect);
-                break;
-            default:
-                break;
+            sui_generic_element_t* element = &chunk->elements[i];
+
+            switch (element->element.type)
+            {
+                case SUI_BUTTON_COMPONENT_TYPE:
+                    break;                
+                case SUI_TEXTURE_COMPONENT_TYPE:
+                    if(element->as_texture_element.texture == NULL) break;
+                    SDL_RenderCopy(renderer, element->as_texture_element.texture, NULL, &element->element.rect);
+                    break;
+                case SUI_SOLID_RECT_COMPONENT_TYPE:
+                    SDL_SetRenderDrawColor(renderer, 
+                                            element->as_solidrect_element.color.r, 
+                                            element->as_solidrect_element.color.g, 
+                                            element->as_solidrect_element.color.b, 
+                                            element->as_solidrect_element.color.a);
+                    
+                    SDL_RenderFillRect(renderer, &element->element.rect);
+                    break;
+                default:
+                    break;
+            }
         }
     }
+
+    is_dirty = false;
+
+    PROFILER_END(PROFILER_SCOPE_SUI_DRAW);
 }
 
 void sui_clear_elements()
 {
-    elements_current_index = 0;
-}
\ No newline at end of file
+    active_elements->chunk_count = 0;
+    active_elements->is_hit_grid_dirty = true;
+    is_dirty = true;
+}
+
+void sui_element_set_init(sui_element_set_t* set)
+{
+    *set = (sui_element_set_t){0};
+    set->is_hit_grid_dirty = true;
+}
+
+void sui_element_set_free(sui_element_set_t* set)
+{
+    if(active_elements == set) active_elements = &default_elements;
+
+    for (size_t i = 0; i < set->allocated_chunk_count; i++)
+        free(set->chunks[i]);
+
+    free(set->chunks);
+    free(set->hit_grid_cell_starts);
+    free(set->hit_grid_buttons);
+
+    sui_element_set_init(set);
+}
+
+void sui_element_set_activate(sui_element_set_t* set)
+{
+    active_elements = set != NULL ? set : &default_elements;
+    is_dirty = true;
+}
+
+sui_element_set_t* sui_active_element_set()
+{
+    return active_elements;
+}
+
+void sui_invalidate()
+{
+    active_elements->is_hit_grid_dirty = true;
+    is_dirty = true;
+}
+
+bool sui_is_dirty()
+{
+    return is_dirty;
+}
+
+static sui_generic_element_t* sui_elements_alloc(size_t count)
+{
+    sui_element_set_t* set = active_elements;
+
+    if(set->chunk_count == 0 || set->chunks[set->chunk_count - 1]->count + count > SUI_ELEMENT_CHUNK_SIZE)
+    {
+        if(set->chunk_count == set->allocated_chunk_count)
+        {
+            if(set->allocated_chunk_count == set->chunk_capacity)
+            {
+                set->chunk_capacity = set->chunk_capacity > 0 ? 2 * set->chunk_capacity : 4;
+                set->chunks = realloc(set->chunks, set->chunk_capacity * sizeof(sui_element_chunk_t*));
+            }
+
+            set->chunks[set->allocated_chunk_count++] = malloc(sizeof(sui_element_chunk_t));
+        }
+
+        set->chunks[set->chunk_count++]->count = 0;
+    }
+
+    sui_element_chunk_t* chunk = set->chunks[set->chunk_count - 1];
+    sui_generic_element_t* elements = &chunk->elements[chunk->count];
+
+    chunk->count += count;
+    set->is_hit_grid_dirty = true;
+    is_dirty = true;
+
+    return elements;
+}
+
+static void sui_element_init(sui_generic_element_t* element, sui_element_type_t type, SDL_Rect* rect)
+{
+    memset(element, 0, sizeof(sui_generic_element_t));
+    element->element.type = type;
+    if(rect != NULL) element->element.rect = *rect;
+}
+
+/* Counts the buttons of every cell, then fills the cells in the order the buttons were added so the first button added still wins */
+static void sui_hit_grid_build(sui_element_set_t* set)
+{
+    int min_x = 0;
+    int min_y = 0;
+    int max_x = 0;
+    int max_y = 0;
+    size_t button_count = 0;
+
+    set->is_hit_grid_dirty = false;
+    set->hit_grid_columns = 0;
+    set->hit_grid_rows = 0;
+
+    for (size_t chunk_index = 0; chunk_index < set->chunk_count; chunk_index++)
+    {
+        sui_element_chunk_t* chunk = set->chunks[chunk_index];
+
+        for (size_t i = 0; i < chunk->count; i++)
+        {
+            SDL_Rect* rect = &chunk->elements[i].element.rect;
+
+            if(chunk->elements[i].element.type != SUI_BUTTON_COMPONENT_TYPE) continue;
+
+            if(button_count == 0 || rect->x < min_x) min_x = rect->x;
+            if(button_count == 0 || rect->y < min_y) min_y = rect->y;
+            if(button_count == 0 || rect->x + rect->w > max_x) max_x = rect->x + rect->w;
+            if(button_count == 0 || rect->y + rect->h > max_y) max_y = rect->y + rect->h;
+
+            button_count++;
+        }
+    }
+
+    if(button_count == 0) return;
+
+    set->hit_grid_x = min_x;
+    set->hit_grid_y = min_y;
+    set->hit_grid_columns = (max_x - min_x) / SUI_HIT_GRID_CELL_SIZE + 1;
+    set->hit_grid_rows = (max_y - min_y) / SUI_HIT_GRID_CELL_SIZE + 1;
+
+    size_t cell_count = (size_t)set->hit_grid_columns * (size_t)set->hit_grid_rows;
+
+    set->hit_grid_cell_starts = realloc(set->hit_grid_cell_starts, (cell_count + 1) * sizeof(size_t));
+    memset(set->hit_grid_cell_starts, 0, (cell_count + 1) * sizeof(size_t));
+
+    size_t* cell_ends = calloc(cell_count, sizeof(size_t));
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (size_t chunk_index = 0; chunk_index < set->chunk_count; chunk_index++)
+        {
+            sui_element_chunk_t* chunk = set->chunks[chunk_index];
+
+            for (size_t i = 0; i < chunk->count; i++)
+            {
+                SDL_Rect* rect = &chunk->elements[i].element.rect;
+
+                if(chunk->elements[i].element.type != SUI_BUTTON_COMPONENT_TYPE) continue;
+
+                int first_column = (rect->x - min_x) / SUI_HIT_GRID_CELL_SIZE;
+                int last_column = (rect->x + rect->w - min_x) / SUI_HIT_GRID_CELL_SIZE;
+                int first_row = (rect->y - min_y) / SUI_HIT_GRID_CELL_SIZE;
+                int last_row = (rect->y + rect->h - min_y) / SUI_HIT_GRID_CELL_SIZE;
+
+                for (int row = first_row; row <= last_row; row++)
+                {
+                    for (int column = first_column; column <= last_column; column++)
+                    {
+                        size_t cell = (size_t)row * (size_t)set->hit_grid_columns + (size_t)column;
+
+                        if(pass == 0)
+                            set->hit_grid_cell_starts[cell + 1]++;
+                        else
+                            set->hit_grid_buttons[cell_ends[cell]++] = &chunk->elements[i].as_button_element;
+                    }
+                }
+            }
+        }
+
+        if(pass == 1) break;
+
+        for (size_t cell = 0; cell < cell_count; cell++)
+        {
+            set->hit_grid_cell_starts[cell + 1] += set->hit_grid_cell_starts[cell];
+            cell_ends[cell] = set->hit_grid_cell_starts[cell];
+        }
+
+        set->hit_grid_buttons = realloc(set->hit_grid_buttons, (set->hit_grid_cell_starts[cell_count] + 1) * sizeof(sui_button_t*));
+    }
+
+    free(cell_ends);
+}
@@ -0,0 +1,379 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/sui_text_cache.h"
+
+typedef struct
+{
+    Uint32 codepoint;
+    SDL_Rect rect;
+    /* Left side of the rasterized glyph relative to the pen */
+    int offset_x;
+    int advance;
+    bool is_loaded;
+} sui_glyph_t;
+
+typedef struct
+{
+    TTF_Font* font;
+    /* Kept in memory only, text textures are composed on the CPU so none of them is a render target */
+    SDL_Surface* surface;
+    int pen_x;
+    int pen_y;
+    int row_height;
+    sui_glyph_t direct_glyphs [SUI_GLYPH_ATLAS_DIRECT_GLYPH_COUNT];
+    sui_glyph_t extra_glyphs [SUI_GLYPH_ATLAS_EXTRA_GLYPH_COUNT];
+    size_t extra_glyph_count;
+} sui_glyph_atlas_t;
+
+typedef struct
+{
+    TTF_Font* font;
+    SDL_Color text_color;
+    bool is_utf8;
+    char* text;
+    SDL_Texture* texture;
+    Uint64 last_use;
+} sui_text_cache_entry_t;
+
+typedef struct
+{
+    sui_glyph_atlas_t* atlases [SUI_GLYPH_ATLAS_MAX_FONTS];
+    size_t atlas_count;
+    sui_text_cache_entry_t entries [SUI_TEXT_CACHE_CAPACITY];
+    size_t entry_count;
+    Uint64 use_counter;
+} sui_text_cache_t;
+
+static sui_text_cache_t text_cache = {0};
+
+static sui_glyph_atlas_t* sui_glyph_atlas_of(TTF_Font* font);
+static const sui_glyph_t* sui_glyph_atlas_glyph(sui_glyph_atlas_t* atlas, Uint32 codepoint);
+static bool sui_glyph_atlas_load(sui_glyph_atlas_t* atlas, sui_glyph_t* glyph, Uint32 codepoint);
+static size_t sui_text_decode(const char* text, bool is_utf8, Uint32* out_codepoints);
+static void sui_text_compose_glyph(SDL_Surface* text_surface, const SDL_Surface* atlas_surface, const SDL_Rect* glyph_rect, int x);
+
+SDL_Texture* sui_text_cache_render(SDL_Renderer* renderer, TTF_Font* font, const char* text, bool is_utf8, SDL_Color text_color)
+{
+    if(font == NULL || text == NULL || text[0] == '\0') return NULL;
+
+    sui_glyph_atlas_t* atlas = sui_glyph_atlas_of(font);
+
+    if(atlas == NULL) return NULL;
+
+    Uint32* codepoints = malloc(strlen(text) * sizeof(Uint32));
+    const sui_glyph_t** glyphs = malloc(strlen(text) * sizeof(sui_glyph_t*));
+    int* pen_positions = malloc(strlen(text) * sizeof(int));
+    size_t glyph_count = sui_text_decode(text, is_utf8, codepoints);
+
+    int pen_x = 0;
+    int left = 0;
+    int right = 0;
+    int height = 0;
+    bool has_all_glyphs = true;
+
+    for (size_t i = 0; i < glyph_count && has_all_glyphs; i++)
+    {
+        glyphs[i] = sui_glyph_atlas_glyph(atlas, codepoints[i]);
+
+        if(glyphs[i] == NULL)
+        {
+            has_all_glyphs = false;
+            break;
+        }
+
+        if(i > 0) pen_x += TTF_GetFontKerningSizeGlyphs(font, (Uint16)codepoints[i - 1], (Uint16)codepoints[i]);
+
+        pen_positions[i] = pen_x;
+
+        if(glyphs[i]->rect.w > 0)
+        {
+            if(pen_x + glyphs[i]->offset_x < left) left = pen_x + glyphs[i]->offset_x;
+            if(pen_x + glyphs[i]->offset_x + glyphs[i]->rect.w > right) right = pen_x + glyphs[i]->offset_x + glyphs[i]->rect.w;
+            if(glyphs[i]->rect.h > height) height = glyphs[i]->rect.h;
+        }
+
+        pen_x += glyphs[i]->advance;
+    }
+
+    SDL_Texture* text_texture = NULL;
+    SDL_Surface* text_surface = NULL;
+
+    if(has_all_glyphs && right > left && height > 0)
+        text_surface = SDL_CreateRGBSurfaceWithFormat(0, right - left, height, 32, SDL_PIXELFORMAT_ARGB8888);
+
+    /* Static textures keep their pixels when the renderer loses its render targets, a window going fullscreen for instance */
+    if(text_surface != NULL)
+    {
+        /* Transparent pixels keep the color of the text so filtering does not darken the edges */
+        SDL_FillRect(text_surface, NULL, SDL_MapRGBA(text_surface->format, text_color.r, text_color.g, text_color.b, 0));
+
+        for (size_t i = 0; i < glyph_count; i++)
+        {
+            if(glyphs[i]->rect.w == 0) continue;
+
+            sui_text_compose_glyph(text_surface, atlas->surface, &glyphs[i]->rect, pen_positions[i] + glyphs[i]->offset_x - left);
+        }
+
+        text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
+        SDL_FreeSurface(text_surface);
+    }
+
+    if(text_texture != NULL)
+    {
+        SDL_SetTextureBlendMode(text_texture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureAlphaMod(text_texture, text_color.a);
+    }
+
+    free(codepoints);
+    free(glyphs);
+    free(pen_positions);
+
+    return text_texture;
+}
+
+SDL_Texture* sui_text_cache_get(SDL_Renderer* renderer, TTF_Font* font, const char* text, bool is_utf8, SDL_Color text_color)
+{
+    if(font == NULL || text == NULL || text[0] == '\0') return NULL;
+
+    sui_text_cache_entry_t* least_recently_used = &text_cache.entries[0];
+
+    text_cache.use_counter++;
+
+    for (size_t i = 0; i < text_cache.entry_count; i++)
+    {
+        sui_text_cache_entry_t* entry = &text_cache.entries[i];
+
+        if(entry->font == font && entry->is_utf8 == is_utf8 && memcmp(&entry->text_color, &text_color, sizeof(SDL_Color)) == 0 && strcmp(entry->text, text) == 0)
+        {
+            entry->last_use = text_cache.use_counter;
+            return entry->texture;
+        }
+
+        if(entry->last_use < least_recently_used->last_use) least_recently_used = entry;
+    }
+
+    SDL_Texture* text_texture = sui_text_cache_render(renderer, font, text, is_utf8, text_color);
+
+    if(text_texture == NULL)
+    {
+        SDL_Surface* text_surface = is_utf8 ? TTF_RenderUTF8_Blended(font, text, text_color) : TTF_RenderText_Blended(font, text, text_color);
+
+        if(text_surface == NULL) return NULL;
+
+        text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
+        SDL_FreeSurface(text_surface);
+    }
+
+    sui_text_cache_entry_t* entry = least_recently_used;
+
+    if(text_cache.entry_count < SUI_TEXT_CACHE_CAPACITY)
+    {
+        entry = &text_cache.entries[text_cache.entry_count++];
+    }
+    else
+    {
+        SDL_DestroyTexture(entry->texture);
+        free(entry->text);
+    }
+
+    size_t text_length = strlen(text);
+
+    entry->font = font;
+    entry->text_color = text_color;
+    entry->is_utf8 = is_utf8;
+    entry->text = malloc(text_length + 1);
+    entry->texture = text_texture;
+    entry->last_use = text_cache.use_counter;
+
+    memcpy(entry->text, text, text_length + 1);
+
+    return text_texture;
+}
+
+void sui_text_cache_free()
+{
+    for (size_t i = 0; i < text_cache.entry_count; i++)
+    {
+        SDL_DestroyTexture(text_cache.entries[i].texture);
+        free(text_cache.entries[i].text);
+    }
+
+    for (size_t i = 0; i < text_cache.atlas_count; i++)
+    {
+        SDL_FreeSurface(text_cache.atlases[i]->surface);
+        free(text_cache.atlases[i]);
+    }
+
+    text_cache = (sui_text_cache_t){0};
+}
+
+static sui_glyph_atlas_t* sui_glyph_atlas_of(TTF_Font* font)
+{
+    for (size_t i = 0; i < text_cache.atlas_count; i++)
+    {
+        if(text_cache.atlases[i]->font == font) return text_cache.atlases[i];
+    }
+
+    if(text_cache.atlas_count == SUI_GLYPH_ATLAS_MAX_FONTS) return NULL;
+
+    SDL_Surface* atlas_surface = SDL_CreateRGBSurfaceWithFormat(0, SUI_GLYPH_ATLAS_SIZE, SUI_GLYPH_ATLAS_SIZE, 32, SDL_PIXELFORMAT_ARGB8888);
+
+    if(atlas_surface == NULL) return NULL;
+
+    SDL_SetSurfaceBlendMode(atlas_surface, SDL_BLENDMODE_NONE);
+
+    sui_glyph_atlas_t* atlas = calloc(1, sizeof(sui_glyph_atlas_t));
+
+    atlas->font = font;
+    atlas->surface = atlas_surface;
+    atlas->pen_x = SUI_GLYPH_ATLAS_PADDING;
+    atlas->pen_y = SUI_GLYPH_ATLAS_PADDING;
+
+    text_cache.atlases[text_cache.atlas_count++] = atlas;
+
+    return atlas;
+}
+
+static const sui_glyph_t* sui_glyph_atlas_glyph(sui_glyph_atlas_t* atlas, Uint32 codepoint)
+{
+    sui_glyph_t* glyph;
+
+    if(codepoint < SUI_GLYPH_ATLAS_DIRECT_GLYPH_COUNT)
+    {
+        glyph = &atlas->direct_glyphs[codepoint];
+    }
+    else
+    {
+        for (size_t i = 0; i < atlas->extra_glyph_count; i++)
+        {
+            if(atlas->extra_glyphs[i].codepoint == codepoint) return &atlas->extra_glyphs[i];
+        }
+
+        if(atlas->extra_glyph_count == SUI_GLYPH_ATLAS_EXTRA_GLYPH_COUNT) return NULL;
+
+        glyph = &atlas->extra_glyphs[atlas->extra_glyph_count];
+    }
+
+    if(glyph->is_loaded) return glyph;
+
+    if(!sui_glyph_atlas_load(atlas, glyph, codepoint)) return NULL;
+
+    if(codepoint >= SUI_GLYPH_ATLAS_DIRECT_GLYPH_COUNT) atlas->extra_glyph_count++;
+
+    return glyph;
+}
+
+/* Glyphs are rasterized in white and tinted when they are drawn, so one atlas serves every color */
+static bool sui_glyph_atlas_load(sui_glyph_atlas_t* atlas, sui_glyph_t* glyph, Uint32 codepoint)
+{
+    int min_x;
+    int advance;
+
+    /* The SDL_ttf shipped with the game only takes 16 bit codepoints */
+    if(codepoint > 0xFFFF || TTF_GlyphMetrics(atlas->font, (Uint16)codepoint, &min_x, NULL, NULL, NULL, &advance) != 0) return false;
+
+    glyph->codepoint = codepoint;
+    glyph->offset_x = min_x < 0 ? min_x : 0;
+    glyph->advance = advance;
+    glyph->rect = (SDL_Rect){ 0, 0, 0, 0 };
+
+    SDL_Surface* glyph_surface = TTF_RenderGlyph_Blended(atlas->font, (Uint16)codepoint, (SDL_Color){ 255, 255, 255, 255 });
+
+    /* Blank glyphs like spaces only move the pen */
+    if(glyph_surface == NULL)
+    {
+        glyph->is_loaded = true;
+        return true;
+    }
+
+    SDL_Surface* converted_surface = SDL_ConvertSurfaceFormat(glyph_surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(glyph_surface);
+
+    if(converted_surface == NULL) return false;
+
+    if(atlas->pen_x + converted_surface->w + SUI_GLYPH_ATLAS_PADDING > SUI_GLYPH_ATLAS_SIZE)
+    {
+        atlas->pen_x = SUI_GLYPH_ATLAS_PADDING;
+        atlas->pen_y += atlas->row_height + SUI_GLYPH_ATLAS_PADDING;
+        atlas->row_height = 0;
+    }
+
+    if(converted_surface->w + 2 * SUI_GLYPH_ATLAS_PADDING > SUI_GLYPH_ATLAS_SIZE || atlas->pen_y + converted_surface->h + SUI_GLYPH_ATLAS_PADDING > SUI_GLYPH_ATLAS_SIZE)
+    {
+        SDL_FreeSurface(converted_surface);
+        return false;
+    }
+
+    glyph->rect = (SDL_Rect){ atlas->pen_x, atlas->pen_y, converted_surface->w, converted_surface->h };
+
+    SDL_SetSurfaceBlendMode(converted_surface, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(converted_surface, NULL, atlas->surface, &glyph->rect);
+
+    atlas->pen_x += converted_surface->w + SUI_GLYPH_ATLAS_PADDING;
+
+    if(converted_surface->h > atlas->row_height) atlas->row_height = converted_surface->h;
+
+    SDL_FreeSurface(converted_surface);
+
+    glyph->is_loaded = true;
+
+    return true;
+}
+
+/* Text which is not UTF-8 is Latin-1, like for TTF_RenderText, invalid UTF-8 bytes are read as Latin-1 too */
+static size_t sui_text_decode(const char* text, bool is_utf8, Uint32* out_codepoints)
+{
+    const unsigned char* bytes = (const unsigned char*)text;
+    size_t codepoint_count = 0;
+
+    while(*bytes != '\0')
+    {
+        Uint32 codepoint = *bytes;
+        size_t continuation_count = 0;
+
+        if(is_utf8 && (codepoint & 0xE0) == 0xC0) { codepoint &= 0x1F; continuation_count = 1; }
+        else if(is_utf8 && (codepoint & 0xF0) == 0xE0) { codepoint &= 0x0F; continuation_count = 2; }
+        else if(is_utf8 && (codepoint & 0xF8) == 0xF0) { codepoint &= 0x07; continuation_count = 3; }
+
+        size_t i;
+
+        for (i = 1; i <= continuation_count && (bytes[i] & 0xC0) == 0x80; i++)
+            codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+
+        if(i <= continuation_count)
+        {
+            codepoint = *bytes;
+            i = 1;
+        }
+
+        out_codepoints[codepoint_count++] = codepoint;
+        bytes += i;
+    }
+
+    return codepoint_count;
+}
+
+/* Glyphs only ever overlap with pixels of the same color, so the color stays and only the coverage accumulates */
+static void sui_text_compose_glyph(SDL_Surface* text_surface, const SDL_Surface* atlas_surface, const SDL_Rect* glyph_rect, int x)
+{
+    for (int row = 0; row < glyph_rect->h && row < text_surface->h; row++)
+    {
+        const Uint32* source_pixels = (const Uint32*)((const Uint8*)atlas_surface->pixels + (glyph_rect->y + row) * atlas_surface->pitch) + glyph_rect->x;
+        Uint32* destination_pixels = (Uint32*)((Uint8*)text_surface->pixels + row * text_surface->pitch);
+
+        for (int column = 0; column < glyph_rect->w; column++)
+        {
+            int destination_x = x + column;
+
+            if(destination_x < 0 || destination_x >= text_surface->w) continue;
+
+            Uint32 source_alpha = source_pixels[column] >> 24;
+            Uint32 destination_pixel = destination_pixels[destination_x];
+            Uint32 destination_alpha = destination_pixel >> 24;
+            Uint32 alpha = source_alpha + destination_alpha * (255 - source_alpha) / 255;
+
+            destination_pixels[destination_x] = (alpha << 24) | (destination_pixel & 0x00FFFFFF);
+        }
+    }
+}
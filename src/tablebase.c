@@ -0,0 +1,325 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/tablebase.h"
+#include "include/logger.h"
+
+static const cell_value_t tablebase_group_piece_types [TABLEBASE_GROUP_COUNT] =
+{
+    PIECE_WHITE_PEON,
+    PIECE_BLACK_PEON,
+    PIECE_WHITE_QUEEN,
+    PIECE_BLACK_QUEEN
+};
+
+enum
+{
+    TABLEBASE_BINOMIALS_NOT_BUILT,
+    TABLEBASE_BINOMIALS_BUILDING,
+    TABLEBASE_BINOMIALS_BUILT
+};
+
+static uint64_t tablebase_binomials [MAX_BOARD_PLAYABLE_CELL_COUNT + 1][TABLEBASE_MAX_PIECES_PER_GROUP + 1];
+static atomic_int tablebase_binomials_state = TABLEBASE_BINOMIALS_NOT_BUILT;
+
+static void tablebase_build_binomials();
+static bool tablebase_map_table(tablebase_t* tablebase, tablebase_table_t* table, tablebase_material_t material);
+
+void tablebase_open(tablebase_t* tablebase, const char* directory, const ruleset_t* rules)
+{
+    /* Every use of the binomials goes through an open tablebase, so building them here covers all the threads */
+    if(atomic_load_explicit(&tablebase_binomials_state, memory_order_acquire) != TABLEBASE_BINOMIALS_BUILT) tablebase_build_binomials();
+
+    snprintf(tablebase->directory, TABLEBASE_DIRECTORY_SIZE, "%s", directory);
+    tablebase->rules = *rules;
+    tablebase->geometry = board_geometry_of(rules);
+    tablebase->tables = calloc(TABLEBASE_TABLE_SLOT_COUNT, sizeof(tablebase_table_t));
+
+    if(tablebase->tables == NULL)
+    {
+        LOGGER_ERRORS("Not enough memory for the tablebase tables!");
+        exit(EXIT_FAILURE);
+    }
+
+    atomic_flag_clear(&tablebase->load_lock);
+}
+
+void tablebase_close(tablebase_t* tablebase)
+{
+    for (size_t i = 0; i < TABLEBASE_TABLE_SLOT_COUNT; i++)
+    {
+        if(tablebase->tables[i].mapping.data != NULL) file_mapping_close(&tablebase->tables[i].mapping);
+    }
+
+    free(tablebase->tables);
+    tablebase->tables = NULL;
+}
+
+tablebase_material_t tablebase_material_of(const tablebase_t* tablebase, const board_t* board)
+{
+    tablebase_material_t material = {0};
+
+    for (cell_id_t cid = 0; cid < tablebase->geometry->playable_cell_count; cid++)
+    {
+        for (uint8_t g = 0; g < TABLEBASE_GROUP_COUNT; g++)
+        {
+            if(board->playable_cells[cid] == tablebase_group_piece_types[g]) material.counts[g]++;
+        }
+    }
+
+    return material;
+}
+
+size_t tablebase_material_slot(tablebase_material_t material)
+{
+    size_t slot = 0;
+
+    for (uint8_t g = TABLEBASE_GROUP_COUNT; g > 0; g--)
+        slot = slot * (TABLEBASE_MAX_PIECES_PER_GROUP + 1) + material.counts[g - 1];
+
+    return slot;
+}
+
+unsigned tablebase_material_piece_count(tablebase_material_t material)
+{
+    return (unsigned)(material.counts[0] + material.counts[1] + material.counts[2] + material.counts[3]);
+}
+
+uint64_t tablebase_entry_count(const tablebase_t* tablebase, tablebase_material_t material)
+{
+    cell_id_t free_cell_count = tablebase->geometry->playable_cell_count;
+    uint64_t entry_count = 2;
+
+    for (uint8_t g = 0; g < TABLEBASE_GROUP_COUNT; g++)
+    {
+        entry_count *= tablebase_binomials[free_cell_count][material.counts[g]];
+        free_cell_count = (cell_id_t)(free_cell_count - material.counts[g]);
+    }
+
+    return entry_count;
+}
+
+/*
+ * Each group is a set of cells, ranked with the combinatorial number system among the cells left free
+ * by the previous groups, so every entry of a table is a distinct placement of its pieces.
+ */
+uint64_t tablebase_index(const tablebase_t* tablebase, tablebase_material_t material, const board_t* board, team_t playing_team)
+{
+    cell_id_t cell_count = tablebase->geometry->playable_cell_count;
+    cell_id_t free_cell_count = cell_count;
+    bool is_occupied [MAX_BOARD_PLAYABLE_CELL_COUNT] = {0};
+    uint64_t index = 0;
+
+    for (uint8_t g = 0; g < TABLEBASE_GROUP_COUNT; g++)
+    {
+        cell_id_t occupied_below = 0;
+        uint8_t placed = 0;
+        uint64_t rank = 0;
+
+        for (cell_id_t cid = 0; cid < cell_count; cid++)
+        {
+            if(is_occupied[cid])
+            {
+                occupied_below++;
+                continue;
+            }
+
+            if(board->playable_cells[cid] != tablebase_group_piece_types[g]) continue;
+
+            placed++;
+            rank += tablebase_binomials[cid - occupied_below][placed];
+        }
+
+        index = index * tablebase_binomials[free_cell_count][material.counts[g]] + rank;
+        free_cell_count = (cell_id_t)(free_cell_count - material.counts[g]);
+
+        for (cell_id_t cid = 0; cid < cell_count; cid++)
+        {
+            if(board->playable_cells[cid] == tablebase_group_piece_types[g]) is_occupied[cid] = true;
+        }
+    }
+
+    return index * 2 + (playing_team == BLACK_TEAM);
+}
+
+void tablebase_position_from_index(const tablebase_t* tablebase, tablebase_material_t material, uint64_t index, board_t* out_board, team_t* out_playing_team)
+{
+    cell_id_t cell_count = tablebase->geometry->playable_cell_count;
+    cell_id_t free_cell_count = cell_count;
+    bool is_occupied [MAX_BOARD_PLAYABLE_CELL_COUNT] = {0};
+    uint64_t radices [TABLEBASE_GROUP_COUNT];
+    uint64_t ranks [TABLEBASE_GROUP_COUNT];
+
+    *out_playing_team = index % 2 == 0 ? WHITE_TEAM : BLACK_TEAM;
+    index /= 2;
+
+    for (uint8_t g = 0; g < TABLEBASE_GROUP_COUNT; g++)
+    {
+        radices[g] = tablebase_binomials[free_cell_count][material.counts[g]];
+        free_cell_count = (cell_id_t)(free_cell_count - material.counts[g]);
+    }
+
+    for (uint8_t g = TABLEBASE_GROUP_COUNT; g > 0; g--)
+    {
+        ranks[g - 1] = index % radices[g - 1];
+        index /= radices[g - 1];
+    }
+
+    board_clear(out_board);
+
+    for (uint8_t g = 0; g < TABLEBASE_GROUP_COUNT; g++)
+    {
+        cell_id_t group_cells [TABLEBASE_MAX_PIECES_PER_GROUP];
+        uint64_t rank = ranks[g];
+
+        for (uint8_t placed = material.counts[g]; placed > 0; placed--)
+        {
+            cell_id_t free_index = (cell_id_t)(placed - 1);
+
+            while (tablebase_binomials[free_index + 1][placed] <= rank) free_index++;
+
+            rank -= tablebase_binomials[free_index][placed];
+
+            cell_id_t cid = 0;
+
+            for (cell_id_t seen_free_cells = 0; ; cid++)
+            {
+                if(is_occupied[cid]) continue;
+                if(seen_free_cells == free_index) break;
+                seen_free_cells++;
+            }
+
+            group_cells[placed - 1] = cid;
+        }
+
+        for (uint8_t i = 0; i < material.counts[g]; i++)
+        {
+            is_occupied[group_cells[i]] = true;
+            board_set_cell(out_board, group_cells[i], tablebase_group_piece_types[g]);
+        }
+    }
+}
+
+bool tablebase_table_file_path(const tablebase_t* tablebase, tablebase_material_t material, char* out_path, size_t path_size)
+{
+    int length = snprintf(out_path, path_size, "%s/%04x_%u%u%u%u.tb", tablebase->directory, (unsigned)ruleset_key(&tablebase->rules),
+        material.counts[0], material.counts[1], material.counts[2], material.counts[3]);
+
+    return length >= 0 && (size_t)length < path_size;
+}
+
+bool tablebase_load_table(tablebase_t* tablebase, tablebase_material_t material)
+{
+    tablebase_table_t* table = &tablebase->tables[tablebase_material_slot(material)];
+
+    if(atomic_load_explicit(&table->was_load_attempted, memory_order_acquire)) return table->values != NULL;
+
+    while(atomic_flag_test_and_set_explicit(&tablebase->load_lock, memory_order_acquire));
+
+    /* Another thread may have mapped it while this one was waiting */
+    if(!atomic_load_explicit(&table->was_load_attempted, memory_order_relaxed))
+    {
+        tablebase_map_table(tablebase, table, material);
+        atomic_store_explicit(&table->was_load_attempted, true, memory_order_release);
+    }
+
+    atomic_flag_clear_explicit(&tablebase->load_lock, memory_order_release);
+
+    return table->values != NULL;
+}
+
+bool tablebase_probe_value(tablebase_t* tablebase, const board_t* board, team_t playing_team, uint8_t* out_value)
+{
+    tablebase_material_t material = tablebase_material_of(tablebase, board);
+    unsigned white_piece_count = material.counts[TABLEBASE_GROUP_WHITE_PEONS] + material.counts[TABLEBASE_GROUP_WHITE_QUEENS];
+    unsigned black_piece_count = material.counts[TABLEBASE_GROUP_BLACK_PEONS] + material.counts[TABLEBASE_GROUP_BLACK_QUEENS];
+
+    if((playing_team == WHITE_TEAM ? white_piece_count : black_piece_count) == 0)
+    {
+        *out_value = tablebase_value_loss(0);
+        return true;
+    }
+
+    if(white_piece_count == 0 || black_piece_count == 0) return false;
+
+    for (uint8_t g = 0; g < TABLEBASE_GROUP_COUNT; g++)
+    {
+        if(material.counts[g] > TABLEBASE_MAX_PIECES_PER_GROUP) return false;
+    }
+
+    if(!tablebase_load_table(tablebase, material)) return false;
+
+    *out_value = tablebase->tables[tablebase_material_slot(material)].values[tablebase_index(tablebase, material, board, playing_team)];
+    return true;
+}
+
+bool tablebase_probe(tablebase_t* tablebase, const board_t* board, team_t playing_team, tablebase_result_t* out_result)
+{
+    uint8_t value;
+
+    if(!tablebase_probe_value(tablebase, board, playing_team, &value) || value == TABLEBASE_VALUE_INVALID) return false;
+
+    out_result->outcome = TABLEBASE_OUTCOME_DRAW;
+    out_result->distance = 0;
+
+    if(!tablebase_value_is_known(value)) return true;
+
+    out_result->outcome = tablebase_value_is_win(value) ? TABLEBASE_OUTCOME_WIN : TABLEBASE_OUTCOME_LOSS;
+    out_result->distance = (unsigned)tablebase_value_distance(value);
+
+    return true;
+}
+
+static void tablebase_build_binomials()
+{
+    int expected_state = TABLEBASE_BINOMIALS_NOT_BUILT;
+
+    if(!atomic_compare_exchange_strong(&tablebase_binomials_state, &expected_state, TABLEBASE_BINOMIALS_BUILDING))
+    {
+        while(atomic_load_explicit(&tablebase_binomials_state, memory_order_acquire) != TABLEBASE_BINOMIALS_BUILT);
+        return;
+    }
+
+    for (size_t n = 0; n <= MAX_BOARD_PLAYABLE_CELL_COUNT; n++)
+    {
+        tablebase_binomials[n][0] = 1;
+
+        for (size_t k = 1; k <= TABLEBASE_MAX_PIECES_PER_GROUP; k++)
+            tablebase_binomials[n][k] = n == 0 ? 0 : tablebase_binomials[n - 1][k - 1] + tablebase_binomials[n - 1][k];
+    }
+
+    atomic_store_explicit(&tablebase_binomials_state, TABLEBASE_BINOMIALS_BUILT, memory_order_release);
+}
+
+static bool tablebase_map_table(tablebase_t* tablebase, tablebase_table_t* table, tablebase_material_t material)
+{
+    char path [TABLEBASE_FILE_PATH_SIZE];
+
+    if(!tablebase_table_file_path(tablebase, material, path, TABLEBASE_FILE_PATH_SIZE))
+    {
+        LOGGER_ERRORF("Tablebase path \'%s\' is too long!", path);
+        return false;
+    }
+
+    if(!file_mapping_open(&table->mapping, path)) return false;
+
+    const tablebase_file_header_t* header = table->mapping.data;
+    uint64_t entry_count = tablebase_entry_count(tablebase, material);
+
+    if(table->mapping.size < sizeof(tablebase_file_header_t) + entry_count ||
+        memcmp(header->magic, TABLEBASE_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->rules_key != ruleset_key(&tablebase->rules) ||
+        memcmp(header->counts, material.counts, TABLEBASE_GROUP_COUNT) != 0 ||
+        header->entry_count != entry_count)
+    {
+        LOGGER_ERRORF("Tablebase file \'%s\' does not match its name!", path);
+        file_mapping_close(&table->mapping);
+        return false;
+    }
+
+    table->values = (const uint8_t*)table->mapping.data + sizeof(tablebase_file_header_t);
+    table->entry_count = entry_count;
+
+    return true;
+}
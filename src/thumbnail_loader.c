@@ -0,0 +1,241 @@
+#include <stdlib.h>
+
+#include "include/thumbnail_loader.h"
+#include "include/sui.h"
+#include "include/logger.h"
+#include "include/profiler.h"
+
+static int thumbnail_loader_worker_run(void* data);
+static void thumbnail_loader_enqueue(thumbnail_loader_t* loader, size_t start, size_t end);
+static void thumbnail_loader_release(thumbnail_t* thumbnail);
+
+void thumbnail_loader_init(thumbnail_loader_t* loader, const scenario_header_t* headers, size_t thumbnail_count)
+{
+    loader->headers = headers;
+    loader->thumbnail_count = thumbnail_count;
+    loader->thumbnails = calloc(thumbnail_count > 0 ? thumbnail_count : 1, sizeof(thumbnail_t));
+    loader->queue = malloc((thumbnail_count > 0 ? thumbnail_count : 1) * sizeof(size_t));
+    loader->queue_start = 0;
+    loader->queue_end = 0;
+    loader->keep_start = 0;
+    loader->keep_end = 0;
+    loader->quit_requested = false;
+    loader->mutex = SDL_CreateMutex();
+    loader->has_work = SDL_CreateCond();
+
+    int processor_count = SDL_GetCPUCount();
+
+    loader->thread_count = processor_count > 1 ? (size_t)(processor_count - 1) : 1;
+
+    if(loader->thread_count > THUMBNAIL_LOADER_MAX_THREADS) loader->thread_count = THUMBNAIL_LOADER_MAX_THREADS;
+    if(thumbnail_count == 0) loader->thread_count = 0;
+
+    for (size_t i = 0; i < loader->thread_count; i++)
+    {
+        loader->threads[i] = SDL_CreateThread(thumbnail_loader_worker_run, "ThumbnailLoader", loader);
+
+        if(loader->threads[i] == NULL)
+        {
+            LOGGER_ERRORF("SDL could not create a thumbnail loader thread!, %s", SDL_GetError());
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+void thumbnail_loader_free(thumbnail_loader_t* loader)
+{
+    SDL_LockMutex(loader->mutex);
+    loader->quit_requested = true;
+    SDL_CondBroadcast(loader->has_work);
+    SDL_UnlockMutex(loader->mutex);
+
+    for (size_t i = 0; i < loader->thread_count; i++)
+        SDL_WaitThread(loader->threads[i], NULL);
+
+    for (size_t i = 0; i < loader->thumbnail_count; i++)
+        thumbnail_loader_release(&loader->thumbnails[i]);
+
+    SDL_DestroyCond(loader->has_work);
+    SDL_DestroyMutex(loader->mutex);
+    free(loader->thumbnails);
+    free(loader->queue);
+
+    loader->thumbnails = NULL;
+    loader->queue = NULL;
+    loader->thread_count = 0;
+}
+
+void thumbnail_loader_request(thumbnail_loader_t* loader, size_t start, size_t end, size_t prefetch_count)
+{
+    size_t keep_margin = prefetch_count * THUMBNAIL_LOADER_KEEP_MARGIN_FACTOR;
+
+    SDL_LockMutex(loader->mutex);
+
+    for (size_t i = loader->queue_start; i < loader->queue_end; i++)
+    {
+        thumbnail_t* thumbnail = &loader->thumbnails[loader->queue[i]];
+
+        if(thumbnail->state == THUMBNAIL_QUEUED) thumbnail->state = THUMBNAIL_IDLE;
+    }
+
+    loader->queue_start = 0;
+    loader->queue_end = 0;
+    loader->keep_start = start > keep_margin ? start - keep_margin : 0;
+    loader->keep_end = end + keep_margin < loader->thumbnail_count ? end + keep_margin : loader->thumbnail_count;
+
+    for (size_t i = 0; i < loader->thumbnail_count; i++)
+    {
+        if(i < loader->keep_start || i >= loader->keep_end) thumbnail_loader_release(&loader->thumbnails[i]);
+    }
+
+    thumbnail_loader_enqueue(loader, start, end);
+    thumbnail_loader_enqueue(loader, end, end + prefetch_count);
+    thumbnail_loader_enqueue(loader, start > prefetch_count ? start - prefetch_count : 0, start);
+
+    SDL_CondBroadcast(loader->has_work);
+    SDL_UnlockMutex(loader->mutex);
+}
+
+bool thumbnail_loader_upload(thumbnail_loader_t* loader, SDL_Renderer* renderer, size_t visible_start, size_t visible_end)
+{
+    bool has_visible_change = false;
+    size_t upload_count = 0;
+
+    PROFILER_BEGIN(PROFILER_SCOPE_THUMBNAIL_UPLOAD);
+
+    SDL_LockMutex(loader->mutex);
+
+    for (size_t i = loader->keep_start; i < loader->keep_end && upload_count < THUMBNAIL_LOADER_MAX_UPLOADS_PER_FRAME; i++)
+    {
+        thumbnail_t* thumbnail = &loader->thumbnails[i];
+
+        if(thumbnail->state != THUMBNAIL_DECODED) continue;
+
+        thumbnail->icon_texture = SDL_CreateTextureFromSurface(renderer, thumbnail->surface);
+        thumbnail->state = thumbnail->icon_texture != NULL ? THUMBNAIL_READY : THUMBNAIL_MISSING;
+
+        SDL_FreeSurface(thumbnail->surface);
+        thumbnail->surface = NULL;
+
+        if(i >= visible_start && i < visible_end) has_visible_change = true;
+
+        upload_count++;
+    }
+
+    SDL_UnlockMutex(loader->mutex);
+
+    PROFILER_END(PROFILER_SCOPE_THUMBNAIL_UPLOAD);
+
+    return has_visible_change;
+}
+
+bool thumbnail_loader_has_pending(thumbnail_loader_t* loader)
+{
+    bool has_pending = false;
+
+    SDL_LockMutex(loader->mutex);
+
+    for (size_t i = loader->keep_start; i < loader->keep_end && !has_pending; i++)
+    {
+        uint8_t state = loader->thumbnails[i].state;
+        has_pending = state == THUMBNAIL_QUEUED || state == THUMBNAIL_DECODING || state == THUMBNAIL_DECODED;
+    }
+
+    SDL_UnlockMutex(loader->mutex);
+
+    return has_pending;
+}
+
+SDL_Texture* thumbnail_loader_icon(const thumbnail_loader_t* loader, size_t index)
+{
+    return loader->thumbnails[index].icon_texture;
+}
+
+SDL_Texture* thumbnail_loader_name(thumbnail_loader_t* loader, SDL_Renderer* renderer, TTF_Font* font, SDL_Color color, size_t index)
+{
+    thumbnail_t* thumbnail = &loader->thumbnails[index];
+    const char* name = loader->headers[index].name;
+
+    if(thumbnail->name_texture == NULL && name[0] != '\0')
+        thumbnail->name_texture = sui_texture_from_text(renderer, font, (char*)name, color);
+
+    return thumbnail->name_texture;
+}
+
+static int thumbnail_loader_worker_run(void* data)
+{
+    thumbnail_loader_t* loader = data;
+
+    for (;;)
+    {
+        SDL_LockMutex(loader->mutex);
+
+        while(!loader->quit_requested && loader->queue_start == loader->queue_end)
+            SDL_CondWait(loader->has_work, loader->mutex);
+
+        if(loader->quit_requested)
+        {
+            SDL_UnlockMutex(loader->mutex);
+            break;
+        }
+
+        size_t index = loader->queue[loader->queue_start++];
+        loader->thumbnails[index].state = THUMBNAIL_DECODING;
+
+        SDL_UnlockMutex(loader->mutex);
+
+        PROFILER_BEGIN(PROFILER_SCOPE_THUMBNAIL_DECODE);
+
+        const char* icon_path = loader->headers[index].icon_path;
+        SDL_Surface* surface = icon_path[0] != '\0' ? IMG_Load(icon_path) : NULL;
+
+        PROFILER_END(PROFILER_SCOPE_THUMBNAIL_DECODE);
+
+        SDL_LockMutex(loader->mutex);
+
+        loader->thumbnails[index].surface = surface;
+        loader->thumbnails[index].state = surface != NULL ? THUMBNAIL_DECODED : THUMBNAIL_MISSING;
+
+        SDL_UnlockMutex(loader->mutex);
+    }
+
+    return 0;
+}
+
+/* Called with the mutex held, every thumbnail is queued at most once between two requests */
+static void thumbnail_loader_enqueue(thumbnail_loader_t* loader, size_t start, size_t end)
+{
+    if(end > loader->thumbnail_count) end = loader->thumbnail_count;
+
+    for (size_t i = start; i < end; i++)
+    {
+        if(loader->thumbnails[i].state != THUMBNAIL_IDLE) continue;
+
+        loader->thumbnails[i].state = THUMBNAIL_QUEUED;
+        loader->queue[loader->queue_end++] = i;
+    }
+}
+
+/* Thumbnails being decoded are left alone, their surface is released by a later request or by thumbnail_loader_free */
+static void thumbnail_loader_release(thumbnail_t* thumbnail)
+{
+    if(thumbnail->name_texture != NULL)
+    {
+        SDL_DestroyTexture(thumbnail->name_texture);
+        thumbnail->name_texture = NULL;
+    }
+
+    if(thumbnail->icon_texture != NULL)
+    {
+        SDL_DestroyTexture(thumbnail->icon_texture);
+        thumbnail->icon_texture = NULL;
+    }
+
+    if(thumbnail->surface != NULL)
+    {
+        SDL_FreeSurface(thumbnail->surface);
+        thumbnail->surface = NULL;
+    }
+
+    if(thumbnail->state == THUMBNAIL_DECODED || thumbnail->state == THUMBNAIL_READY) thumbnail->state = THUMBNAIL_IDLE;
+}
@@ -0,0 +1,428 @@
+/**
+ * CHALLENGE VERIFIER
+ *
+ * Replays the CHALLENGE block of every challenge scenario of a directory through
+ * board_generate_legal_moves and reports the moves the game would accept but the rules do not:
+ * turns played by the wrong team, quiet moves while a capture is mandatory, captures the laws of
+ * quantity and quality forbid, sequences that stop before the capture is over or list the wrong
+ * captured pieces. Pieces crown exactly like in the game, so later turns are checked against the
+ * right piece types.
+ *
+ * Every turn of the solver is also searched to tell whether the expected move is the only good
+ * one: forced when it is the only legal move, unique when every other move scores worse,
+ * ambiguous when another move scores as well, and refuted when another move scores better. A
+ * refuted solution fails the challenge.
+ *
+ * Usage: challenge_verify <scenario directory or file> [thread count]
+ *
+ * The exit status is non zero when any challenge fails.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "../include/scenario_loader.h"
+#include "../include/geometry.h"
+#include "../include/search.h"
+#include "../include/platform.h"
+
+#define CHALLENGE_VERIFY_MAX_THREADS 64
+#define CHALLENGE_VERIFY_DEFAULT_THREADS 4
+#define CHALLENGE_VERIFY_REPORT_SIZE 4096
+#define CHALLENGE_VERIFY_MAX_LISTED_MOVES 8
+
+/* Solver moves are compared by searching the rest of the challenge plus a few turns, up to this depth */
+#define CHALLENGE_VERIFY_EXTRA_DEPTH 1
+#define CHALLENGE_VERIFY_MAX_DEPTH 6
+
+typedef struct
+{
+    string_t path;
+    bool has_failed;
+    bool is_challenge;
+
+    size_t turn_count;
+    size_t forced_move_count;
+    size_t unique_move_count;
+    size_t ambiguous_move_count;
+    size_t refuted_move_count;
+    size_t crowning_count;
+
+    char report [CHALLENGE_VERIFY_REPORT_SIZE];
+    size_t report_length;
+} challenge_verify_result_t;
+
+typedef struct
+{
+    challenge_verify_result_t* results;
+    size_t result_count;
+    atomic_size_t next_result_index;
+} challenge_verify_queue_t;
+
+static void* challenge_verify_worker_run(void* data);
+static void challenge_verify_scenario(challenge_verify_result_t* result);
+static void challenge_verify_report_illegal_turn(challenge_verify_result_t* result, const legal_move_list_t* move_list, const move_info_t* steps, size_t step_count);
+static void challenge_verify_check_uniqueness(challenge_verify_result_t* result, searcher_t* searcher, const board_t* board, team_t playing_team, const legal_move_list_t* move_list, const legal_move_t* expected_move, unsigned depth);
+static void challenge_verify_report(challenge_verify_result_t* result, const char* format, ...);
+static void challenge_verify_report_move(challenge_verify_result_t* result, const legal_move_t* move);
+static void challenge_verify_report_steps(challenge_verify_result_t* result, const move_info_t* steps, size_t step_count);
+static const char* challenge_verify_team_name(team_t team);
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <scenario directory or file> [thread count]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    size_t thread_count = argc > 2 ? (size_t)atoi(argv[2]) : platform_processor_count(CHALLENGE_VERIFY_DEFAULT_THREADS);
+
+    if(thread_count < 1) thread_count = 1;
+    if(thread_count > CHALLENGE_VERIFY_MAX_THREADS) thread_count = CHALLENGE_VERIFY_MAX_THREADS;
+
+    double start = platform_now_seconds();
+    size_t path_length = strlen(argv[1]);
+    size_t extension_length = strlen(SCENARIO_FILE_EXTENSION);
+    array(string_t) paths;
+
+    if(path_length >= extension_length && strcmp(&argv[1][path_length - extension_length], SCENARIO_FILE_EXTENSION) == 0)
+    {
+        dynarray(string_t) single_path = dynarray_new(string_t, 0);
+        string_t path = string_heap_concat(argv[1], "");
+        dynarray_add(&single_path, string_t, &path);
+        paths = dynarray_to_array(&single_path, string_t);
+    }
+    else
+    {
+        /* get_scenario_paths_from_dir expects the separator at the end of the directory */
+        string_t directory = string_heap_concat(argv[1], argv[1][path_length - 1] == '/' ? "" : "/");
+        paths = get_scenario_paths_from_dir(directory);
+        free(directory);
+    }
+
+    challenge_verify_queue_t queue;
+    queue.result_count = array_size(&paths);
+    queue.results = calloc(queue.result_count > 0 ? queue.result_count : 1, sizeof(challenge_verify_result_t));
+    atomic_init(&queue.next_result_index, 0);
+
+    for (size_t i = 0; i < queue.result_count; i++)
+        queue.results[i].path = array_ele(&paths, string_t, i);
+
+    pthread_t threads [CHALLENGE_VERIFY_MAX_THREADS];
+
+    if(thread_count > queue.result_count) thread_count = queue.result_count > 0 ? queue.result_count : 1;
+
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        if(pthread_create(&threads[i], NULL, challenge_verify_worker_run, &queue) != 0)
+        {
+            fprintf(stderr, "Could not create worker thread %zu\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (size_t i = 0; i < thread_count; i++)
+        pthread_join(threads[i], NULL);
+
+    size_t challenge_count = 0;
+    size_t failure_count = 0;
+
+    for (size_t i = 0; i < queue.result_count; i++)
+    {
+        challenge_verify_result_t* result = &queue.results[i];
+
+        if(!result->is_challenge)
+        {
+            free(result->path);
+            continue;
+        }
+
+        challenge_count++;
+
+        if(result->has_failed) failure_count++;
+
+        printf("%s %s: %zu turns, %zu crownings, solver moves: %zu unique, %zu forced, %zu ambiguous, %zu refuted\n", result->has_failed ? "FAIL" : "OK  ",
+            result->path, result->turn_count, result->crowning_count, result->unique_move_count, result->forced_move_count, result->ambiguous_move_count,
+            result->refuted_move_count);
+        fputs(result->report, stdout);
+
+        free(result->path);
+    }
+
+    printf("%zu challenges verified, %zu failed, %zu other scenarios skipped in %.2f s\n", challenge_count, failure_count, queue.result_count - challenge_count, platform_now_seconds() - start);
+
+    free(queue.results);
+    array_free(&paths);
+
+    return failure_count > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+static void* challenge_verify_worker_run(void* data)
+{
+    challenge_verify_queue_t* queue = data;
+
+    for (;;)
+    {
+        size_t result_index = atomic_fetch_add(&queue->next_result_index, 1);
+
+        if(result_index >= queue->result_count) break;
+
+        challenge_verify_scenario(&queue->results[result_index]);
+    }
+
+    return NULL;
+}
+
+static void challenge_verify_scenario(challenge_verify_result_t* result)
+{
+    scenario_t scenario;
+
+    /* A file which does not load cannot be told apart from a challenge, so it is reported as a failed one */
+    if(!try_load_scenario_from_file(&scenario, result->path))
+    {
+        result->is_challenge = true;
+        result->has_failed = true;
+        challenge_verify_report(result, "    the scenario could not be loaded, the reason was written to stderr\n");
+        return;
+    }
+
+    if(scenario.scenario_mode != SCENARIO_MODE_CHALLENGE) return;
+
+    result->is_challenge = true;
+
+    size_t move_count = array_size(&scenario.challenge_moves);
+
+    if(move_count == 0)
+    {
+        result->has_failed = true;
+        challenge_verify_report(result, "    the CHALLENGE block has no moves\n");
+        array_free(&scenario.challenge_moves);
+        return;
+    }
+
+    size_t total_turn_count = 0;
+
+    for (size_t i = 0; i < move_count; i += scenario_challenge_turn_length(&scenario, i))
+        total_turn_count++;
+
+    searcher_t searcher;
+    searcher_init(&searcher, &scenario.rules);
+
+    board_t board = scenario.board;
+    team_t playing_team = scenario.team;
+    size_t first_move_index = 0;
+
+    while(first_move_index < move_count)
+    {
+        const move_info_t* steps = rrr_array_ele(&scenario.challenge_moves, sizeof(move_info_t), first_move_index);
+        size_t step_count = scenario_challenge_turn_length(&scenario, first_move_index);
+        size_t turn = result->turn_count + 1;
+        legal_move_list_t move_list;
+
+        board_generate_legal_moves(&scenario.rules, &board, playing_team, &move_list);
+
+        if(move_list.move_count == 0)
+        {
+            result->has_failed = true;
+            challenge_verify_report(result, "    turn %zu: %s has no legal move, the game is already over\n", turn, challenge_verify_team_name(playing_team));
+            break;
+        }
+
+        cell_value_t moving_piece = steps[0].source_cell < MAX_BOARD_PLAYABLE_CELL_COUNT ? board.playable_cells[steps[0].source_cell] : NO_PIECE;
+
+        if(moving_piece == NO_PIECE || piece_team(moving_piece) != playing_team)
+        {
+            result->has_failed = true;
+            challenge_verify_report(result, "    turn %zu: it is %s's turn but cell %d holds %s\n", turn, challenge_verify_team_name(playing_team), steps[0].source_cell + 1,
+                moving_piece == NO_PIECE ? "no piece" : "a piece of the other team");
+            break;
+        }
+
+        const legal_move_t* expected_move = legal_move_list_find_steps(&move_list, steps, step_count);
+
+        if(expected_move == NULL)
+        {
+            result->has_failed = true;
+            challenge_verify_report(result, "    turn %zu: ", turn);
+            challenge_verify_report_steps(result, steps, step_count);
+            challenge_verify_report_illegal_turn(result, &move_list, steps, step_count);
+            break;
+        }
+
+        if(playing_team == scenario.team)
+        {
+            unsigned depth = (unsigned)(total_turn_count - turn) + CHALLENGE_VERIFY_EXTRA_DEPTH;
+
+            if(depth > CHALLENGE_VERIFY_MAX_DEPTH) depth = CHALLENGE_VERIFY_MAX_DEPTH;
+
+            challenge_verify_check_uniqueness(result, &searcher, &board, playing_team, &move_list, expected_move, depth);
+        }
+
+        board_play_legal_move(&scenario.rules, &board, expected_move);
+
+        if(board.playable_cells[legal_move_final_cell(expected_move)] != moving_piece) result->crowning_count++;
+
+        result->turn_count++;
+        first_move_index += step_count;
+        playing_team = playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM;
+    }
+
+    searcher_free(&searcher);
+    array_free(&scenario.challenge_moves);
+}
+
+static void challenge_verify_report_illegal_turn(challenge_verify_result_t* result, const legal_move_list_t* move_list, const move_info_t* steps, size_t step_count)
+{
+    bool is_capture_mandatory = move_list->moves[0].capture_count > 0;
+
+    /* Look for a legal move going through the same cells to tell a wrong capture from a sequence stopped too early */
+    for (size_t i = 0; i < move_list->move_count; i++)
+    {
+        const legal_move_t* move = &move_list->moves[i];
+        size_t move_step_count = legal_move_step_count(move);
+        bool is_same_path = move->source_cell == steps[0].source_cell && move_step_count >= step_count;
+
+        for (size_t s = 0; is_same_path && s < step_count; s++)
+            is_same_path = legal_move_get_step(move, s).destination_cell == steps[s].destination_cell;
+
+        if(!is_same_path) continue;
+
+        challenge_verify_report(result, move_step_count == step_count ? "lists the wrong captured pieces, the rules play " : "stops before the capture sequence is over, the rules play ");
+        challenge_verify_report_move(result, move);
+        challenge_verify_report(result, "\n");
+        return;
+    }
+
+    if(is_capture_mandatory && !steps[0].is_capture_move)
+        challenge_verify_report(result, "is a quiet move but a capture is mandatory, legal moves: ");
+    else if(is_capture_mandatory)
+        challenge_verify_report(result, "is not one of the captures the laws allow, legal moves: ");
+    else
+        challenge_verify_report(result, "is not a legal move, legal moves: ");
+
+    for (size_t i = 0; i < move_list->move_count && i < CHALLENGE_VERIFY_MAX_LISTED_MOVES; i++)
+        challenge_verify_report_move(result, &move_list->moves[i]);
+
+    challenge_verify_report(result, move_list->move_count > CHALLENGE_VERIFY_MAX_LISTED_MOVES ? "...\n" : "\n");
+}
+
+static void challenge_verify_check_uniqueness(challenge_verify_result_t* result, searcher_t* searcher, const board_t* board, team_t playing_team, const legal_move_list_t* move_list, const legal_move_t* expected_move, unsigned depth)
+{
+    if(move_list->move_count == 1)
+    {
+        result->forced_move_count++;
+        return;
+    }
+
+    team_t opponent_team = playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM;
+    search_limits_t limits = { depth, 0, NULL };
+    int scores [LEGAL_MOVE_LIST_CAPACITY];
+    size_t expected_move_index = (size_t)(expected_move - move_list->moves);
+    size_t better_count = 0;
+    size_t alternative_count = 0;
+
+    for (size_t i = 0; i < move_list->move_count; i++)
+    {
+        board_t next_board = *board;
+        board_play_legal_move(&searcher->rules, &next_board, &move_list->moves[i]);
+
+        scores[i] = -searcher_score_position(searcher, &next_board, opponent_team, limits);
+    }
+
+    for (size_t i = 0; i < move_list->move_count; i++)
+    {
+        if(scores[i] <= scores[expected_move_index]) continue;
+
+        if(better_count == 0)
+        {
+            challenge_verify_report(result, "    turn %zu: ", result->turn_count + 1);
+            challenge_verify_report_move(result, expected_move);
+            challenge_verify_report(result, "is refuted, a better move exists: ");
+        }
+
+        challenge_verify_report_move(result, &move_list->moves[i]);
+        better_count++;
+    }
+
+    if(better_count > 0)
+    {
+        challenge_verify_report(result, "\n");
+        result->has_failed = true;
+        result->refuted_move_count++;
+        return;
+    }
+
+    for (size_t i = 0; i < move_list->move_count; i++)
+    {
+        if(i == expected_move_index || scores[i] != scores[expected_move_index]) continue;
+
+        if(alternative_count == 0)
+        {
+            challenge_verify_report(result, "    turn %zu: ", result->turn_count + 1);
+            challenge_verify_report_move(result, expected_move);
+            challenge_verify_report(result, "is not the only good move, these score as well: ");
+        }
+
+        challenge_verify_report_move(result, &move_list->moves[i]);
+        alternative_count++;
+    }
+
+    if(alternative_count > 0)
+    {
+        challenge_verify_report(result, "\n");
+        result->ambiguous_move_count++;
+    }
+    else
+    {
+        result->unique_move_count++;
+    }
+}
+
+static void challenge_verify_report(challenge_verify_result_t* result, const char* format, ...)
+{
+    size_t available = CHALLENGE_VERIFY_REPORT_SIZE - result->report_length;
+
+    if(available <= 1) return;
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(&result->report[result->report_length], available, format, args);
+    va_end(args);
+
+    if(written < 0) return;
+
+    result->report_length += (size_t)written < available ? (size_t)written : available - 1;
+}
+
+/* Moves are written like the challenge moves of scenario files */
+static void challenge_verify_report_move(challenge_verify_result_t* result, const legal_move_t* move)
+{
+    move_info_t steps [MAX_CAPTURE_SEQUENCE_LENGTH];
+    size_t step_count = legal_move_step_count(move);
+
+    for (size_t i = 0; i < step_count; i++)
+        steps[i] = legal_move_get_step(move, i);
+
+    challenge_verify_report_steps(result, steps, step_count);
+}
+
+static void challenge_verify_report_steps(challenge_verify_result_t* result, const move_info_t* steps, size_t step_count)
+{
+    for (size_t i = 0; i < step_count; i++)
+    {
+        if(steps[i].is_capture_move)
+            challenge_verify_report(result, "(%d, %d, %d) ", steps[i].source_cell + 1, steps[i].destination_cell + 1, steps[i].capture_cell + 1);
+        else
+            challenge_verify_report(result, "(%d, %d) ", steps[i].source_cell + 1, steps[i].destination_cell + 1);
+    }
+}
+
+static const char* challenge_verify_team_name(team_t team)
+{
+    return team == WHITE_TEAM ? "white" : "black";
+}
@@ -0,0 +1,123 @@
+/**
+ * PERFT
+ *
+ * Headless move generation benchmark. Loads a scenario and counts every sequence of turns up to
+ * the given depth with board_generate_legal_moves, which applies the same rules the game enforces.
+ *
+ * Usage: perft <scenario file> <depth> [divide]
+ *
+ * Without divide, the node count of every depth from 1 to the given depth is printed along with
+ * its throughput. With divide, the node count below each move of the starting position is printed,
+ * moves are written like the challenge moves of scenario files, one (source, destination, capture)
+ * group per capture.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include "../include/scenario_loader.h"
+#include "../include/perft.h"
+
+#define PERFT_MAX_DEPTH 32
+
+typedef struct
+{
+    const ruleset_t* rules;
+    bool has_truncated_move_list;
+} perft_t;
+
+static uint64_t perft_divide(perft_t* perft, const board_t* board, team_t playing_team, unsigned depth);
+static void perft_print_move(const legal_move_t* move);
+static double perft_elapsed_seconds(clock_t start);
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        fprintf(stderr, "Usage: %s <scenario file> <depth> [divide]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int depth = atoi(argv[2]);
+
+    if(depth < 1 || depth >= PERFT_MAX_DEPTH)
+    {
+        fprintf(stderr, "Depth must be between 1 and %d\n", PERFT_MAX_DEPTH - 1);
+        return EXIT_FAILURE;
+    }
+
+    scenario_t scenario;
+    perft_t perft;
+
+    load_scenario_from_file(&scenario, argv[1]);
+
+    perft.rules = &scenario.rules;
+    perft.has_truncated_move_list = false;
+
+    bool is_dividing = argc > 3 && strcmp(argv[3], "divide") == 0;
+
+    printf("%s (board %d, %s to play)\n", argv[1], scenario.rules.board_side_size, scenario.team == WHITE_TEAM ? "white" : "black");
+
+    for (int current_depth = is_dividing ? depth : 1; current_depth <= depth; current_depth++)
+    {
+        clock_t start = clock();
+
+        uint64_t node_count = is_dividing ? perft_divide(&perft, &scenario.board, scenario.team, (unsigned)current_depth) : perft_count(perft.rules, &scenario.board, scenario.team, (unsigned)current_depth, &perft.has_truncated_move_list);
+        double seconds = perft_elapsed_seconds(start);
+
+        printf("depth %2d: %12"PRIu64" nodes %10.3f s %14.0f nodes/s\n", current_depth, node_count, seconds, seconds > 0 ? (double)node_count / seconds : 0.0);
+    }
+
+    if(perft.has_truncated_move_list)
+        fprintf(stderr, "Warning: some positions have more than %d legal moves, the counts are incomplete\n", LEGAL_MOVE_LIST_CAPACITY);
+
+    if(scenario.scenario_mode == SCENARIO_MODE_CHALLENGE)
+        array_free(&scenario.challenge_moves);
+
+    return EXIT_SUCCESS;
+}
+
+static uint64_t perft_divide(perft_t* perft, const board_t* board, team_t playing_team, unsigned depth)
+{
+    legal_move_list_t move_list;
+    uint64_t total_node_count = 0;
+
+    board_generate_legal_moves(perft->rules, board, playing_team, &move_list);
+
+    if(move_list.is_truncated) perft->has_truncated_move_list = true;
+
+    for (size_t i = 0; i < move_list.move_count; i++)
+    {
+        board_t next_board = *board;
+        board_play_legal_move(perft->rules, &next_board, &move_list.moves[i]);
+
+        uint64_t node_count = perft_count(perft->rules, &next_board, playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM, depth - 1, &perft->has_truncated_move_list);
+        total_node_count += node_count;
+
+        perft_print_move(&move_list.moves[i]);
+        printf(": %"PRIu64"\n", node_count);
+    }
+
+    return total_node_count;
+}
+
+static void perft_print_move(const legal_move_t* move)
+{
+    for (size_t i = 0; i < legal_move_step_count(move); i++)
+    {
+        move_info_t step = legal_move_get_step(move, i);
+
+        if(step.is_capture_move)
+            printf("(%d, %d, %d) ", step.source_cell + 1, step.destination_cell + 1, step.capture_cell + 1);
+        else
+            printf("(%d, %d) ", step.source_cell + 1, step.destination_cell + 1);
+    }
+}
+
+static double perft_elapsed_seconds(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
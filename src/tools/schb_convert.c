@@ -0,0 +1,144 @@
+/**
+ * SCHB CONVERT
+ *
+ * Compiles .sch scenario files into a single .schb library, which the game and the tools map and
+ * read in place, and turns a library back into .sch files.
+ *
+ * Usage: schb_convert compile <library.schb> <scenario file or directory>...
+ *        schb_convert extract <library.schb> <output directory>
+ *
+ * Extracted files are numbered in the order of the library: 0000.sch, 0001.sch, ...
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/scenario_loader.h"
+#include "../include/scenario_writer.h"
+#include "../include/scenario_binary.h"
+
+#define SCHB_CONVERT_PATH_SIZE 512
+
+static int schb_convert_compile(const char* library_path, int path_count, char** paths);
+static int schb_convert_extract(const char* library_path, const char* directory);
+
+int main(int argc, char** argv)
+{
+    if(argc >= 4 && strcmp(argv[1], "compile") == 0) return schb_convert_compile(argv[2], argc - 3, &argv[3]);
+    if(argc == 4 && strcmp(argv[1], "extract") == 0) return schb_convert_extract(argv[2], argv[3]);
+
+    fprintf(stderr, "Usage: %s compile <library.schb> <scenario file or directory>...\n", argv[0]);
+    fprintf(stderr, "       %s extract <library.schb> <output directory>\n", argv[0]);
+
+    return EXIT_FAILURE;
+}
+
+static int schb_convert_compile(const char* library_path, int path_count, char** paths)
+{
+    dynarray(string_t) file_paths = dynarray_new(string_t, 0);
+
+    for (int i = 0; i < path_count; i++)
+    {
+        if(string_ends_with(paths[i], SCENARIO_FILE_EXTENSION))
+        {
+            string_t path = string_heap_copy(paths[i]);
+            dynarray_add(&file_paths, string_t, &path);
+            continue;
+        }
+
+        size_t path_length = strlen(paths[i]);
+        string_t directory = string_heap_concat(paths[i], path_length > 0 && paths[i][path_length - 1] == '/' ? "" : "/");
+        array(string_t) directory_paths = get_scenario_paths_from_dir(directory);
+
+        for (size_t p = 0; p < array_size(&directory_paths); p++)
+            dynarray_add(&file_paths, string_t, rrr_array_ele(&directory_paths, sizeof(string_t), p));
+
+        array_free(&directory_paths);
+        free(directory);
+    }
+
+    size_t scenario_count = dynarray_size(&file_paths);
+    scenario_t* scenarios = calloc(scenario_count, sizeof(scenario_t));
+    scenario_binary_entry_t* entries = calloc(scenario_count, sizeof(scenario_binary_entry_t));
+    scenario_header_t* headers = calloc(scenario_count, sizeof(scenario_header_t));
+
+    for (size_t i = 0; i < scenario_count; i++)
+    {
+        string_t file_path = dynarray_ele(&file_paths, string_t, i);
+
+        load_scenario_from_file(&scenarios[i], file_path);
+        scan_scenario_header_from_file(file_path, &headers[i]);
+
+        entries[i] = (scenario_binary_entry_t){ &scenarios[i], headers[i].name, headers[i].icon_path };
+    }
+
+    bool is_written = scenario_binary_write_file(library_path, entries, scenario_count);
+
+    if(is_written) printf("%zu scenarios compiled into %s\n", scenario_count, library_path);
+    else fprintf(stderr, "Could not write %s\n", library_path);
+
+    for (size_t i = 0; i < scenario_count; i++)
+    {
+        if(scenarios[i].scenario_mode == SCENARIO_MODE_CHALLENGE) array_free(&scenarios[i].challenge_moves);
+        free(dynarray_ele(&file_paths, string_t, i));
+    }
+
+    dynarray_free(&file_paths);
+    free(scenarios);
+    free(entries);
+    free(headers);
+
+    return is_written ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int schb_convert_extract(const char* library_path, const char* directory)
+{
+    scenario_binary_library_t library;
+
+    if(!scenario_binary_open(&library, library_path))
+    {
+        fprintf(stderr, "%s is not a valid scenario library\n", library_path);
+        return EXIT_FAILURE;
+    }
+
+    size_t directory_length = strlen(directory);
+    const char* separator = directory_length > 0 && directory[directory_length - 1] == '/' ? "" : "/";
+
+    for (size_t i = 0; i < scenario_binary_count(&library); i++)
+    {
+        const scenario_binary_record_t* record = scenario_binary_record(&library, i);
+        char file_path [SCHB_CONVERT_PATH_SIZE];
+        scenario_t scenario;
+
+        snprintf(file_path, SCHB_CONVERT_PATH_SIZE, "%s%s%04zu" SCENARIO_FILE_EXTENSION, directory, separator, i);
+
+        FILE* f = fopen(file_path, "wb");
+
+        if(f == NULL)
+        {
+            fprintf(stderr, "Could not write %s\n", file_path);
+            scenario_binary_close(&library);
+            return EXIT_FAILURE;
+        }
+
+        if(!scenario_binary_record_to_scenario(record, &scenario))
+        {
+            fprintf(stderr, "Scenario %zu of %s is not valid\n", i, library_path);
+            fclose(f);
+            remove(file_path);
+            scenario_binary_close(&library);
+            return EXIT_FAILURE;
+        }
+
+        scenario_write_sch(f, &scenario, record->name, record->icon_path);
+        fclose(f);
+
+        if(scenario.scenario_mode == SCENARIO_MODE_CHALLENGE) array_free(&scenario.challenge_moves);
+    }
+
+    printf("%zu scenarios extracted from %s\n", scenario_binary_count(&library), library_path);
+    scenario_binary_close(&library);
+
+    return EXIT_SUCCESS;
+}
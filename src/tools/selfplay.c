@@ -0,0 +1,256 @@
+/**
+ * SELFPLAY
+ *
+ * Plays games between two automated players from the position and rules of a scenario file, one
+ * game at a time on each worker thread, and writes every game to a log.
+ *
+ * Usage: selfplay <scenario file> <game count> <log file> [options]
+ *
+ *     -w <player>   white player, a search depth or random (default 4)
+ *     -b <player>   black player, a search depth or random (default 4)
+ *     -t <turns>    turns after which a game is a draw
+ *     -r <turns>    turns played at random at the start of every game (default 4)
+ *     -s <seed>     seed of the random turns, game N uses seed + N (default 1)
+ *     -j <threads>  worker threads (default one per processor)
+ *
+ * Each game takes one line of the log: its number, its result (W, B or D), its length in turns and
+ * its moves in draughts notation. Games only depend on the seed, so any line can be played again.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "../include/scenario_loader.h"
+#include "../include/geometry.h"
+#include "../include/match.h"
+#include "../include/platform.h"
+
+#define SELFPLAY_MAX_THREADS 64
+#define SELFPLAY_DEFAULT_THREADS 4
+#define SELFPLAY_DEFAULT_DEPTH 4
+#define SELFPLAY_DEFAULT_RANDOM_OPENING_TURNS 4
+#define SELFPLAY_DEFAULT_SEED 1
+
+typedef struct
+{
+    unsigned depth;
+    bool plays_randomly;
+} selfplay_player_config_t;
+
+typedef struct
+{
+    scenario_t scenario;
+    selfplay_player_config_t players [2];
+    match_settings_t settings;
+    size_t game_count;
+
+    atomic_size_t next_game_index;
+
+    /* Guards the log and the totals */
+    pthread_mutex_t log_mutex;
+    FILE* log_file;
+    size_t result_counts [3];
+    size_t total_turn_count;
+} selfplay_t;
+
+static void selfplay_print_usage(const char* program_name);
+static void* selfplay_worker_run(void* data);
+static void selfplay_log_match(selfplay_t* selfplay, size_t game_index, const match_t* match);
+static bool selfplay_parse_player(const char* text, selfplay_player_config_t* out_player);
+static const char* selfplay_player_name(const selfplay_player_config_t* player, char* buffer, size_t buffer_size);
+
+int main(int argc, char** argv)
+{
+    if(argc < 4)
+    {
+        selfplay_print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static selfplay_t selfplay;
+    size_t thread_count = platform_processor_count(SELFPLAY_DEFAULT_THREADS);
+
+    selfplay.game_count = (size_t)strtoull(argv[2], NULL, 10);
+    selfplay.players[0] = (selfplay_player_config_t){ SELFPLAY_DEFAULT_DEPTH, false };
+    selfplay.players[1] = (selfplay_player_config_t){ SELFPLAY_DEFAULT_DEPTH, false };
+    selfplay.settings.max_turns = MATCH_DEFAULT_MAX_TURNS;
+    selfplay.settings.random_opening_turns = SELFPLAY_DEFAULT_RANDOM_OPENING_TURNS;
+    selfplay.settings.random_seed = SELFPLAY_DEFAULT_SEED;
+
+    for (int i = 4; i < argc; i += 2)
+    {
+        if(i + 1 == argc)
+        {
+            fprintf(stderr, "Option %s has no value\n", argv[i]);
+            selfplay_print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        const char* value = argv[i + 1];
+        bool is_valid = true;
+
+        if(strcmp(argv[i], "-w") == 0) is_valid = selfplay_parse_player(value, &selfplay.players[0]);
+        else if(strcmp(argv[i], "-b") == 0) is_valid = selfplay_parse_player(value, &selfplay.players[1]);
+        else if(strcmp(argv[i], "-t") == 0) selfplay.settings.max_turns = (size_t)strtoull(value, NULL, 10);
+        else if(strcmp(argv[i], "-r") == 0) selfplay.settings.random_opening_turns = (size_t)strtoull(value, NULL, 10);
+        else if(strcmp(argv[i], "-s") == 0) selfplay.settings.random_seed = strtoull(value, NULL, 10);
+        else if(strcmp(argv[i], "-j") == 0) thread_count = (size_t)strtoull(value, NULL, 10);
+        else is_valid = false;
+
+        if(!is_valid)
+        {
+            fprintf(stderr, "Invalid option %s %s\n", argv[i], value);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(thread_count < 1) thread_count = 1;
+    if(thread_count > SELFPLAY_MAX_THREADS) thread_count = SELFPLAY_MAX_THREADS;
+    if(thread_count > selfplay.game_count && selfplay.game_count > 0) thread_count = selfplay.game_count;
+
+    load_scenario_from_file(&selfplay.scenario, argv[1]);
+
+    selfplay.log_file = fopen(argv[3], "w");
+
+    if(selfplay.log_file == NULL)
+    {
+        fprintf(stderr, "Could not open %s\n", argv[3]);
+        return EXIT_FAILURE;
+    }
+
+    char white_name [32];
+    char black_name [32];
+
+    fprintf(selfplay.log_file, "# %s, white %s, black %s, %zu turns at most, %zu random turns, seed %llu\n", argv[1],
+        selfplay_player_name(&selfplay.players[0], white_name, sizeof(white_name)), selfplay_player_name(&selfplay.players[1], black_name, sizeof(black_name)),
+        selfplay.settings.max_turns, selfplay.settings.random_opening_turns, (unsigned long long)selfplay.settings.random_seed);
+
+    atomic_init(&selfplay.next_game_index, 0);
+    pthread_mutex_init(&selfplay.log_mutex, NULL);
+
+    double start = platform_now_seconds();
+    pthread_t threads [SELFPLAY_MAX_THREADS];
+
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        if(pthread_create(&threads[i], NULL, selfplay_worker_run, &selfplay) != 0)
+        {
+            fprintf(stderr, "Could not create worker thread %zu\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (size_t i = 0; i < thread_count; i++)
+        pthread_join(threads[i], NULL);
+
+    double seconds = platform_now_seconds() - start;
+    double game_count = selfplay.game_count > 0 ? (double)selfplay.game_count : 1.0;
+
+    printf("%zu games in %.2f s (%.1f games/s) on %zu threads\n", selfplay.game_count, seconds, seconds > 0 ? (double)selfplay.game_count / seconds : 0.0, thread_count);
+    printf("white %s: %zu wins (%.1f%%), draws: %zu (%.1f%%), black %s: %zu wins (%.1f%%)\n",
+        white_name, selfplay.result_counts[MATCH_RESULT_WHITE_WIN], 100.0 * (double)selfplay.result_counts[MATCH_RESULT_WHITE_WIN] / game_count,
+        selfplay.result_counts[MATCH_RESULT_DRAW], 100.0 * (double)selfplay.result_counts[MATCH_RESULT_DRAW] / game_count,
+        black_name, selfplay.result_counts[MATCH_RESULT_BLACK_WIN], 100.0 * (double)selfplay.result_counts[MATCH_RESULT_BLACK_WIN] / game_count);
+    printf("average length: %.1f turns\n", (double)selfplay.total_turn_count / game_count);
+
+    fclose(selfplay.log_file);
+    pthread_mutex_destroy(&selfplay.log_mutex);
+
+    if(selfplay.scenario.scenario_mode == SCENARIO_MODE_CHALLENGE)
+        array_free(&selfplay.scenario.challenge_moves);
+
+    return EXIT_SUCCESS;
+}
+
+static void selfplay_print_usage(const char* program_name)
+{
+    fprintf(stderr, "Usage: %s <scenario file> <game count> <log file> [-w player] [-b player] [-t turns] [-r turns] [-s seed] [-j threads]\n", program_name);
+}
+
+static void* selfplay_worker_run(void* data)
+{
+    selfplay_t* selfplay = data;
+    match_player_t players [2];
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        search_limits_t limits = { selfplay->players[i].depth, 0, NULL };
+        match_player_init(&players[i], &selfplay->scenario.rules, limits, selfplay->players[i].plays_randomly);
+    }
+
+    for (;;)
+    {
+        size_t game_index = atomic_fetch_add(&selfplay->next_game_index, 1);
+
+        if(game_index >= selfplay->game_count) break;
+
+        match_settings_t settings = selfplay->settings;
+        settings.random_seed += game_index;
+
+        match_t match;
+        match_play(&match, &selfplay->scenario, &players[0], &players[1], &settings);
+
+        selfplay_log_match(selfplay, game_index, &match);
+
+        match_free(&match);
+    }
+
+    match_player_free(&players[0]);
+    match_player_free(&players[1]);
+
+    return NULL;
+}
+
+static void selfplay_log_match(selfplay_t* selfplay, size_t game_index, const match_t* match)
+{
+    static const char result_codes [3] = { 'D', 'W', 'B' };
+    char notation [LEGAL_MOVE_NOTATION_SIZE];
+    dynarray(legal_move_t) moves = match->moves;
+    size_t turn_count = dynarray_size(&moves);
+
+    pthread_mutex_lock(&selfplay->log_mutex);
+
+    fprintf(selfplay->log_file, "%zu %c %zu", game_index, result_codes[match->result], turn_count);
+
+    for (size_t i = 0; i < turn_count; i++)
+    {
+        legal_move_to_notation(&dynarray_ele(&moves, legal_move_t, i), notation, LEGAL_MOVE_NOTATION_SIZE);
+        fprintf(selfplay->log_file, " %s", notation);
+    }
+
+    fputc('\n', selfplay->log_file);
+
+    selfplay->result_counts[match->result]++;
+    selfplay->total_turn_count += turn_count;
+
+    pthread_mutex_unlock(&selfplay->log_mutex);
+}
+
+static bool selfplay_parse_player(const char* text, selfplay_player_config_t* out_player)
+{
+    if(strcmp(text, "random") == 0)
+    {
+        out_player->plays_randomly = true;
+        return true;
+    }
+
+    int depth = atoi(text);
+
+    if(depth < 1 || depth >= SEARCH_MAX_PLY) return false;
+
+    out_player->depth = (unsigned)depth;
+    out_player->plays_randomly = false;
+
+    return true;
+}
+
+static const char* selfplay_player_name(const selfplay_player_config_t* player, char* buffer, size_t buffer_size)
+{
+    if(player->plays_randomly) snprintf(buffer, buffer_size, "random");
+    else snprintf(buffer, buffer_size, "depth %u", player->depth);
+
+    return buffer;
+}
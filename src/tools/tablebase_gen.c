@@ -0,0 +1,509 @@
+/**
+ * TABLEBASE GENERATOR
+ *
+ * Solves every position with up to the given number of pieces for the rules of a scenario file and
+ * writes one table per material (number of pieces of each type) to the output directory, in the
+ * format read by tablebase.c.
+ *
+ * Usage: tablebase_gen <scenario file> <max pieces> <output directory> [thread count]
+ *
+ * Tables are generated from the fewest pieces up, and with fewer peons first, so the tables reached
+ * by captures and promotions are always on disk before they are needed. Tables already present in
+ * the output directory are kept, which allows resuming an interrupted run.
+ *
+ * Inside a table, pass 0 generates the moves of every position once: it counts the moves which stay
+ * in the table and reads the results of the moves leaving it (captures and promotions) from the
+ * smaller tables. Pass N then resolves the positions that end in exactly N turns by retrograde
+ * analysis, walking the quiet moves backwards from the positions resolved by pass N - 1 only: a
+ * parent of a lost position is won, and a parent is lost once every one of its moves is known to
+ * lead to a won position. Positions won or lost through another table are resolved by the pass
+ * matching their distance. Whatever is left once the passes stop changing anything is a draw.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "../include/scenario_loader.h"
+#include "../include/tablebase.h"
+#include "../include/validation.h"
+#include "../include/platform.h"
+
+#define TABLEBASE_GEN_MAX_THREADS 64
+#define TABLEBASE_GEN_DEFAULT_THREADS 4
+#define TABLEBASE_GEN_CHUNK_SIZE 4096
+
+/* Move counts are below LEGAL_MOVE_LIST_CAPACITY + 2, the high bit marks positions no quiet move of the table leads from */
+#define TABLEBASE_GEN_NO_QUIET_MOVES ((uint16_t)0x8000)
+#define TABLEBASE_GEN_MOVE_COUNT_MASK ((uint16_t)0x7FFF)
+
+typedef struct
+{
+    tablebase_t* tablebase;
+    tablebase_material_t material;
+    uint64_t entry_count;
+
+    /* Shared by every worker, a value only ever changes from unknown to its final value */
+    atomic_uchar* values;
+
+    /* Moves of each position whose result is not yet known to be a win for the opponent, plus one for its moves to other tables */
+    atomic_ushort* remaining_move_counts;
+
+    /*
+     * Written by pass 0 only: tablebase_value_win(N) when a move to another table wins in N turns,
+     * tablebase_value_loss(N) when every move to another table loses, the slowest in N turns.
+     */
+    uint8_t* external_values;
+
+    unsigned distance;
+    size_t thread_count;
+} tablebase_gen_pass_t;
+
+typedef struct
+{
+    tablebase_gen_pass_t* pass;
+    size_t thread_index;
+
+    uint64_t resolved_count;
+    unsigned max_external_distance;
+} tablebase_gen_worker_t;
+
+static void tablebase_gen_table(tablebase_t* tablebase, tablebase_material_t material, size_t thread_count);
+static uint64_t tablebase_gen_run_pass(tablebase_gen_pass_t* pass, unsigned* max_external_distance);
+static void* tablebase_gen_worker_run(void* data);
+static void tablebase_gen_classify(tablebase_gen_worker_t* worker, uint64_t index);
+static void tablebase_gen_propagate(tablebase_gen_worker_t* worker, uint64_t index, uint8_t value);
+static void tablebase_gen_set_value(tablebase_gen_worker_t* worker, uint64_t index, uint8_t value);
+static void tablebase_gen_remove_move(tablebase_gen_worker_t* worker, uint64_t index);
+static void tablebase_gen_write_table(tablebase_t* tablebase, tablebase_material_t material, const atomic_uchar* values, uint64_t entry_count);
+static bool tablebase_gen_file_exists(const char* path);
+
+int main(int argc, char** argv)
+{
+    if(argc < 4)
+    {
+        fprintf(stderr, "Usage: %s <scenario file> <max pieces> <output directory> [thread count]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int max_piece_count = atoi(argv[2]);
+    size_t thread_count = argc > 4 ? (size_t)atoi(argv[4]) : platform_processor_count(TABLEBASE_GEN_DEFAULT_THREADS);
+
+    if(max_piece_count < 2 || max_piece_count > 2 * TABLEBASE_MAX_PIECES_PER_GROUP)
+    {
+        fprintf(stderr, "The number of pieces must be between 2 and %d\n", 2 * TABLEBASE_MAX_PIECES_PER_GROUP);
+        return EXIT_FAILURE;
+    }
+
+    if(thread_count < 1) thread_count = 1;
+    if(thread_count > TABLEBASE_GEN_MAX_THREADS) thread_count = TABLEBASE_GEN_MAX_THREADS;
+
+    scenario_t scenario;
+    tablebase_t tablebase;
+
+    load_scenario_from_file(&scenario, argv[1]);
+    tablebase_open(&tablebase, argv[3], &scenario.rules);
+
+    for (int piece_count = 2; piece_count <= max_piece_count; piece_count++)
+    {
+        for (int peon_count = 0; peon_count <= piece_count; peon_count++)
+        {
+            for (int white_peons = 0; white_peons <= peon_count; white_peons++)
+            {
+                for (int white_queens = 0; white_queens <= piece_count - peon_count; white_queens++)
+                {
+                    tablebase_material_t material;
+                    material.counts[TABLEBASE_GROUP_WHITE_PEONS] = (uint8_t)white_peons;
+                    material.counts[TABLEBASE_GROUP_BLACK_PEONS] = (uint8_t)(peon_count - white_peons);
+                    material.counts[TABLEBASE_GROUP_WHITE_QUEENS] = (uint8_t)white_queens;
+                    material.counts[TABLEBASE_GROUP_BLACK_QUEENS] = (uint8_t)(piece_count - peon_count - white_queens);
+
+                    bool has_white_pieces = white_peons + white_queens > 0;
+                    bool has_black_pieces = piece_count - white_peons - white_queens > 0;
+                    bool fits_in_groups = true;
+
+                    for (uint8_t g = 0; g < TABLEBASE_GROUP_COUNT; g++)
+                        fits_in_groups = fits_in_groups && material.counts[g] <= TABLEBASE_MAX_PIECES_PER_GROUP;
+
+                    if(!has_white_pieces || !has_black_pieces || !fits_in_groups) continue;
+
+                    tablebase_gen_table(&tablebase, material, thread_count);
+                }
+            }
+        }
+    }
+
+    tablebase_close(&tablebase);
+
+    if(scenario.scenario_mode == SCENARIO_MODE_CHALLENGE)
+        array_free(&scenario.challenge_moves);
+
+    return EXIT_SUCCESS;
+}
+
+static void tablebase_gen_table(tablebase_t* tablebase, tablebase_material_t material, size_t thread_count)
+{
+    char path [TABLEBASE_FILE_PATH_SIZE];
+
+    if(!tablebase_table_file_path(tablebase, material, path, TABLEBASE_FILE_PATH_SIZE))
+    {
+        fprintf(stderr, "The output directory path is too long\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if(tablebase_gen_file_exists(path))
+    {
+        printf("%s: already generated\n", path);
+
+        /* Larger tables would read every position of an unreadable table as a draw */
+        if(!tablebase_load_table(tablebase, material))
+        {
+            fprintf(stderr, "%s cannot be read, delete it to generate it again\n", path);
+            exit(EXIT_FAILURE);
+        }
+
+        return;
+    }
+
+    double start = platform_now_seconds();
+
+    tablebase_gen_pass_t pass;
+    pass.tablebase = tablebase;
+    pass.material = material;
+    pass.entry_count = tablebase_entry_count(tablebase, material);
+    pass.thread_count = thread_count;
+    pass.values = malloc(pass.entry_count * sizeof(atomic_uchar));
+    pass.remaining_move_counts = malloc(pass.entry_count * sizeof(atomic_ushort));
+    pass.external_values = malloc(pass.entry_count);
+
+    if(pass.values == NULL || pass.remaining_move_counts == NULL || pass.external_values == NULL)
+    {
+        fprintf(stderr, "Not enough memory for the %" PRIu64 " entries of %s\n", pass.entry_count, path);
+        exit(EXIT_FAILURE);
+    }
+
+    unsigned max_external_distance = 0;
+
+    for (pass.distance = 0; ; pass.distance++)
+    {
+        uint64_t resolved_count = tablebase_gen_run_pass(&pass, &max_external_distance);
+
+        /* Positions lost or won through another table can resolve late, so keep going until their distances are covered */
+        if(pass.distance > 0 && resolved_count == 0 && pass.distance >= max_external_distance) break;
+
+        if(pass.distance == TABLEBASE_MAX_DISTANCE)
+        {
+            fprintf(stderr, "Warning: %s has positions longer than %d turns, they are stored as draws\n", path, TABLEBASE_MAX_DISTANCE);
+            break;
+        }
+    }
+
+    uint64_t outcome_counts [3] = {0};
+
+    for (uint64_t i = 0; i < pass.entry_count; i++)
+    {
+        uint8_t value = atomic_load_explicit(&pass.values[i], memory_order_relaxed);
+
+        if(value == TABLEBASE_VALUE_INVALID) continue;
+
+        outcome_counts[tablebase_value_is_win(value) ? TABLEBASE_OUTCOME_WIN : tablebase_value_is_loss(value) ? TABLEBASE_OUTCOME_LOSS : TABLEBASE_OUTCOME_DRAW]++;
+    }
+
+    tablebase_gen_write_table(tablebase, material, pass.values, pass.entry_count);
+
+    printf("%s: %12" PRIu64 " entries %10" PRIu64 " wins %10" PRIu64 " losses %10" PRIu64 " draws %4u passes %8.2f s\n", path, pass.entry_count,
+        outcome_counts[TABLEBASE_OUTCOME_WIN], outcome_counts[TABLEBASE_OUTCOME_LOSS], outcome_counts[TABLEBASE_OUTCOME_DRAW], pass.distance + 1, platform_now_seconds() - start);
+
+    free(pass.values);
+    free(pass.remaining_move_counts);
+    free(pass.external_values);
+
+    if(!tablebase_load_table(tablebase, material))
+    {
+        fprintf(stderr, "Could not map %s after writing it\n", path);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static uint64_t tablebase_gen_run_pass(tablebase_gen_pass_t* pass, unsigned* max_external_distance)
+{
+    pthread_t threads [TABLEBASE_GEN_MAX_THREADS];
+    tablebase_gen_worker_t workers [TABLEBASE_GEN_MAX_THREADS];
+    uint64_t resolved_count = 0;
+
+    for (size_t i = 0; i < pass->thread_count; i++)
+    {
+        workers[i].pass = pass;
+        workers[i].thread_index = i;
+        workers[i].resolved_count = 0;
+        workers[i].max_external_distance = 0;
+
+        if(pthread_create(&threads[i], NULL, tablebase_gen_worker_run, &workers[i]) != 0)
+        {
+            fprintf(stderr, "Could not create worker thread %zu\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    for (size_t i = 0; i < pass->thread_count; i++)
+    {
+        pthread_join(threads[i], NULL);
+
+        resolved_count += workers[i].resolved_count;
+
+        if(workers[i].max_external_distance > *max_external_distance) *max_external_distance = workers[i].max_external_distance;
+    }
+
+    return resolved_count;
+}
+
+static void* tablebase_gen_worker_run(void* data)
+{
+    tablebase_gen_worker_t* worker = data;
+    tablebase_gen_pass_t* pass = worker->pass;
+
+    /* Chunks are dealt round-robin so every thread gets a similar mix of easy and hard positions */
+    for (uint64_t chunk_start = worker->thread_index * TABLEBASE_GEN_CHUNK_SIZE; chunk_start < pass->entry_count; chunk_start += pass->thread_count * TABLEBASE_GEN_CHUNK_SIZE)
+    {
+        uint64_t chunk_end = chunk_start + TABLEBASE_GEN_CHUNK_SIZE < pass->entry_count ? chunk_start + TABLEBASE_GEN_CHUNK_SIZE : pass->entry_count;
+
+        for (uint64_t index = chunk_start; index < chunk_end; index++)
+        {
+            if(pass->distance == 0)
+            {
+                tablebase_gen_classify(worker, index);
+                continue;
+            }
+
+            /* Only the positions resolved by the previous pass have parents to update */
+            uint8_t value = atomic_load_explicit(&pass->values[index], memory_order_relaxed);
+
+            if(tablebase_value_is_known(value) && (unsigned)tablebase_value_distance(value) == pass->distance - 1)
+                tablebase_gen_propagate(worker, index, value);
+
+            uint8_t external_value = pass->external_values[index];
+
+            if(external_value == tablebase_value_win(pass->distance))
+                tablebase_gen_set_value(worker, index, external_value);
+            else if(external_value == tablebase_value_loss(pass->distance))
+                tablebase_gen_remove_move(worker, index);
+        }
+    }
+
+    return NULL;
+}
+
+static void tablebase_gen_classify(tablebase_gen_worker_t* worker, uint64_t index)
+{
+    tablebase_gen_pass_t* pass = worker->pass;
+    tablebase_t* tablebase = pass->tablebase;
+    const ruleset_t* rules = &tablebase->rules;
+    uint8_t value = TABLEBASE_VALUE_UNKNOWN;
+    uint16_t remaining_move_count = TABLEBASE_GEN_NO_QUIET_MOVES;
+    uint8_t external_value = TABLEBASE_VALUE_UNKNOWN;
+    board_t board;
+    team_t playing_team;
+
+    tablebase_position_from_index(tablebase, pass->material, index, &board, &playing_team);
+
+    /* A peon on its crowning line would already have been promoted */
+    for (cell_id_t cid = 0; cid < tablebase->geometry->playable_cell_count; cid++)
+    {
+        cell_value_t piece_type = board.playable_cells[cid];
+
+        if(piece_is_peon(piece_type) && board_is_crowning_cell_of_team(rules, piece_team(piece_type), cid)) value = TABLEBASE_VALUE_INVALID;
+    }
+
+    if(value != TABLEBASE_VALUE_INVALID)
+    {
+        team_t opponent_team = playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM;
+        legal_move_list_t move_list;
+        unsigned external_win_distance = TABLEBASE_MAX_DISTANCE + 1;
+        unsigned external_loss_distance = 0;
+        bool has_external_moves = false;
+        bool can_lose_externally = true;
+
+        board_generate_legal_moves(rules, &board, playing_team, &move_list);
+
+        if(move_list.move_count == 0) value = tablebase_value_loss(0);
+        else if(move_list.moves[0].capture_count == 0) remaining_move_count = 0;
+
+        for (size_t i = 0; i < move_list.move_count; i++)
+        {
+            board_t next_board = board;
+            board_play_legal_move(rules, &next_board, &move_list.moves[i]);
+
+            tablebase_material_t next_material = tablebase_material_of(tablebase, &next_board);
+            uint8_t next_value;
+
+            /* Only quiet moves without a promotion stay in the table */
+            if(memcmp(next_material.counts, pass->material.counts, TABLEBASE_GROUP_COUNT) == 0)
+            {
+                remaining_move_count++;
+                continue;
+            }
+
+            has_external_moves = true;
+
+            if(!tablebase_probe_value(tablebase, &next_board, opponent_team, &next_value) || !tablebase_value_is_known(next_value) ||
+                (unsigned)tablebase_value_distance(next_value) >= TABLEBASE_MAX_DISTANCE)
+            {
+                can_lose_externally = false;
+            }
+            else if(tablebase_value_is_loss(next_value))
+            {
+                can_lose_externally = false;
+
+                if((unsigned)tablebase_value_distance(next_value) + 1 < external_win_distance)
+                    external_win_distance = (unsigned)tablebase_value_distance(next_value) + 1;
+            }
+            else if((unsigned)tablebase_value_distance(next_value) + 1 > external_loss_distance)
+            {
+                external_loss_distance = (unsigned)tablebase_value_distance(next_value) + 1;
+            }
+        }
+
+        /* The moves to other tables count as one, removed by the pass of the slowest one when they all lose */
+        if(has_external_moves)
+        {
+            remaining_move_count++;
+
+            if(external_win_distance <= TABLEBASE_MAX_DISTANCE) external_value = tablebase_value_win(external_win_distance);
+            else if(can_lose_externally) external_value = tablebase_value_loss(external_loss_distance);
+        }
+
+        if(tablebase_value_is_known(external_value) && (unsigned)tablebase_value_distance(external_value) > worker->max_external_distance)
+            worker->max_external_distance = (unsigned)tablebase_value_distance(external_value);
+    }
+
+    if(tablebase_value_is_known(value)) worker->resolved_count++;
+
+    atomic_init(&pass->values[index], value);
+    atomic_init(&pass->remaining_move_counts[index], remaining_move_count);
+    pass->external_values[index] = external_value;
+}
+
+/* Walks the quiet moves of the team which just played backwards, to the positions of the table they start from */
+static void tablebase_gen_propagate(tablebase_gen_worker_t* worker, uint64_t index, uint8_t value)
+{
+    tablebase_gen_pass_t* pass = worker->pass;
+    tablebase_t* tablebase = pass->tablebase;
+    const ruleset_t* rules = &tablebase->rules;
+    const board_geometry_t* geometry = tablebase->geometry;
+    board_t board;
+    team_t playing_team;
+
+    tablebase_position_from_index(tablebase, pass->material, index, &board, &playing_team);
+
+    team_t moved_team = playing_team == WHITE_TEAM ? BLACK_TEAM : WHITE_TEAM;
+
+    for (cell_id_t destination_cell = 0; destination_cell < geometry->playable_cell_count; destination_cell++)
+    {
+        cell_value_t piece_type = board.playable_cells[destination_cell];
+
+        if(piece_type == NO_PIECE || piece_team(piece_type) != moved_team) continue;
+
+        bool is_queen = piece_is_queen(piece_type);
+
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            /* Coming back along direction i undoes a move made along the opposite one */
+            if(!is_queen && !validation_is_peon_moving_forward(rules, piece_type, movement_directions[direction_opposite(i)])) continue;
+
+            uint8_t max_distance = is_queen && rules->flying_kings ? geometry->ray_lengths[destination_cell][i] : 1;
+
+            for (uint8_t distance = 0; distance < max_distance && distance < geometry->ray_lengths[destination_cell][i]; distance++)
+            {
+                cell_id_t source_cell = geometry->rays[destination_cell][i][distance];
+
+                if(board.playable_cells[source_cell] != NO_PIECE) break;
+
+                board_t previous_board = board;
+                board_set_cell(&previous_board, destination_cell, NO_PIECE);
+                board_set_cell(&previous_board, source_cell, piece_type);
+
+                uint64_t previous_index = tablebase_index(tablebase, pass->material, &previous_board, moved_team);
+
+                /* The move does not exist when the parent had to capture */
+                if(atomic_load_explicit(&pass->remaining_move_counts[previous_index], memory_order_relaxed) & TABLEBASE_GEN_NO_QUIET_MOVES) continue;
+
+                if(tablebase_value_is_loss(value))
+                    tablebase_gen_set_value(worker, previous_index, tablebase_value_win(pass->distance));
+                else
+                    tablebase_gen_remove_move(worker, previous_index);
+            }
+        }
+    }
+}
+
+static void tablebase_gen_set_value(tablebase_gen_worker_t* worker, uint64_t index, uint8_t value)
+{
+    uint8_t unknown_value = TABLEBASE_VALUE_UNKNOWN;
+
+    if(atomic_compare_exchange_strong_explicit(&worker->pass->values[index], &unknown_value, value, memory_order_relaxed, memory_order_relaxed))
+        worker->resolved_count++;
+}
+
+/* Called once per move found to lead to a win of the opponent, the position is lost when none is left */
+static void tablebase_gen_remove_move(tablebase_gen_worker_t* worker, uint64_t index)
+{
+    uint16_t remaining_move_count = atomic_fetch_sub_explicit(&worker->pass->remaining_move_counts[index], 1, memory_order_relaxed);
+
+    if((remaining_move_count & TABLEBASE_GEN_MOVE_COUNT_MASK) == 1)
+        tablebase_gen_set_value(worker, index, tablebase_value_loss(worker->pass->distance));
+}
+
+static void tablebase_gen_write_table(tablebase_t* tablebase, tablebase_material_t material, const atomic_uchar* values, uint64_t entry_count)
+{
+    char path [TABLEBASE_FILE_PATH_SIZE];
+    char temporary_path [TABLEBASE_FILE_PATH_SIZE + 4];
+    uint8_t buffer [TABLEBASE_GEN_CHUNK_SIZE];
+    tablebase_table_file_path(tablebase, material, path, TABLEBASE_FILE_PATH_SIZE);
+    snprintf(temporary_path, sizeof(temporary_path), "%s.tmp", path);
+
+    tablebase_file_header_t header = {0};
+    memcpy(header.magic, TABLEBASE_FILE_MAGIC, sizeof(header.magic));
+    memcpy(header.counts, material.counts, TABLEBASE_GROUP_COUNT);
+    header.rules_key = ruleset_key(&tablebase->rules);
+    header.entry_count = entry_count;
+
+    /* Written aside and renamed once complete, so an interrupted run never leaves a table that looks generated */
+    FILE* f = fopen(temporary_path, "wb");
+    bool is_written = f != NULL && fwrite(&header, sizeof(header), 1, f) == 1;
+
+    for (uint64_t chunk_start = 0; is_written && chunk_start < entry_count; chunk_start += TABLEBASE_GEN_CHUNK_SIZE)
+    {
+        size_t chunk_size = entry_count - chunk_start < TABLEBASE_GEN_CHUNK_SIZE ? (size_t)(entry_count - chunk_start) : TABLEBASE_GEN_CHUNK_SIZE;
+
+        for (size_t i = 0; i < chunk_size; i++)
+            buffer[i] = atomic_load_explicit(&values[chunk_start + i], memory_order_relaxed);
+
+        is_written = fwrite(buffer, 1, chunk_size, f) == chunk_size;
+    }
+
+    if(f != NULL)
+    {
+        is_written = fflush(f) == 0 && is_written;
+        is_written = fclose(f) == 0 && is_written;
+    }
+
+    if(!is_written || rename(temporary_path, path) != 0)
+    {
+        fprintf(stderr, "Could not write %s\n", path);
+        remove(temporary_path);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static bool tablebase_gen_file_exists(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+
+    if(f == NULL) return false;
+
+    fclose(f);
+    return true;
+}
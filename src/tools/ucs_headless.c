@@ -0,0 +1,16 @@
+/**
+ * UCS HEADLESS
+ *
+ * The batch mode of the game built without SDL, for machines without a display.
+ *
+ * Usage: ucs_headless <command> [arguments]
+ *
+ * The commands are the ones of headless_run: validate, perft, selfplay and replay.
+*/
+
+#include "../include/headless.h"
+
+int main(int argc, char** argv)
+{
+    return headless_run(argc - 1, &argv[1]);
+}
@@ -0,0 +1,84 @@
+#include "include/zobrist.h"
+
+/*
+ * Generated once with splitmix64, kept constant so hashes are the same on every run and can be
+ * stored on disk. Indexed by cell and piece type + 2, the NO_PIECE column is zero so setting a
+ * cell can always xor the old and the new piece.
+ */
+const zobrist_key_t zobrist_piece_keys [MAX_BOARD_PLAYABLE_CELL_COUNT][ZOBRIST_PIECE_TYPE_COUNT] =
+{
+    { 0x50DC9E890B95E95EULL, 0x2C0204C1D0B78DD4ULL, 0, 0x8DD88E2CE3931851ULL, 0xD3B3572C0BC83C47ULL },
+    { 0x4665D232950E3AB7ULL, 0xEB35E4664AD025D5ULL, 0, 0xBAA2A8ECFE802A47ULL, 0xCBC8ECAF3D5E086AULL },
+    { 0xE3C7F5F0A73F6C96ULL, 0x1A96345C2BC53219ULL, 0, 0x035DA8EE7586CB82ULL, 0x0CBB6CEBCEB55971ULL },
+    { 0x8B0B32107DAC3B18ULL, 0x2E483574DC1D41A2ULL, 0, 0xB7F712307097B813ULL, 0xAA8BE368DB217933ULL },
+    { 0x5B02AF1FDD7AB5FFULL, 0x811F19541C181A5FULL, 0, 0x22E3932947FA3C73ULL, 0xB305C456D44F1D6FULL },
+    { 0xE2EF368518290372ULL, 0x8BBB677365C4562DULL, 0, 0xD7F1AD2B9F8C81D4ULL, 0xB45485E7C374CED7ULL },
+    { 0xCBCE4BD5A0560BA6ULL, 0x585BE3C3378A03B9ULL, 0, 0x849FF23CDC37CB61ULL, 0xC07EC48566BDE4FEULL },
+    { 0x83B7CA7603E6B5D7ULL, 0x171C8A819A286443ULL, 0, 0x1DFDE3859CC22D90ULL, 0x91BFA99369A0F49BULL },
+    { 0x7B879F5F60AF3596ULL, 0x6D3ED48994790D02ULL, 0, 0x043643BAFA84D715ULL, 0x207683C3AB5E65E9ULL },
+    { 0x5DAB5E2517AE23C6ULL, 0x7C0691F0BF02E3F2ULL, 0, 0xBF7CCDC2CE56A5E5ULL, 0x4C1BAFE9FDEAC976ULL },
+    { 0x7008A047ED43FF79ULL, 0x4FA6A2AC26918D76ULL, 0, 0x2C5BE1757CC29B13ULL, 0x4EF3C368DF1FCD59ULL },
+    { 0xACB2922FCF382B6DULL, 0x9B0D7C7206810CCCULL, 0, 0xE3892E8BCEFE94D1ULL, 0xC5DA2E8882F4826AULL },
+    { 0xFB503AE6E5508C64ULL, 0x36E3D2753BC6243FULL, 0, 0xF38E88BAF20A6776ULL, 0x9CE507A86A8AF173ULL },
+    { 0x158DE68C17CA596AULL, 0xBA03C6E95D9F082BULL, 0, 0xAFC63DAE00FBF648ULL, 0xA09C3A489ACD5159ULL },
+    { 0x58414A5A981816F8ULL, 0x7DBD61EB03EF64C4ULL, 0, 0x2758464CF3CDBC61ULL, 0x61AC3F177CDD77FBULL },
+    { 0x8DD64D85D3A9D644ULL, 0x0C07AB48A1D3D133ULL, 0, 0x23E51F2EA2618C89ULL, 0x99E4C0217416B9A1ULL },
+    { 0x0E49CD6DB87926F1ULL, 0xDC16385BB0EA7A5FULL, 0, 0x39A2B2AC69BEA6C7ULL, 0x45CB7EA8D5D51BB1ULL },
+    { 0x11218DD7E79D1975ULL, 0x81C9D98E9E1363E9ULL, 0, 0x847C4183ECEA3471ULL, 0xD644369D7E84FEC2ULL },
+    { 0x45052E0DE6308A85ULL, 0xDBE986AA8852EF22ULL, 0, 0xA635231D9B206503ULL, 0xCF4474BA66FCF3C3ULL },
+    { 0xA38AD7C8066B5A82ULL, 0x5F2668B2CBF09B66ULL, 0, 0x04F9F27D10EDE839ULL, 0xDB9E1989E641F4B2ULL },
+    { 0x7DE12426D1695BE8ULL, 0xC4B717BB05B96F6FULL, 0, 0x42FE7EF2A984F1A6ULL, 0x5703AFD375FD508CULL },
+    { 0xF1A905E6E6BAC155ULL, 0x0001E26E934FA8C5ULL, 0, 0xDECE888B3EA7FCD2ULL, 0x4167FE90C40D5A05ULL },
+    { 0xC6554CD035B04B31ULL, 0xC91A2CBBD0926B1DULL, 0, 0x7BC66D0F361AACF5ULL, 0x5624556BDF635AA2ULL },
+    { 0x97C50EE414D1880AULL, 0x78FBB27FBC9E913DULL, 0, 0xEDD719E3B53192FAULL, 0x39CF5582C5D467EBULL },
+    { 0x1D20959E482F1D17ULL, 0x7DB4D45196319129ULL, 0, 0x29A7CE7AD731E663ULL, 0x3C54FFF13CB907F6ULL },
+    { 0x69B9B9C5E0CC67E2ULL, 0x004ACEE5FB911488ULL, 0, 0xC0F84C02D73BA8D0ULL, 0x3B36D91C80B47DD1ULL },
+    { 0x264C857592151937ULL, 0x2068E94D2ABEAE56ULL, 0, 0xF78F87E3133C5F48ULL, 0x196F55135E254A93ULL },
+    { 0x9CF302C02BE71D57ULL, 0x83B4FAF9E2221167ULL, 0, 0x3F8989128C457C12ULL, 0x586A1767CBE9E2B1ULL },
+    { 0xF5F95A9979263F19ULL, 0x004E580DBA078212ULL, 0, 0x022A751CF171D407ULL, 0xC315103F89A2AA9EULL },
+    { 0xA6DB9780C268B1E3ULL, 0xACE94042DCE71273ULL, 0, 0xE09D847F50149ABCULL, 0xAC2FD813C1F68295ULL },
+    { 0xBBC212C33F1D1F2DULL, 0xB2625CD97422D5D5ULL, 0, 0x765967999C2F8C8FULL, 0x1935A58161457F2BULL },
+    { 0xDD527F705B8E68F5ULL, 0x7E58E3E41E7D2C03ULL, 0, 0xBCF51FFAD7181372ULL, 0x42A84824DA891997ULL },
+    { 0x23CA096C76502E35ULL, 0x622C6A6B86ECE2D1ULL, 0, 0xDEED97FF58E206EEULL, 0xDE69724124362393ULL },
+    { 0xD7D1DB48E7FE7120ULL, 0x715438067E6E5BA2ULL, 0, 0x24AF4293BFB5E105ULL, 0x8738E70610871CC5ULL },
+    { 0xBBECB8F6A397C262ULL, 0xEF88A90391197326ULL, 0, 0x7EC4858DFDBC1C00ULL, 0xD64ACF71C4A5E672ULL },
+    { 0x54AD02D4F39BE1CAULL, 0xC24CB3C69F391BEDULL, 0, 0xD27417C5D60D1DC0ULL, 0x764D3C25C193CFC4ULL },
+    { 0x55D8A82D39DEC7BDULL, 0x4E6ECFAC4CCF3375ULL, 0, 0x4BB4BE845A3A2B22ULL, 0x780237A5EEC5EAE1ULL },
+    { 0x7D2DF086756DB0D3ULL, 0x2563D66CE2D706A1ULL, 0, 0x71E7BF3919E7D289ULL, 0x8E910FF2B368519CULL },
+    { 0xDB79F7CCA20F3313ULL, 0x0FF409BCE2ABC7A9ULL, 0, 0x2D8875AAB395E6CDULL, 0x2D006B83777CA573ULL },
+    { 0x774A212802DD94FBULL, 0xD758538BE41D69C7ULL, 0, 0xAD3BF782909F0AE4ULL, 0x10E8C9BC40F2CAB0ULL },
+    { 0x161C5E099D1FA88BULL, 0x737B308A9C74CFDCULL, 0, 0xDB35D8836683E118ULL, 0x243B54C0B570F931ULL },
+    { 0xE357D042A536C3E6ULL, 0xB4C575B35F918400ULL, 0, 0x3645CB9CF7788FD4ULL, 0x6F40A631603FDC18ULL },
+    { 0xAD5A43E52BD5F9C0ULL, 0x4D36458895CD56E0ULL, 0, 0x3ED393AC08536D7EULL, 0x1B77114E30BA1A4FULL },
+    { 0xD8F4DCFC37EDBFC2ULL, 0x8B83146A06320D87ULL, 0, 0x6A25C32EEC5CADE1ULL, 0x99DB91DC775A9526ULL },
+    { 0xBA7ED133C2D26C35ULL, 0xEF3097983F1E648BULL, 0, 0x1539AF69F94BF33EULL, 0x2FB32A575B44CF1CULL },
+    { 0x9F6BE1F1C7EFA0DEULL, 0x5B8D16743CA87C2FULL, 0, 0x427F81F98728FBDDULL, 0xD2485EFD718F096DULL },
+    { 0x39C48EAEBF8CD4D1ULL, 0xA5B2E89C15B8DFC5ULL, 0, 0xAF50F31284218D5BULL, 0xA5259E77862A2933ULL },
+    { 0xDD6F9C0AB23FDBA3ULL, 0x24B58A4477849A2FULL, 0, 0x8851E08154AEE3A9ULL, 0x87ABC3E0651A423AULL },
+    { 0x8AA81FBAD61D8AF9ULL, 0x7A41D71F72B72279ULL, 0, 0xAEF7B6A576C60B05ULL, 0x7BC1AE7EB72E4698ULL },
+    { 0x6FBD1ABA767D1AB3ULL, 0xF2501A38AD2A79AFULL, 0, 0x3CFFEBE898C6A4FFULL, 0x8AB1090641352BE2ULL },
+    { 0x6C98B13BAE7D5923ULL, 0x8FBFC6D83D96EC20ULL, 0, 0xDB745A83A5EB8D98ULL, 0xB105DB143D63AAF5ULL },
+    { 0x1A68A0D608461589ULL, 0xF8F68F1005A99AFFULL, 0, 0xA78FC5299ACE581DULL, 0x4794A64281B561EBULL },
+    { 0xE196BB5BC01E32C2ULL, 0x20034FCBAA71C39FULL, 0, 0x99711F95874CE57FULL, 0xA1A6FA62BC3B070BULL },
+    { 0x1BBC9F5F2281129DULL, 0xAF075BFACEA64287ULL, 0, 0xC2A4355466FD1AB9ULL, 0x5EB54D22D63F768EULL },
+    { 0x5EC11CA0C6516659ULL, 0x38E75394808EF4CDULL, 0, 0x2FD638FDA7E46C4CULL, 0x40530C4CAB398EA5ULL },
+    { 0xBFC2297E51255C70ULL, 0x7223F5F7923691F5ULL, 0, 0xF7946CE63F38EC44ULL, 0xEB0775B4144C9A28ULL },
+    { 0x918DA12265E2FD10ULL, 0x17AFB4EC3C1E821EULL, 0, 0x8606C0940F8399F3ULL, 0x2EC215F0F4E7C754ULL },
+    { 0x2E43A1126DB285FDULL, 0x8B422F565EB59713ULL, 0, 0x65B95253FA3FDD13ULL, 0x2E7DD7956A2E3F46ULL },
+    { 0xA62C51392AF0476FULL, 0x71D1DD2BAF697DD9ULL, 0, 0x6DAF664432F2B2D7ULL, 0x81AFBC080830055DULL },
+    { 0xDD54C08E26AAC0DBULL, 0xEE28D0447FA7DB80ULL, 0, 0x71350067041CE758ULL, 0x8894FA672CA76286ULL },
+    { 0x3FCB4F652C69A6A0ULL, 0x35D6077BBC429EF1ULL, 0, 0x8443FDE377E54A2FULL, 0x2036C85675EDDB7DULL },
+    { 0xF041BE1E00FFBEB4ULL, 0xA9E463358DEA5CFFULL, 0, 0xD8F7D8F3A1412419ULL, 0xA5A9246F57335E64ULL },
+    { 0xF23AAA903426C537ULL, 0x7DAF537EEE40E674ULL, 0, 0xA1F293C7EA23B95AULL, 0xBF9D458CCA94B29AULL },
+    { 0xCE882A28C1152D0AULL, 0x2EA399390C1E378FULL, 0, 0x0F5C40ED6AD0F98BULL, 0x60FA46C0C455AAD0ULL },
+    { 0x421F2E8C1301F767ULL, 0x441661E41C7CD683ULL, 0, 0x8B7B160CDD2CF615ULL, 0x3A4730E19F5DD5A9ULL },
+    { 0xB94E70059B1A5E70ULL, 0x3F3163299C76C79EULL, 0, 0x4ECBECA7BEF0219AULL, 0x8F7AAB4425F95BE3ULL },
+    { 0xDAA20A99D899C4CAULL, 0x1F61FA22B12A8463ULL, 0, 0x586E6BF4139ABE92ULL, 0xD2D51A4A8794C423ULL },
+    { 0x961C9E92EA641784ULL, 0x0E54E9EB675E4A19ULL, 0, 0xD34BE07F9CEF1D90ULL, 0xA49A7704DE76C6DBULL },
+    { 0x9C3A2C463F7A60D3ULL, 0x1CA3188664F099C6ULL, 0, 0xF08A446EB0AF1A76ULL, 0xB97B11D4DC9DBF36ULL },
+    { 0xB9B1BA0F1F0A357FULL, 0x8C2A264358525B71ULL, 0, 0x56679105EFA48297ULL, 0x5D89896A3069C9D0ULL },
+    { 0x20F893E96284D52AULL, 0x560A8772AAAD9393ULL, 0, 0xAD27FAAB7901B34BULL, 0x6039B856494A882AULL },
+    { 0x41FB03D2918B8011ULL, 0xC908A09078E3334EULL, 0, 0x9F6E337140BD466DULL, 0x89ED62D3890F0EBDULL }
+};
+
+const zobrist_key_t zobrist_black_to_move_key = 0x5CEA9FF4E75EEEA8ULL;